@@ -22,6 +22,7 @@
 #include <display/state.h>
 #include <emuenv/state.h>
 #include <io/state.h>
+#include <renderer/state.h>
 #include <util/log.h>
 
 #include <SDL.h>
@@ -45,6 +46,8 @@ void calculate_fps(EmuEnvState &emuenv) {
         const uint32_t frame_count = static_cast<std::uint32_t>(emuenv.frame_count);
         emuenv.fps = (frame_count * 1000 + ms / 2) / ms;
         emuenv.ms_per_frame = (ms + frame_count / 2) / frame_count;
+        if (emuenv.renderer)
+            emuenv.commands_per_sec = emuenv.renderer->processed_command_count.exchange(0) * 1000 / ms;
         emuenv.sdl_ticks = sdl_ticks_now;
         emuenv.frame_count = 0;
         set_window_title(emuenv);
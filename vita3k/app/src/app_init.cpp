@@ -55,6 +55,8 @@
 #include <X11/Xresource.h>
 #endif
 
+#include <algorithm>
+
 namespace app {
 void update_viewport(EmuEnvState &state) {
     int w = 0;
@@ -487,7 +489,10 @@ bool late_init(EmuEnvState &state) {
             thread->update_status(ThreadStatus::run);
         }
     };
-    if (!state.audio.init(resume_thread, state.cfg.audio_backend)) {
+    state.audio.callback_samples = std::clamp(state.cfg.audio_buffer_samples, 64, 4096);
+    state.audio.capture_path = state.cfg.audio_capture_path;
+    state.audio.unpaced = state.cfg.audio_unpaced;
+    if (!state.audio.init(resume_thread, state.cfg.get_audio_backend())) {
         LOG_WARN("Failed to initialize audio! Audio will not work.");
     }
 
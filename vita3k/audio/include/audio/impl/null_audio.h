@@ -0,0 +1,57 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include "../state.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <thread>
+
+// Backend without an audio device: the callback is driven by a timer, or run back to back when unpaced.
+// The mixed output can be captured to a WAV file and the time spent mixing is logged.
+class NullAudioAdapter : public AudioAdapter {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cond_var;
+    bool paused = false;
+    bool stop = false;
+
+    std::vector<uint8_t> buffer;
+    FILE *capture_file = nullptr;
+    uint32_t captured_bytes = 0;
+
+    // mix time statistics, over the whole run and over the current log period
+    uint64_t nb_callbacks = 0;
+    uint64_t total_mix_time_ns = 0;
+    uint64_t max_mix_time_ns = 0;
+    uint64_t period_callbacks = 0;
+    uint64_t period_mix_time_ns = 0;
+    uint64_t period_max_mix_time_ns = 0;
+
+    void run();
+    void write_capture(const uint8_t *data, uint32_t size);
+    void close_capture();
+
+public:
+    NullAudioAdapter(AudioState &audio_state);
+    ~NullAudioAdapter() override;
+
+    bool init() override;
+    void switch_state(const bool pause) override;
+};
@@ -0,0 +1,29 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <cstdint>
+
+// The ports are accumulated as float in a mix buffer, which is converted to s16 once all of them are mixed.
+// Samples are interleaved stereo, the float values keep the s16 scale.
+
+// Add nb_frames stereo s16 frames to the mix buffer, with a volume for each channel
+void mix_stereo_s16(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume);
+
+// Convert nb_samples values of the mix buffer to s16, saturating
+void convert_mix_to_s16(int16_t *dest, const float *mix, int nb_samples);
@@ -41,6 +41,8 @@ struct AudioOutPort {
     float volume = 1.0f;
     // length of the buffer for each call
     int len_bytes = 0;
+    // the thread outputting to the port waits while the stream has at least this many bytes
+    int wait_threshold = 0;
     // number of microseconds a buffer lasts for
     uint64_t len_microseconds = 0;
     // last time sceAudioOutOutput was called with this port (timestamp in microseconds)
@@ -82,8 +84,10 @@ struct AudioState;
 // abstract class that need to be overloaded with an audio implementation
 class AudioAdapter {
 private:
-    // buffer used to mix audio
+    // buffer the data of a port is read to
     std::vector<uint8_t> temp_buffer;
+    // float accumulator all the ports are mixed into
+    std::vector<float> mix_buffer;
 
 protected:
     AudioState &state;
@@ -119,6 +123,11 @@ struct AudioState {
     ResumeAudioThread resume_thread;
     std::string audio_backend;
     float global_volume;
+    // number of samples per channel for each callback the backend is asked for, lower means less latency
+    int callback_samples = 512;
+    // Null backend: WAV file the output is written to (if not empty), and whether the callbacks are paced like a device
+    std::string capture_path;
+    bool unpaced = false;
 
     bool init(const ResumeAudioThread &resume_thread, const std::string &adapter_name);
     void set_backend(const std::string &adapter_name);
@@ -17,9 +17,12 @@
 
 #include <audio/state.h>
 
+#include <audio/mixer.h>
+
 #include <tracy/Tracy.hpp>
 
 #include <audio/impl/cubeb_audio.h>
+#include <audio/impl/null_audio.h>
 #include <audio/impl/sdl_audio.h>
 
 #include <kernel/thread/thread_state.h>
@@ -30,7 +33,7 @@
 #include <cassert>
 #include <cstring>
 
-static void mix_out_port(uint8_t *stream, uint8_t *temp_buffer, int len, float global_volume, AudioOutPort &port, const ResumeAudioThread &resume_thread) {
+static void mix_out_port(float *mix, uint8_t *temp_buffer, int len, float global_volume, AudioOutPort &port, const ResumeAudioThread &resume_thread) {
     ZoneScopedC(0xF6C2FF); // Tracy - Track function scope with color thistle
 
     // How much data is available?
@@ -39,8 +42,8 @@ static void mix_out_port(uint8_t *stream, uint8_t *temp_buffer, int len, float g
     assert(bytes_available >= 0);
 
     // Running out of data?
-    // The (len * 3) is according to the value in sceAudioOutOutput
-    if (bytes_available < len * 3) {
+    // The threshold is the same as in audio_output
+    if (bytes_available < port.wait_threshold) {
         // Is there a thread waiting for playback to finish?
         if (port.thread >= 0) {
             // Wake the thread up.
@@ -57,7 +60,9 @@ static void mix_out_port(uint8_t *stream, uint8_t *temp_buffer, int len, float g
     const int bytes_got = SDL_AudioStreamGet(port.stream.get(), temp_buffer, bytes_to_get);
     lock.unlock();
     if (bytes_got > 0) {
-        SDL_MixAudioFormat(stream, temp_buffer, AUDIO_S16LSB, bytes_got, static_cast<int>(port.volume * global_volume * SDL_MIX_MAXVOLUME));
+        const float left_volume = global_volume * port.left_channel_volume / SCE_AUDIO_VOLUME_0DB;
+        const float right_volume = global_volume * port.right_channel_volume / SCE_AUDIO_VOLUME_0DB;
+        mix_stereo_s16(mix, reinterpret_cast<const int16_t *>(temp_buffer), bytes_got / (2 * sizeof(int16_t)), left_volume, right_volume);
     }
 }
 
@@ -74,10 +79,22 @@ void AudioAdapter::audio_callback(uint8_t *stream, int len_bytes) {
             ports.push_back(port);
         }
     }
-    std::memset(stream, state.spec.silence, len_bytes);
+    if (ports.empty()) {
+        std::memset(stream, state.spec.silence, len_bytes);
+    } else {
+        // the output is stereo s16
+        const int nb_samples = len_bytes / sizeof(int16_t);
+        if (mix_buffer.size() < static_cast<size_t>(nb_samples)) {
+            mix_buffer.resize(nb_samples);
+            temp_buffer.resize(len_bytes);
+        }
+        std::fill_n(mix_buffer.begin(), nb_samples, 0.0f);
+
+        for (const AudioOutPortPtr &port : ports) {
+            mix_out_port(mix_buffer.data(), temp_buffer.data(), len_bytes, state.global_volume, *port.get(), state.resume_thread);
+        }
 
-    for (const AudioOutPortPtr &port : ports) {
-        mix_out_port(stream, temp_buffer.data(), len_bytes, state.global_volume, *port.get(), state.resume_thread);
+        convert_mix_to_s16(reinterpret_cast<int16_t *>(stream), mix_buffer.data(), nb_samples);
     }
 
     FrameMarkNamed("Audio"); // Tracy - End discontinuous frame for audio rendering
@@ -104,6 +121,8 @@ void AudioState::set_backend(const std::string &adapter_name) {
         adapter = std::make_unique<SDLAudioAdapter>(*this);
     } else if (adapter_name == "Cubeb") {
         adapter = std::make_unique<CubebAudioAdapter>(*this);
+    } else if (adapter_name == "Null") {
+        adapter = std::make_unique<NullAudioAdapter>(*this);
     } else {
         LOG_ERROR("Unknown audio adapter {}", adapter_name);
         return;
@@ -118,6 +137,7 @@ void AudioState::set_backend(const std::string &adapter_name) {
     }
 
     adapter->temp_buffer.resize(spec.nb_samples * 2 * sizeof(uint16_t));
+    adapter->mix_buffer.resize(spec.nb_samples * 2);
 }
 
 AudioOutPortPtr AudioState::open_port(int nb_channels, int freq, int nb_sample) {
@@ -130,6 +150,10 @@ AudioOutPortPtr AudioState::open_port(int nb_channels, int freq, int nb_sample)
         AudioOutPortPtr port = std::make_shared<AudioOutPort>();
         port->len_microseconds = (nb_sample * 1'000'000ULL) / freq;
         port->len_bytes = nb_sample * nb_channels * sizeof(int16_t);
+        // 3 host callbacks are needed for some games with an 480 samples buffer and a 512 host buffer,
+        // with smaller host buffers keep at least one buffer of the port once converted to the output format
+        const int output_len_bytes = static_cast<int>(static_cast<uint64_t>(nb_sample) * spec.freq / freq) * 2 * sizeof(int16_t);
+        port->wait_threshold = std::max<int>(3 * spec.nb_samples * 2 * sizeof(int16_t), output_len_bytes);
         port->stream = stream;
 
         return port;
@@ -157,7 +181,7 @@ void AudioState::audio_output(ThreadState &thread, AudioOutPort &out_port, const
         // we are supposed to wait for the existing samples to be processed (except the ones just passed)
         // but this would give a bad audio because the host buffer size is different compared to the guest buffer size
         // so we need to cache more data to make sure we always have enough
-        if (available >= 3 * spec.nb_samples * 2 * sizeof(uint16_t)) {
+        if (available >= out_port.wait_threshold) {
             out_port.thread = thread.id;
 
             std::unique_lock<std::mutex> mlock(thread.mutex);
@@ -0,0 +1,182 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include "audio/impl/null_audio.h"
+
+#include "util/fs.h"
+#include "util/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+static constexpr int NULL_AUDIO_FREQ = 48000;
+// the output is stereo signed 16 bits
+static constexpr int NULL_AUDIO_FRAME_SIZE = 2 * sizeof(int16_t);
+static constexpr uint32_t WAV_HEADER_SIZE = 44;
+// log the mix time every 10 seconds of audio
+static constexpr uint64_t LOG_PERIOD_SAMPLES = 10 * NULL_AUDIO_FREQ;
+
+static void write_u16(uint8_t *dst, uint16_t value) {
+    dst[0] = value & 0xFF;
+    dst[1] = value >> 8;
+}
+
+static void write_u32(uint8_t *dst, uint32_t value) {
+    for (int i = 0; i < 4; i++)
+        dst[i] = (value >> (8 * i)) & 0xFF;
+}
+
+// canonical PCM WAV header, the sizes are filled once the capture is done
+static void make_wav_header(uint8_t *header, uint32_t data_size) {
+    memcpy(header, "RIFF", 4);
+    write_u32(header + 4, WAV_HEADER_SIZE - 8 + data_size);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    write_u32(header + 16, 16);
+    write_u16(header + 20, 1); // PCM
+    write_u16(header + 22, 2);
+    write_u32(header + 24, NULL_AUDIO_FREQ);
+    write_u32(header + 28, NULL_AUDIO_FREQ * NULL_AUDIO_FRAME_SIZE);
+    write_u16(header + 32, NULL_AUDIO_FRAME_SIZE);
+    write_u16(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    write_u32(header + 40, data_size);
+}
+
+NullAudioAdapter::NullAudioAdapter(AudioState &audio_state)
+    : AudioAdapter(audio_state) {}
+
+NullAudioAdapter::~NullAudioAdapter() {
+    if (thread.joinable()) {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond_var.notify_one();
+        thread.join();
+    }
+
+    close_capture();
+
+    if (nb_callbacks > 0)
+        LOG_INFO("Null audio: {} callbacks, mix time average {} us, max {} us", nb_callbacks, total_mix_time_ns / nb_callbacks / 1000, max_mix_time_ns / 1000);
+}
+
+bool NullAudioAdapter::init() {
+    state.spec = {
+        .freq = NULL_AUDIO_FREQ,
+        .nb_samples = state.callback_samples,
+        .silence = 0
+    };
+    buffer.resize(state.spec.nb_samples * NULL_AUDIO_FRAME_SIZE);
+
+    if (!state.capture_path.empty()) {
+        const fs::path capture_path = fs_utils::utf8_to_path(state.capture_path);
+        capture_file = FOPEN(capture_path.c_str(), "wb");
+        if (!capture_file) {
+            LOG_ERROR("Could not open the audio capture file {}", capture_path);
+            return false;
+        }
+
+        uint8_t header[WAV_HEADER_SIZE];
+        make_wav_header(header, 0);
+        fwrite(header, 1, WAV_HEADER_SIZE, capture_file);
+        LOG_INFO("Capturing the audio output to {}", capture_path);
+    }
+
+    thread = std::thread(&NullAudioAdapter::run, this);
+    return true;
+}
+
+void NullAudioAdapter::switch_state(const bool pause) {
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        paused = pause;
+    }
+    cond_var.notify_one();
+}
+
+void NullAudioAdapter::run() {
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::nanoseconds(1'000'000'000ULL * state.spec.nb_samples / NULL_AUDIO_FREQ);
+    const uint64_t log_period_callbacks = LOG_PERIOD_SAMPLES / state.spec.nb_samples;
+    auto next_callback = clock::now();
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (paused) {
+                cond_var.wait(lock, [&]() { return stop || !paused; });
+                next_callback = clock::now();
+            }
+            if (stop)
+                return;
+        }
+
+        if (!state.unpaced) {
+            next_callback += period;
+            const auto now = clock::now();
+            if (next_callback > now)
+                std::this_thread::sleep_until(next_callback);
+            else if (now - next_callback > 4 * period)
+                // too late to catch up, restart from now
+                next_callback = now;
+        }
+
+        const auto mix_start = clock::now();
+        audio_callback(buffer.data(), static_cast<int>(buffer.size()));
+        const uint64_t mix_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - mix_start).count();
+
+        nb_callbacks++;
+        total_mix_time_ns += mix_time_ns;
+        max_mix_time_ns = std::max(max_mix_time_ns, mix_time_ns);
+        period_callbacks++;
+        period_mix_time_ns += mix_time_ns;
+        period_max_mix_time_ns = std::max(period_max_mix_time_ns, mix_time_ns);
+        if (period_callbacks == log_period_callbacks) {
+            LOG_INFO("Null audio: mix time average {} us, max {} us over {} callbacks", period_mix_time_ns / period_callbacks / 1000, period_max_mix_time_ns / 1000, period_callbacks);
+            period_callbacks = 0;
+            period_mix_time_ns = 0;
+            period_max_mix_time_ns = 0;
+        }
+
+        if (capture_file)
+            write_capture(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    }
+}
+
+void NullAudioAdapter::write_capture(const uint8_t *data, uint32_t size) {
+    // the sizes in the header are 32-bit
+    if (captured_bytes > std::numeric_limits<uint32_t>::max() - WAV_HEADER_SIZE - size)
+        return;
+
+    fwrite(data, 1, size, capture_file);
+    captured_bytes += size;
+}
+
+void NullAudioAdapter::close_capture() {
+    if (!capture_file)
+        return;
+
+    uint8_t header[WAV_HEADER_SIZE];
+    make_wav_header(header, captured_bytes);
+    fseek(capture_file, 0, SEEK_SET);
+    fwrite(header, 1, WAV_HEADER_SIZE, capture_file);
+    fclose(capture_file);
+    capture_file = nullptr;
+}
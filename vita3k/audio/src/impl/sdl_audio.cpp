@@ -44,7 +44,7 @@ bool SDLAudioAdapter::init() {
     desired.freq = 48000;
     desired.format = AUDIO_S16LSB;
     desired.channels = 2;
-    desired.samples = 512;
+    desired.samples = state.callback_samples;
     desired.callback = sdl_audio_callback;
     desired.userdata = this;
 
@@ -0,0 +1,191 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+/*
+mixing of the audio ports
+1 program compiled for aarch64: use NEON
+2 otherwise SSE2 is always available, autodetect AVX2 at runtime and use it if possible
+the vector loops leave the last frames to the basic implementation
+*/
+
+#include <audio/mixer.h>
+
+#include <util/log.h>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr float MIX_MIN = -32768.0f;
+static constexpr float MIX_MAX = 32767.0f;
+
+static void mix_stereo_s16_basic(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume) {
+    for (int i = 0; i < nb_frames; i++) {
+        mix[2 * i] += src[2 * i] * left_volume;
+        mix[2 * i + 1] += src[2 * i + 1] * right_volume;
+    }
+}
+
+static void convert_mix_to_s16_basic(int16_t *dest, const float *mix, int nb_samples) {
+    for (int i = 0; i < nb_samples; i++)
+        dest[i] = static_cast<int16_t>(std::lrint(std::clamp(mix[i], MIX_MIN, MIX_MAX)));
+}
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+
+void mix_stereo_s16(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume) {
+    const float volumes[4] = { left_volume, right_volume, left_volume, right_volume };
+    const float32x4_t volume = vld1q_f32(volumes);
+
+    // 4 frames per iteration
+    int frame = 0;
+    for (; frame + 4 <= nb_frames; frame += 4) {
+        const int16x8_t samples = vld1q_s16(src + 2 * frame);
+        const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+        const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+        vst1q_f32(mix + 2 * frame, vaddq_f32(vld1q_f32(mix + 2 * frame), vmulq_f32(low, volume)));
+        vst1q_f32(mix + 2 * frame + 4, vaddq_f32(vld1q_f32(mix + 2 * frame + 4), vmulq_f32(high, volume)));
+    }
+
+    mix_stereo_s16_basic(mix + 2 * frame, src + 2 * frame, nb_frames - frame, left_volume, right_volume);
+}
+
+void convert_mix_to_s16(int16_t *dest, const float *mix, int nb_samples) {
+    const float32x4_t min = vdupq_n_f32(MIX_MIN);
+    const float32x4_t max = vdupq_n_f32(MIX_MAX);
+
+    int i = 0;
+    for (; i + 8 <= nb_samples; i += 8) {
+        const int32x4_t low = vcvtnq_s32_f32(vminq_f32(vmaxq_f32(vld1q_f32(mix + i), min), max));
+        const int32x4_t high = vcvtnq_s32_f32(vminq_f32(vmaxq_f32(vld1q_f32(mix + i + 4), min), max));
+        vst1q_s16(dest + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+
+    convert_mix_to_s16_basic(dest + i, mix + i, nb_samples - i);
+}
+#else
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((__target__("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define TARGET_AVX2
+#include <intrin.h>
+#else
+#error "Compiler is not supported"
+#endif
+
+static void mix_stereo_s16_SSE2(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume) {
+    const __m128 volume = _mm_setr_ps(left_volume, right_volume, left_volume, right_volume);
+
+    // 4 frames per iteration
+    int frame = 0;
+    for (; frame + 4 <= nb_frames; frame += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * frame));
+        // sign extend to 32 bits by putting each sample in the upper half
+        const __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+        const __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+        _mm_storeu_ps(mix + 2 * frame, _mm_add_ps(_mm_loadu_ps(mix + 2 * frame), _mm_mul_ps(low, volume)));
+        _mm_storeu_ps(mix + 2 * frame + 4, _mm_add_ps(_mm_loadu_ps(mix + 2 * frame + 4), _mm_mul_ps(high, volume)));
+    }
+
+    mix_stereo_s16_basic(mix + 2 * frame, src + 2 * frame, nb_frames - frame, left_volume, right_volume);
+}
+
+static void convert_mix_to_s16_SSE2(int16_t *dest, const float *mix, int nb_samples) {
+    const __m128 min = _mm_set1_ps(MIX_MIN);
+    const __m128 max = _mm_set1_ps(MIX_MAX);
+
+    int i = 0;
+    for (; i + 8 <= nb_samples; i += 8) {
+        // clamp first, out of range floats are not saturated by the conversion to int32
+        const __m128i low = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i), min), max));
+        const __m128i high = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i + 4), min), max));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_packs_epi32(low, high));
+    }
+
+    convert_mix_to_s16_basic(dest + i, mix + i, nb_samples - i);
+}
+
+static void TARGET_AVX2 mix_stereo_s16_AVX2(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume) {
+    const __m256 volume = _mm256_setr_ps(left_volume, right_volume, left_volume, right_volume, left_volume, right_volume, left_volume, right_volume);
+
+    // 8 frames per iteration
+    int frame = 0;
+    for (; frame + 8 <= nb_frames; frame += 8) {
+        const __m256 low = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * frame))));
+        const __m256 high = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * frame + 8))));
+        _mm256_storeu_ps(mix + 2 * frame, _mm256_add_ps(_mm256_loadu_ps(mix + 2 * frame), _mm256_mul_ps(low, volume)));
+        _mm256_storeu_ps(mix + 2 * frame + 8, _mm256_add_ps(_mm256_loadu_ps(mix + 2 * frame + 8), _mm256_mul_ps(high, volume)));
+    }
+
+    mix_stereo_s16_basic(mix + 2 * frame, src + 2 * frame, nb_frames - frame, left_volume, right_volume);
+}
+
+static void TARGET_AVX2 convert_mix_to_s16_AVX2(int16_t *dest, const float *mix, int nb_samples) {
+    const __m256 min = _mm256_set1_ps(MIX_MIN);
+    const __m256 max = _mm256_set1_ps(MIX_MAX);
+
+    int i = 0;
+    for (; i + 16 <= nb_samples; i += 16) {
+        const __m256i low = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(mix + i), min), max));
+        const __m256i high = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(mix + i + 8), min), max));
+        // the pack works on each 128-bit lane, put the 64-bit blocks back in order
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), packed);
+    }
+
+    convert_mix_to_s16_basic(dest + i, mix + i, nb_samples - i);
+}
+
+// use function variables as imitation of self-modifying code, the implementation is selected on first use
+static void mix_stereo_s16_init(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume);
+static void convert_mix_to_s16_init(int16_t *dest, const float *mix, int nb_samples);
+
+static void (*mix_stereo_s16_var)(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume) = mix_stereo_s16_init;
+static void (*convert_mix_to_s16_var)(int16_t *dest, const float *mix, int nb_samples) = convert_mix_to_s16_init;
+
+#include <util/instrset_detect.h>
+static void select_mixer() {
+    if (util::instrset::instrset_detect() >= util::instrset::instrset_AVX2) {
+        mix_stereo_s16_var = mix_stereo_s16_AVX2;
+        convert_mix_to_s16_var = convert_mix_to_s16_AVX2;
+        LOG_INFO("AVX2 instruction set is supported. Using AVX2 audio mixing");
+    } else {
+        mix_stereo_s16_var = mix_stereo_s16_SSE2;
+        convert_mix_to_s16_var = convert_mix_to_s16_SSE2;
+        LOG_INFO("AVX2 instruction set is not supported. Using SSE2 audio mixing");
+    }
+}
+
+void mix_stereo_s16_init(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume) {
+    select_mixer();
+    (*mix_stereo_s16_var)(mix, src, nb_frames, left_volume, right_volume);
+}
+
+void convert_mix_to_s16_init(int16_t *dest, const float *mix, int nb_samples) {
+    select_mixer();
+    (*convert_mix_to_s16_var)(dest, mix, nb_samples);
+}
+
+void mix_stereo_s16(float *mix, const int16_t *src, int nb_frames, float left_volume, float right_volume) {
+    (*mix_stereo_s16_var)(mix, src, nb_frames, left_volume, right_volume);
+}
+
+void convert_mix_to_s16(int16_t *dest, const float *mix, int nb_samples) {
+    (*convert_mix_to_s16_var)(dest, mix, nb_samples);
+}
+#endif
@@ -148,10 +148,6 @@ struct MjpegDecoderState : public DecoderState {
     MjpegDecoderState();
 };
 
-struct Atrac9DecoderSavedState {
-    double prev_values[2][256]{};
-};
-
 struct Atrac9DecoderState : public DecoderState {
     uint32_t config_data;
     void *decoder_handle;
@@ -168,9 +164,6 @@ struct Atrac9DecoderState : public DecoderState {
     bool receive(uint8_t *data, DecoderSize *size) override;
     void flush() override;
 
-    void export_state(Atrac9DecoderSavedState *dest);
-    void load_state(const Atrac9DecoderSavedState *src);
-
     explicit Atrac9DecoderState(uint32_t config_data);
     ~Atrac9DecoderState() override;
 };
@@ -199,6 +192,8 @@ struct ADPCMHistory {
 struct PCMDecoderState : public DecoderState {
 private:
     std::vector<std::uint8_t> final_result;
+    // decoded HE-ADPCM samples
+    std::vector<std::int16_t> transformed;
     float dest_frequency;
     SwrContext *swr_mono_to_stereo = nullptr;
     SwrContext *swr_stereo = nullptr;
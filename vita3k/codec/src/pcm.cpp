@@ -169,8 +169,6 @@ bool PCMDecoderState::send(const uint8_t *data, uint32_t size) {
     const std::uint8_t *source_transformed = data;
     std::uint32_t produced_samples = 0;
 
-    std::vector<std::int16_t> transformed;
-
     if (he_adpcm) {
         const std::uint32_t bytes_per_frame = 0x10;
         const std::uint32_t samples_per_frame = (bytes_per_frame - 2) * 2;
@@ -180,7 +178,7 @@ bool PCMDecoderState::send(const uint8_t *data, uint32_t size) {
             return false;
         }
 
-        // Allocate whole buffer now so we don't need to constantly increase it with push_back
+        // Size the whole buffer now so we don't need to constantly increase it with push_back, it is kept between calls
         transformed.resize((size / bytes_per_frame) * samples_per_frame);
         std::int16_t *buffer = transformed.data();
 
@@ -48,6 +48,12 @@ enum ScreenshotFormat {
     PNG,
 };
 
+enum ShaderLogMode {
+    SHADER_LOG_OFF,
+    SHADER_LOG_GXP,
+    SHADER_LOG_FULL,
+};
+
 // clang-format off
 // Singular options produced in config file
 // Order is code(option_type, option_name, option_default, member_name)
@@ -58,6 +64,7 @@ enum ScreenshotFormat {
     code(bool, "gdbstub", false, gdbstub)                                                               \
     code(bool, "log-active-shaders", false, log_active_shaders)                                         \
     code(bool, "log-uniforms", false, log_uniforms)                                                     \
+    code(int, "shader-log-mode", static_cast<int>(SHADER_LOG_GXP), shader_log_mode)                     \
     code(bool, "log-compat-warn", false, log_compat_warn)                                               \
     code(bool, "validation-layer", true, validation_layer)                                              \
     code(bool, "pstv-mode", false, pstv_mode)                                                           \
@@ -84,11 +91,13 @@ enum ScreenshotFormat {
     code(bool, "async-pipeline-compilation", true, async_pipeline_compilation)                          \
     code(bool, "show-compile-shaders", true, show_compile_shaders)                                      \
     code(bool, "hashless-texture-cache", false, hashless_texture_cache)                                 \
+    code(bool, "page-tracked-texture-cache", false, page_tracked_texture_cache)                         \
     code(bool, "import-textures", false, import_textures)                                               \
     code(bool, "export-textures", false, export_textures)                                               \
     code(bool, "export-as-png", true, export_as_png)                                                    \
     code(bool, "boot-apps-full-screen", false, boot_apps_full_screen)                                   \
     code(std::string, "audio-backend", "SDL", audio_backend)                                            \
+    code(int, "audio-buffer-samples", 512, audio_buffer_samples)                                        \
     code(int, "audio-volume", 100, audio_volume)                                                        \
     code(bool, "ngs-enable", true, ngs_enable)                                                          \
     code(int, "sys-button", static_cast<int>(SCE_SYSTEM_PARAM_ENTER_BUTTON_CROSS), sys_button)          \
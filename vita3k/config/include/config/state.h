@@ -75,6 +75,8 @@ private:
             pkg_path = rhs.pkg_path;
         if (rhs.pkg_zrif.has_value())
             pkg_zrif = rhs.pkg_zrif;
+        if (rhs.audio_backend_override.has_value())
+            audio_backend_override = rhs.audio_backend_override;
 
         if (!rhs.config_path.empty())
             config_path = rhs.config_path;
@@ -86,6 +88,8 @@ private:
         app_args = rhs.app_args;
         load_app_list = rhs.load_app_list;
         self_path = rhs.self_path;
+        audio_capture_path = rhs.audio_capture_path;
+        audio_unpaced = rhs.audio_unpaced;
     }
 
 public:
@@ -97,6 +101,8 @@ public:
     std::optional<std::string> pkg_path;
     std::optional<std::string> pkg_zrif;
     std::optional<std::string> pup_path;
+    // used instead of audio-backend for this session only
+    std::optional<std::string> audio_backend_override;
 
     // Setting not present in the YAML file
     fs::path config_path = {};
@@ -107,6 +113,12 @@ public:
     bool fullscreen = false;
     bool console = false;
     bool load_app_list = false;
+    std::string audio_capture_path;
+    bool audio_unpaced = false;
+
+    std::string get_audio_backend() const {
+        return audio_backend_override.value_or(audio_backend);
+    }
 
     fs::path get_pref_path() const {
         return fs_utils::utf8_to_path(pref_path);
@@ -78,6 +78,9 @@ static ExitCode parse(Config &cfg, const fs::path &load_path, const fs::path &ro
         return FileNotFound;
     }
 
+    // the value is used as an index, it must stay in the enum range
+    cfg.shader_log_mode = std::clamp(cfg.shader_log_mode, static_cast<int>(SHADER_LOG_OFF), static_cast<int>(SHADER_LOG_FULL));
+
     if (cfg.pref_path.empty())
         cfg.set_pref_path(root_pref_path);
     else {
@@ -156,6 +159,12 @@ ExitCode init_config(Config &cfg, int argc, char **argv, const Root &root_paths)
     input->add_option("--deleted-id,-d", command_line.delete_title_id, "Title ID of installed app to delete")
         ->default_str({})->check(CLI::IsMember(get_file_set(cfg.get_pref_path() / "ux0/app")))->group("Input");
     input->add_option("--firmware", command_line.pup_path, "Path to the firmware file (.pup extension) to install");
+    input->add_option("--audio-backend", command_line.audio_backend_override, "Audio backend to use for this session, Null runs without an audio device")
+        ->ignore_case()->check(CLI::IsMember(std::set<std::string>{ "SDL", "Cubeb", "Null" }))->group("Input");
+    input->add_option("--audio-capture-path", command_line.audio_capture_path, "Path of a WAV file the audio output is written to, used by the Null audio backend")
+        ->default_str({})->group("Input");
+    input->add_flag("--audio-unpaced", command_line.audio_unpaced, "Run the Null audio backend as fast as possible instead of in real time")
+        ->group("Input");
     auto input_pkg = input->add_option("--pkg", command_line.pkg_path, "Path to the app file (.pkg extension) to install")
         ->default_str({})->group("Input");
     auto input_zrif = input->add_option("--zrif", command_line.pkg_zrif, "zrif to decode the app (base64 format)")
@@ -166,6 +175,8 @@ ExitCode init_config(Config &cfg, int argc, char **argv, const Root &root_paths)
     auto config = app.add_option_group("Configuration", "Modify Vita3K's config.yml file");
     config->add_flag("--" + cfg[e_archive_log] + ",-A", command_line.archive_log, "Make a duplicate of the log file with TITLE_ID and Game ID as title")
         ->group("Logging");
+    config->add_option("--" + cfg[e_audio_buffer_samples], command_line.audio_buffer_samples, "Number of samples per channel mixed for each audio callback of the SDL and Null backends, lower values give less latency")
+        ->check(CLI::Range( 64, 4096 ))->group("Audio");
     config->add_option("--" + cfg[e_backend_renderer] + ",-B", command_line.backend_renderer, "Renderer backend to use")
         ->ignore_case()->check(CLI::IsMember(std::set<std::string>{ "OpenGL", "Vulkan" }))->group("Vita Emulation");
     config->add_flag("--" + cfg[e_color_surface_debug] + ",-C", command_line.color_surface_debug, "Save color surfaces")
@@ -188,6 +199,8 @@ ExitCode init_config(Config &cfg, int argc, char **argv, const Root &root_paths)
         ->group("Logging");
     config->add_flag("--" + cfg[e_log_uniforms] + ",-U", command_line.log_uniforms, "Log Uniforms")
         ->group("Logging");
+    config->add_option("--" + cfg[e_shader_log_mode], command_line.shader_log_mode, "Files written to the shaderlog folder when a shader is generated:\nOFF = 0\nGXP = 1\nFULL = 2")
+        ->check(CLI::Range( 0, 2 ))->group("Logging");
     // clang-format on
 
     // Parse the inputs
@@ -267,6 +280,8 @@ ExitCode init_config(Config &cfg, int argc, char **argv, const Root &root_paths)
         LOG_INFO("{}: {}", cfg[e_log_level], LIST_LOG_LEVEL[cfg.log_level]);
         LOG_INFO_IF(cfg.log_active_shaders, "{}: enabled", cfg[e_log_active_shaders]);
         LOG_INFO_IF(cfg.log_uniforms, "{}: enabled", cfg[e_log_uniforms]);
+        static constexpr std::array<const char *, 3> LIST_SHADER_LOG_MODE = { "Off", "GXP", "Full" };
+        LOG_INFO("{}: {}", cfg[e_shader_log_mode], LIST_SHADER_LOG_MODE[cfg.shader_log_mode]);
     }
     // Save any changes made in command-line arguments
     if (cfg.overwrite_config || !fs::exists(check_path(cfg.config_path))) {
@@ -49,6 +49,7 @@ CPUContext save_context(CPUState &state);
 void load_context(CPUState &state, const CPUContext &ctx);
 std::size_t get_processor_id(CPUState &state);
 void invalidate_jit_cache(CPUState &state, Address start, size_t length);
+void sync_jit_pool(CPUState &state);
 
 uint32_t read_fpscr(CPUState &state);
 void write_fpscr(CPUState &state, uint32_t value);
@@ -62,6 +63,10 @@ ExclusiveMonitorPtr new_exclusive_monitor(int max_num_cores);
 void free_exclusive_monitor(ExclusiveMonitorPtr monitor);
 void clear_exclusive(ExclusiveMonitorPtr monitor, std::size_t core_num);
 
+JitPoolPtr new_jit_pool();
+void free_jit_pool(JitPoolPtr pool);
+void invalidate_jit_pool(JitPoolPtr pool, Address start, size_t length);
+
 // Debugging helpers
 std::string disassemble(CPUState &state, uint64_t at, bool thumb, uint16_t *insn_size = nullptr);
 std::string disassemble(CPUState &state, uint64_t at, uint16_t *insn_size = nullptr);
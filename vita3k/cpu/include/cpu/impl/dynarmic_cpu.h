@@ -26,6 +26,7 @@
 
 class ArmDynarmicCallback;
 class ArmDynarmicCP15;
+class DynarmicJitPool;
 
 class DynarmicCPU : public CPUInterface {
     friend class ArmDynarmicCallback;
@@ -36,6 +37,9 @@ class DynarmicCPU : public CPUInterface {
     std::unique_ptr<ArmDynarmicCallback> cb;
     std::shared_ptr<ArmDynarmicCP15> cp15;
     Dynarmic::ExclusiveMonitor *monitor;
+    DynarmicJitPool *pool;
+    // invalidation count of the pool when the JIT was obtained
+    uint64_t pool_generation = 0;
 
     std::size_t core_id = 0;
 
@@ -50,7 +54,7 @@ class DynarmicCPU : public CPUInterface {
     std::unique_ptr<Dynarmic::A32::Jit> make_jit();
 
 public:
-    DynarmicCPU(CPUState *state, std::size_t processor_id, Dynarmic::ExclusiveMonitor *monitor, bool cpu_opt);
+    DynarmicCPU(CPUState *state, std::size_t processor_id, Dynarmic::ExclusiveMonitor *monitor, DynarmicJitPool *pool, bool cpu_opt);
     ~DynarmicCPU() override;
     int run() override;
     void stop() override;
@@ -94,4 +98,5 @@ public:
 
     std::size_t processor_id() const override;
     void invalidate_jit_cache(Address start, size_t length) override;
+    void sync_jit_pool() override;
 };
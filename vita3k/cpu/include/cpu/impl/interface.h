@@ -55,6 +55,8 @@ struct CPUInterface {
     virtual CPUContext save_context() = 0;
     virtual void load_context(const CPUContext &ctx) = 0;
     virtual void invalidate_jit_cache(Address start, size_t length) = 0;
+    // apply the invalidations missed by a JIT taken from a pool before the kernel knew about it
+    virtual void sync_jit_pool() {}
 
     virtual bool is_thumb_mode() = 0;
     virtual int step() = 0;
@@ -60,7 +60,8 @@ CPUStatePtr init_cpu(CPUBackend backend, bool cpu_opt, SceUID thread_id, std::si
     switch (backend) {
     case CPUBackend::Dynarmic: {
         Dynarmic::ExclusiveMonitor *monitor = static_cast<Dynarmic::ExclusiveMonitor *>(protocol->get_exclusive_monitor());
-        state->cpu = std::make_unique<DynarmicCPU>(state.get(), processor_id, monitor, cpu_opt);
+        DynarmicJitPool *pool = static_cast<DynarmicJitPool *>(protocol->get_jit_pool());
+        state->cpu = std::make_unique<DynarmicCPU>(state.get(), processor_id, monitor, pool, cpu_opt);
         break;
     }
     case CPUBackend::Unicorn: {
@@ -186,6 +187,10 @@ void invalidate_jit_cache(CPUState &state, Address start, size_t length) {
     state.cpu->invalidate_jit_cache(start, length);
 }
 
+void sync_jit_pool(CPUState &state) {
+    state.cpu->sync_jit_pool();
+}
+
 std::string disassemble(CPUState &state, uint64_t at, bool thumb, uint16_t *insn_size) {
     MemState &mem = *state.mem;
     const uint8_t *const code = Ptr<const uint8_t>(static_cast<Address>(at)).get(mem);
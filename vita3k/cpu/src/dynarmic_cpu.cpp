@@ -27,9 +27,14 @@
 #include <dynarmic/interface/A32/coprocessor.h>
 #include <dynarmic/interface/exclusive_monitor.h>
 
+#include <atomic>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 class ArmDynarmicCP15 : public Dynarmic::A32::Coprocessor {
     uint32_t tpidruro;
@@ -103,6 +108,11 @@ public:
 
     ~ArmDynarmicCallback() override = default;
 
+    void rebind(CPUState &parent, DynarmicCPU &cpu) {
+        this->parent = &parent;
+        this->cpu = &cpu;
+    }
+
     std::optional<std::uint32_t> MemoryReadCode(Dynarmic::A32::VAddr addr) override {
         if (cpu->log_mem)
             LOG_TRACE("Instruction fetch at address 0x{:X}", addr);
@@ -298,6 +308,106 @@ public:
     }
 };
 
+// A Dynarmic JIT owns its translated code and can't share it with other live instances,
+// so instead of throwing it away when a thread exits, it is kept here and handed over to
+// the next thread created on the same core, which then starts with all the code already compiled.
+// The callbacks and CP15 are bound to the JIT config, so they are moved along with it.
+// The pool is shared by the kernel and every CPU using it, the last one to drop it deletes it.
+class DynarmicJitPool {
+public:
+    struct Entry {
+        std::unique_ptr<Dynarmic::A32::Jit> jit;
+        std::unique_ptr<ArmDynarmicCallback> cb;
+        std::shared_ptr<ArmDynarmicCP15> cp15;
+        // number of invalidations done when the JIT was taken from the pool or created
+        uint64_t generation;
+    };
+
+private:
+    struct Invalidation {
+        Address start;
+        size_t length;
+    };
+    // a JIT which missed more invalidations than this has its whole cache cleared when it is handed back
+    static constexpr size_t MAX_INVALIDATIONS = 64;
+
+    std::atomic<int> refs = 1;
+    std::mutex mutex;
+    // The processor id is part of the JIT config, so entries can only be reused on the same core
+    std::map<std::size_t, std::vector<Entry>> free_entries;
+    // the last invalidations, the one at the back has the number generation - 1
+    std::deque<Invalidation> invalidations;
+    uint64_t generation = 0;
+
+public:
+    void retain() {
+        refs++;
+    }
+
+    void drop() {
+        if (--refs == 0)
+            delete this;
+    }
+
+    uint64_t get_generation() {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return generation;
+    }
+
+    std::optional<Entry> acquire(std::size_t core_id) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        auto it = free_entries.find(core_id);
+        if (it == free_entries.end() || it->second.empty())
+            return std::nullopt;
+
+        Entry entry = std::move(it->second.back());
+        it->second.pop_back();
+        entry.generation = generation;
+        return entry;
+    }
+
+    // A JIT taken from the pool is not known to the kernel until its thread is registered,
+    // so the invalidations done in between are applied again, returns the new generation of the JIT.
+    uint64_t catch_up(Dynarmic::A32::Jit &jit, uint64_t jit_generation) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        replay(jit, jit_generation);
+        return generation;
+    }
+
+    // The thread owning the JIT is no longer known to the kernel by the time it is handed back,
+    // so the invalidations done since it was taken are applied again as it may have missed some.
+    void release(std::size_t core_id, Entry entry) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        replay(*entry.jit, entry.generation);
+        free_entries[core_id].push_back(std::move(entry));
+    }
+
+    void invalidate(Address start, size_t length) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (auto &[_, entries] : free_entries) {
+            for (auto &entry : entries)
+                entry.jit->InvalidateCacheRange(start, length);
+        }
+
+        invalidations.push_back({ start, length });
+        if (invalidations.size() > MAX_INVALIDATIONS)
+            invalidations.pop_front();
+        generation++;
+    }
+
+private:
+    // the mutex must be locked
+    void replay(Dynarmic::A32::Jit &jit, uint64_t jit_generation) {
+        const uint64_t missed = generation - jit_generation;
+        if (missed > invalidations.size()) {
+            jit.ClearCache();
+        } else {
+            for (auto it = invalidations.end() - static_cast<std::ptrdiff_t>(missed); it != invalidations.end(); ++it)
+                jit.InvalidateCacheRange(it->start, it->length);
+        }
+    }
+};
+
 std::unique_ptr<Dynarmic::A32::Jit> DynarmicCPU::make_jit() {
     Dynarmic::A32::UserConfig config{};
     config.arch_version = Dynarmic::A32::ArchVersion::v7;
@@ -318,17 +428,42 @@ std::unique_ptr<Dynarmic::A32::Jit> DynarmicCPU::make_jit() {
     return std::make_unique<Dynarmic::A32::Jit>(config);
 }
 
-DynarmicCPU::DynarmicCPU(CPUState *state, std::size_t processor_id, Dynarmic::ExclusiveMonitor *monitor, bool cpu_opt)
+DynarmicCPU::DynarmicCPU(CPUState *state, std::size_t processor_id, Dynarmic::ExclusiveMonitor *monitor, DynarmicJitPool *pool, bool cpu_opt)
     : parent(state)
-    , cb(std::make_unique<ArmDynarmicCallback>(*state, *this))
-    , cp15(std::make_shared<ArmDynarmicCP15>())
     , monitor(monitor)
+    , pool(pool)
     , core_id(processor_id)
     , cpu_opt(cpu_opt) {
+    if (pool) {
+        pool->retain();
+        if (auto entry = pool->acquire(core_id)) {
+            pool_generation = entry->generation;
+            jit = std::move(entry->jit);
+            cb = std::move(entry->cb);
+            cp15 = std::move(entry->cp15);
+            cb->rebind(*state, *this);
+            cp15->set_tpidruro(0);
+            // Only the guest state is reset, the code cache is kept
+            jit->Reset();
+            jit->ClearExclusiveState();
+            return;
+        }
+    }
+
+    if (pool)
+        pool_generation = pool->get_generation();
+    cb = std::make_unique<ArmDynarmicCallback>(*state, *this);
+    cp15 = std::make_shared<ArmDynarmicCP15>();
     jit = make_jit();
 }
 
-DynarmicCPU::~DynarmicCPU() = default;
+DynarmicCPU::~DynarmicCPU() {
+    // JITs built for code or memory logging have a different config and are not worth keeping
+    if (pool && jit && !log_code && !log_mem)
+        pool->release(core_id, { std::move(jit), std::move(cb), std::move(cp15), pool_generation });
+    if (pool)
+        pool->drop();
+}
 
 int DynarmicCPU::run() {
     halted = false;
@@ -484,6 +619,11 @@ void DynarmicCPU::invalidate_jit_cache(Address start, size_t length) {
     jit->InvalidateCacheRange(start, length);
 }
 
+void DynarmicCPU::sync_jit_pool() {
+    if (pool)
+        pool_generation = pool->catch_up(*jit, pool_generation);
+}
+
 // TODO: proper abstraction
 ExclusiveMonitorPtr new_exclusive_monitor(int max_num_cores) {
     return new Dynarmic::ExclusiveMonitor(max_num_cores);
@@ -498,3 +638,24 @@ void clear_exclusive(ExclusiveMonitorPtr monitor, std::size_t core_num) {
     Dynarmic::ExclusiveMonitor *monitor_ = static_cast<Dynarmic::ExclusiveMonitor *>(monitor);
     monitor_->ClearProcessor(core_num);
 }
+
+JitPoolPtr new_jit_pool() {
+    return new DynarmicJitPool();
+}
+
+void free_jit_pool(JitPoolPtr pool) {
+    if (!pool)
+        return;
+
+    // the CPUs still alive keep it until they are destroyed
+    DynarmicJitPool *pool_ = static_cast<DynarmicJitPool *>(pool);
+    pool_->drop();
+}
+
+void invalidate_jit_pool(JitPoolPtr pool, Address start, size_t length) {
+    if (!pool)
+        return;
+
+    DynarmicJitPool *pool_ = static_cast<DynarmicJitPool *>(pool);
+    pool_->invalidate(start, length);
+}
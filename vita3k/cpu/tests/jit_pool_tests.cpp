@@ -0,0 +1,149 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <cpu/functions.h>
+#include <cpu/state.h>
+#include <mem/functions.h>
+#include <mem/ptr.h>
+#include <mem/state.h>
+#include <mem/test_state.h>
+
+#include <gtest/gtest.h>
+
+static constexpr uint32_t MOV_R0_1 = 0xE3A00001;
+static constexpr uint32_t MOV_R0_2 = 0xE3A00002;
+static constexpr uint32_t SVC_0 = 0xEF000000;
+
+// the svc only stops the JIT, nothing is called
+struct TestProtocol : CPUProtocolBase {
+    ExclusiveMonitorPtr monitor = new_exclusive_monitor(4);
+    JitPoolPtr pool = new_jit_pool();
+
+    ~TestProtocol() override {
+        free_jit_pool(pool);
+        free_exclusive_monitor(monitor);
+    }
+
+    void call_svc(CPUState &cpu, uint32_t svc, Address pc, ThreadState &thread) override {}
+    Address get_watch_memory_addr(Address addr) override {
+        return addr;
+    }
+    ExclusiveMonitorPtr get_exclusive_monitor() override {
+        return monitor;
+    }
+    JitPoolPtr get_jit_pool() override {
+        return pool;
+    }
+};
+
+class jit_pool : public testing::Test {
+protected:
+    void SetUp() override {
+        code = Ptr<uint32_t>(alloc(get_mem(), get_mem().page_size, "jit_pool_tests"));
+        ASSERT_TRUE(code);
+        write_code(MOV_R0_1);
+    }
+
+    void TearDown() override {
+        free(get_mem(), code.address());
+    }
+
+    void write_code(uint32_t first_instruction) {
+        code.get(get_mem())[0] = first_instruction;
+        code.get(get_mem())[1] = SVC_0;
+    }
+
+    CPUStatePtr create_cpu() {
+        return init_cpu(CPUBackend::Dynarmic, true, 1, 0, get_mem(), &protocol);
+    }
+
+    uint32_t run_code(CPUState &cpu) {
+        write_reg(cpu, 0, 0);
+        write_pc(cpu, code.address());
+        run(cpu);
+        return read_reg(cpu, 0);
+    }
+
+    TestProtocol protocol;
+    Ptr<uint32_t> code;
+};
+
+TEST_F(jit_pool, reused_jit_keeps_code) {
+    {
+        const auto cpu = create_cpu();
+        ASSERT_TRUE(cpu);
+        EXPECT_EQ(run_code(*cpu), 1);
+    }
+
+    // the code changed without an invalidation, a JIT from the pool still runs the translated one
+    write_code(MOV_R0_2);
+    const auto cpu = create_cpu();
+    ASSERT_TRUE(cpu);
+    EXPECT_EQ(run_code(*cpu), 1);
+}
+
+TEST_F(jit_pool, invalidation_while_in_pool) {
+    {
+        const auto cpu = create_cpu();
+        ASSERT_TRUE(cpu);
+        EXPECT_EQ(run_code(*cpu), 1);
+    }
+
+    write_code(MOV_R0_2);
+    invalidate_jit_pool(protocol.pool, code.address(), 8);
+
+    const auto cpu = create_cpu();
+    ASSERT_TRUE(cpu);
+    EXPECT_EQ(run_code(*cpu), 2);
+}
+
+TEST_F(jit_pool, invalidation_before_registration) {
+    {
+        const auto cpu = create_cpu();
+        ASSERT_TRUE(cpu);
+        EXPECT_EQ(run_code(*cpu), 1);
+    }
+
+    // the JIT is taken from the pool, the kernel does not know its thread yet and only invalidates the pool
+    const auto cpu = create_cpu();
+    ASSERT_TRUE(cpu);
+    write_code(MOV_R0_2);
+    invalidate_jit_pool(protocol.pool, code.address(), 8);
+
+    // done by the kernel when the thread is registered
+    sync_jit_pool(*cpu);
+    EXPECT_EQ(run_code(*cpu), 2);
+}
+
+TEST_F(jit_pool, too_many_invalidations_before_registration) {
+    {
+        const auto cpu = create_cpu();
+        ASSERT_TRUE(cpu);
+        EXPECT_EQ(run_code(*cpu), 1);
+    }
+
+    const auto cpu = create_cpu();
+    ASSERT_TRUE(cpu);
+    write_code(MOV_R0_2);
+    invalidate_jit_pool(protocol.pool, code.address(), 8);
+    // more than the pool remembers, the whole cache is cleared instead
+    for (int i = 0; i < 100; i++)
+        invalidate_jit_pool(protocol.pool, 0, 4);
+
+    sync_jit_pool(*cpu);
+    EXPECT_EQ(run_code(*cpu), 2);
+}
@@ -49,13 +49,16 @@ void draw_lw_mutexes_dialog(GuiState &gui, EmuEnvState &emuenv) {
     const std::lock_guard<std::mutex> lock(emuenv.kernel.mutex);
 
     for (const auto &[id, mutex_state] : emuenv.kernel.lwmutexes) {
+        const SceKernelLwMutexWork *work = mutex_state->workarea.get(emuenv.mem);
+        const SceUID owner_id = work->owner & ~LW_MUTEX_OWNER_CONTENDED;
+        const auto owner = emuenv.kernel.threads.find(owner_id);
         ImGui::TextColored(GUI_COLOR_TEXT, "0x%08X       %-32s   %02d        %01d           %02zu                 %s",
             id,
             mutex_state->name,
-            mutex_state->lock_count,
+            owner_id ? static_cast<int>(work->lockCount) : 0,
             mutex_state->attr,
             mutex_state->waiting_threads->size(),
-            mutex_state->owner == nullptr ? "not owned" : mutex_state->owner->name.c_str());
+            owner == emuenv.kernel.threads.end() ? "not owned" : owner->second->name.c_str());
     }
     ImGui::End();
 }
@@ -54,11 +54,13 @@ void draw_perf_overlay(GuiState &gui, EmuEnvState &emuenv) {
 
     const auto FPS_TEXT = emuenv.cfg.performance_overlay_detail == MINIMUM ? fmt::format("FPS: {}", emuenv.fps) : fmt::format("FPS: {} {}: {}", emuenv.fps, lang["avg"], emuenv.avg_fps);
     const auto MIN_MAX_FPS_TEXT = fmt::format("{}: {} {}: {}", lang["min"], emuenv.min_fps, lang["max"], emuenv.max_fps);
+    const auto COMMANDS_TEXT = fmt::format("{}: {}", lang["commands_per_sec"], emuenv.commands_per_sec);
 
     const ImVec2 TOTAL_WINDOW_PADDING(ImGui::GetStyle().WindowPadding.x * 2, ImGui::GetStyle().WindowPadding.y * 2);
 
-    const auto MAX_TEXT_WIDTH_SCALED = std::max(ImGui::CalcTextSize(FPS_TEXT.c_str()).x, emuenv.cfg.performance_overlay_detail == MINIMUM ? 0.f : ImGui::CalcTextSize(MIN_MAX_FPS_TEXT.c_str()).x) * FONT_SCALE;
-    const auto MAX_TEXT_HEIGHT_SCALED = SCALED_FONT_SIZE + (emuenv.cfg.performance_overlay_detail >= MEDIUM ? SCALED_FONT_SIZE + (ImGui::GetStyle().ItemSpacing.y * 2.f) : 0.f);
+    const auto DETAIL_TEXT_WIDTH = emuenv.cfg.performance_overlay_detail == MINIMUM ? 0.f : std::max(ImGui::CalcTextSize(MIN_MAX_FPS_TEXT.c_str()).x, ImGui::CalcTextSize(COMMANDS_TEXT.c_str()).x);
+    const auto MAX_TEXT_WIDTH_SCALED = std::max(ImGui::CalcTextSize(FPS_TEXT.c_str()).x, DETAIL_TEXT_WIDTH) * FONT_SCALE;
+    const auto MAX_TEXT_HEIGHT_SCALED = SCALED_FONT_SIZE + (emuenv.cfg.performance_overlay_detail >= MEDIUM ? (SCALED_FONT_SIZE * 2.f) + (ImGui::GetStyle().ItemSpacing.y * 3.f) : 0.f);
 
     const ImVec2 WINDOW_SIZE(MAX_TEXT_WIDTH_SCALED + TOTAL_WINDOW_PADDING.x, MAX_TEXT_HEIGHT_SCALED + TOTAL_WINDOW_PADDING.y);
     const ImVec2 MAIN_WINDOW_SIZE(WINDOW_SIZE.x + TOTAL_WINDOW_PADDING.x, WINDOW_SIZE.y + TOTAL_WINDOW_PADDING.y + (emuenv.cfg.performance_overlay_detail == MAXIMUM ? WINDOW_SIZE.y : 0.f));
@@ -78,6 +80,7 @@ void draw_perf_overlay(GuiState &gui, EmuEnvState &emuenv) {
     if (emuenv.cfg.performance_overlay_detail >= PerformanceOverlayDetail::MEDIUM) {
         ImGui::Separator();
         ImGui::Text("%s", MIN_MAX_FPS_TEXT.c_str());
+        ImGui::Text("%s", COMMANDS_TEXT.c_str());
     }
     ImGui::EndChild();
     ImGui::PopStyleVar();
@@ -220,6 +220,7 @@ static CPUBackend set_cpu_backend(std::string &cpu_backend) {
 }
 
 static int current_aniso_filter_log, max_aniso_filter_log, audio_backend_idx, current_user_lang;
+static const char *LIST_BACKEND_AUDIO[] = { "SDL", "Cubeb", "Null" };
 static std::vector<std::string> list_user_lang;
 
 /**
@@ -278,7 +279,8 @@ void init_config(GuiState &gui, EmuEnvState &emuenv, const std::string &app_path
     config_cpu_backend = set_cpu_backend(config.cpu_backend);
     current_aniso_filter_log = static_cast<int>(log2f(static_cast<float>(config.anisotropic_filtering)));
     max_aniso_filter_log = static_cast<int>(log2f(static_cast<float>(emuenv.renderer->get_max_anisotropic_filtering())));
-    audio_backend_idx = (emuenv.cfg.audio_backend == "SDL") ? 0 : 1;
+    const auto audio_backend = std::find(std::begin(LIST_BACKEND_AUDIO), std::end(LIST_BACKEND_AUDIO), emuenv.cfg.audio_backend);
+    audio_backend_idx = (audio_backend != std::end(LIST_BACKEND_AUDIO)) ? static_cast<int>(std::distance(std::begin(LIST_BACKEND_AUDIO), audio_backend)) : 1;
     emuenv.app_path = app_path;
     emuenv.display.imgui_render = true;
 }
@@ -483,7 +485,7 @@ void set_config(GuiState &gui, EmuEnvState &emuenv, const std::string &app_path)
     if (emuenv.io.title_id.empty()) {
         emuenv.kernel.cpu_backend = set_cpu_backend(emuenv.cfg.current_config.cpu_backend);
         emuenv.kernel.cpu_opt = emuenv.cfg.current_config.cpu_opt;
-        emuenv.audio.set_backend(emuenv.cfg.audio_backend);
+        emuenv.audio.set_backend(emuenv.cfg.get_audio_backend());
     }
 
     emuenv.audio.set_global_volume(emuenv.cfg.current_config.audio_volume / 100.f);
@@ -792,9 +794,13 @@ void draw_settings_dialog(GuiState &gui, EmuEnvState &emuenv) {
         if (fs::exists(shaders_cache_path) && !fs::is_empty(shaders_cache_path)) {
             ImGui::Spacing();
             if (ImGui::Button(lang.gpu["clean_shaders"].c_str())) {
+                // the archive of the running app is kept in memory, it must not keep appending to the removed file
+                emuenv.renderer->shader_archive.close();
                 fs::remove_all(shaders_cache_path);
                 fs::remove_all(emuenv.cache_path / "shaderlog");
                 fs::remove_all(emuenv.log_path / "shaderlog");
+                if (!emuenv.renderer->shaders_path.empty())
+                    emuenv.renderer->shader_archive.open(emuenv.renderer->shaders_path / "shaders.pack");
             }
         }
 
@@ -813,9 +819,10 @@ void draw_settings_dialog(GuiState &gui, EmuEnvState &emuenv) {
         ImGui::Spacing();
         if (!emuenv.io.app_path.empty())
             ImGui::BeginDisabled();
-        static const char *LIST_BACKEND_AUDIO[] = { "SDL", "Cubeb" };
-        if (ImGui::Combo(lang.audio["audio_backend"].c_str(), &audio_backend_idx, LIST_BACKEND_AUDIO, IM_ARRAYSIZE(LIST_BACKEND_AUDIO)))
+        if (ImGui::Combo(lang.audio["audio_backend"].c_str(), &audio_backend_idx, LIST_BACKEND_AUDIO, IM_ARRAYSIZE(LIST_BACKEND_AUDIO))) {
             emuenv.cfg.audio_backend = LIST_BACKEND_AUDIO[audio_backend_idx];
+            emuenv.cfg.audio_backend_override.reset();
+        }
         SetTooltipEx(lang.audio["select_audio_backend"].c_str());
         if (!emuenv.io.app_path.empty())
             ImGui::EndDisabled();
@@ -1134,6 +1141,13 @@ void draw_settings_dialog(GuiState &gui, EmuEnvState &emuenv) {
         ImGui::Checkbox(lang.debug["log_uniforms"].c_str(), &emuenv.cfg.log_uniforms);
         ImGui::SameLine();
         SetTooltipEx(lang.debug["log_uniforms_description"].c_str());
+        const char *LIST_SHADER_LOG_MODE[] = { lang.emulator["off"].c_str(), "GXP", lang.debug["shader_log_full"].c_str() };
+        ImGui::PushItemWidth(150.f * SCALE.x);
+        if (ImGui::Combo(lang.debug["shader_log_mode"].c_str(), &emuenv.cfg.shader_log_mode, LIST_SHADER_LOG_MODE, IM_ARRAYSIZE(LIST_SHADER_LOG_MODE)))
+            emuenv.renderer->shader_log_mode = static_cast<ShaderLogMode>(emuenv.cfg.shader_log_mode);
+        ImGui::PopItemWidth();
+        SetTooltipEx(lang.debug["shader_log_mode_description"].c_str());
+        ImGui::Spacing();
         ImGui::Checkbox(lang.debug["color_surface_debug"].c_str(), &emuenv.cfg.color_surface_debug);
         SetTooltipEx(lang.debug["color_surface_debug_description"].c_str());
         ImGui::SameLine();
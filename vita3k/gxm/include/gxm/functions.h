@@ -47,6 +47,12 @@ bool is_paletted_format(SceGxmTextureBaseFormat base_format);
 bool is_yuv_format(SceGxmTextureBaseFormat base_format);
 uint32_t attribute_format_size(SceGxmAttributeFormat format);
 bool is_stream_instancing(SceGxmIndexSource source);
+struct IndexRange {
+    uint32_t min;
+    uint32_t max;
+};
+// Return the smallest and the biggest index of an index buffer
+IndexRange get_index_range(const void *indices, SceGxmIndexFormat format, uint32_t count);
 bool convert_color_format_to_texture_format(SceGxmColorFormat format, SceGxmTextureFormat &dest_format);
 
 // Transfer
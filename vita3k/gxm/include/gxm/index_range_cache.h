@@ -0,0 +1,62 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <gxm/functions.h>
+#include <gxm/types.h>
+#include <mem/util.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+struct MemState;
+
+namespace gxm {
+
+// [min, max] of the index buffers drawn with a context, used to know which part of the vertex streams to copy.
+// An entry stays valid until a page of its index buffer is written, the pages are tracked with their write generations.
+// Only the pages entirely covered by an index buffer are tracked, the pages at its edges can be shared
+// with data written by the CPU all the time, the indices on them are scanned on each draw instead.
+class IndexRangeCache {
+public:
+    IndexRange get(MemState &mem, SceGxmIndexFormat format, Address indices, uint32_t count);
+
+private:
+    struct Entry {
+        SceGxmIndexFormat format;
+        IndexRange range;
+        uint64_t write_generation;
+        // a page of the index buffer keeps on being modified, it is scanned on each draw
+        bool untracked;
+    };
+
+    struct Page {
+        uint64_t write_generation;
+        uint32_t nb_invalidations;
+    };
+
+    // Track the pages of the range unless one of them keeps on being modified, whatever index buffers use it
+    bool track_pages(MemState &mem, Address start, Address end);
+
+    // indexed by (address << 32) | index count
+    std::unordered_map<uint64_t, Entry> entries;
+    // indexed by page number
+    std::unordered_map<uint32_t, Page> pages;
+};
+
+} // namespace gxm
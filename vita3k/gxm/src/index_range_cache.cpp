@@ -0,0 +1,107 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <gxm/index_range_cache.h>
+
+#include <mem/functions.h>
+#include <mem/ptr.h>
+#include <mem/state.h>
+#include <util/align.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace gxm {
+
+// used to bound the size of the cache of each context
+static constexpr size_t MAX_ENTRIES = 4096;
+static constexpr size_t MAX_PAGES = 64 * 1024;
+// after being modified this many times, a page is no longer tracked and the index buffers on it are scanned on each draw
+static constexpr uint32_t MAX_PAGE_INVALIDATIONS = 4;
+
+static IndexRange merge_index_ranges(const IndexRange &lhs, const IndexRange &rhs) {
+    return { std::min(lhs.min, rhs.min), std::max(lhs.max, rhs.max) };
+}
+
+bool IndexRangeCache::track_pages(MemState &mem, Address start, Address end) {
+    if (pages.size() >= MAX_PAGES)
+        pages.clear();
+
+    // the pages are shared by all the index buffers on them, the draws of one buffer with different index counts included
+    bool worth_tracking = true;
+    for (Address page_start = start; page_start < end; page_start += mem.page_size) {
+        const uint64_t write_generation = get_page_write_generation(mem, page_start, mem.page_size);
+        const auto [ite, inserted] = pages.try_emplace(page_start / mem.page_size, Page{ write_generation, 0 });
+        Page &page = ite->second;
+        if (!inserted && page.write_generation != write_generation) {
+            page.write_generation = write_generation;
+            page.nb_invalidations++;
+        }
+        if (page.nb_invalidations >= MAX_PAGE_INVALIDATIONS)
+            worth_tracking = false;
+    }
+
+    if (worth_tracking)
+        track_page_writes(mem, start, end - start);
+    return worth_tracking;
+}
+
+IndexRange IndexRangeCache::get(MemState &mem, SceGxmIndexFormat format, Address indices, uint32_t count) {
+    const uint8_t *data = Ptr<const uint8_t>(indices).get(mem);
+    const uint32_t index_size = (format == SCE_GXM_INDEX_FORMAT_U16) ? 2 : 4;
+
+    const Address end = indices + count * index_size;
+    const Address inner_start = align(indices, mem.page_size);
+    const Address inner_end = align_down(end, mem.page_size);
+    if (inner_start >= inner_end || (indices % index_size) != 0)
+        return get_index_range(data, format, count);
+
+    const uint32_t head_count = (inner_start - indices) / index_size;
+    const uint32_t inner_count = (inner_end - inner_start) / index_size;
+    const uint32_t tail_count = (end - inner_end) / index_size;
+    IndexRange edges_range = { std::numeric_limits<uint32_t>::max(), 0 };
+    if (head_count > 0)
+        edges_range = merge_index_ranges(edges_range, get_index_range(data, format, head_count));
+    if (tail_count > 0)
+        edges_range = merge_index_ranges(edges_range, get_index_range(data + (inner_end - indices), format, tail_count));
+
+    const uint8_t *inner_data = data + (inner_start - indices);
+    if (entries.size() >= MAX_ENTRIES)
+        entries.clear();
+
+    const uint64_t key = (static_cast<uint64_t>(inner_start) << 32) | inner_count;
+    auto [ite, inserted] = entries.try_emplace(key);
+    Entry &entry = ite->second;
+    if (!inserted && entry.format == format) {
+        if (entry.untracked)
+            return merge_index_ranges(edges_range, get_index_range(inner_data, format, inner_count));
+
+        if (get_page_write_generation(mem, inner_start, inner_end - inner_start) == entry.write_generation)
+            return merge_index_ranges(edges_range, entry.range);
+    } else {
+        entry.format = format;
+    }
+
+    // the pages must be tracked before the indices are read so no write can be missed
+    entry.untracked = !track_pages(mem, inner_start, inner_end);
+    if (!entry.untracked)
+        entry.write_generation = get_page_write_generation(mem, inner_start, inner_end - inner_start);
+    entry.range = get_index_range(inner_data, format, inner_count);
+    return merge_index_ranges(edges_range, entry.range);
+}
+
+} // namespace gxm
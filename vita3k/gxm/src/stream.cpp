@@ -15,10 +15,189 @@
 // with this program; if not, write to the Free Software Foundation, Inc.,
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
+#include <gxm/functions.h>
 #include <gxm/types.h>
+#include <util/log.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#else
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE41 __attribute__((__target__("sse4.1")))
+#define TARGET_AVX2 __attribute__((__target__("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define TARGET_SSE41
+#define TARGET_AVX2
+#include <intrin.h>
+#else
+#error "Compiler is not supported"
+#endif
+#include <util/instrset_detect.h>
+#endif
 
 namespace gxm {
 bool is_stream_instancing(SceGxmIndexSource source) {
     return (source == SCE_GXM_INDEX_SOURCE_EACH_INSTANCE_16BIT) || (source == SCE_GXM_INDEX_SOURCE_EACH_INSTANCE_32BIT);
 }
+
+template <typename T>
+static IndexRange get_index_range_basic(const T *indices, uint32_t count) {
+    T min = std::numeric_limits<T>::max();
+    T max = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        min = std::min(min, indices[i]);
+        max = std::max(max, indices[i]);
+    }
+
+    return { min, max };
+}
+
+// fold the partial min and max of the vector lanes with the indices which were not handled by the vectorized loop
+template <typename T, size_t N>
+static IndexRange reduce_index_range(const T (&mins)[N], const T (&maxs)[N], const T *remaining, uint32_t remaining_count) {
+    IndexRange range = get_index_range_basic(remaining, remaining_count);
+    for (size_t i = 0; i < N; i++) {
+        range.min = std::min<uint32_t>(range.min, mins[i]);
+        range.max = std::max<uint32_t>(range.max, maxs[i]);
+    }
+
+    return range;
+}
+
+#if defined(__aarch64__)
+
+template <typename T>
+static IndexRange get_index_range_NEON(const T *indices, uint32_t count) {
+    uint32_t i = 0;
+    if constexpr (sizeof(T) == 2) {
+        uint16x8_t vmin = vdupq_n_u16(std::numeric_limits<uint16_t>::max());
+        uint16x8_t vmax = vdupq_n_u16(0);
+        for (; i + 8 <= count; i += 8) {
+            const uint16x8_t v = vld1q_u16(indices + i);
+            vmin = vminq_u16(vmin, v);
+            vmax = vmaxq_u16(vmax, v);
+        }
+
+        IndexRange range = get_index_range_basic(indices + i, count - i);
+        if (i > 0) {
+            range.min = std::min<uint32_t>(range.min, vminvq_u16(vmin));
+            range.max = std::max<uint32_t>(range.max, vmaxvq_u16(vmax));
+        }
+        return range;
+    } else {
+        uint32x4_t vmin = vdupq_n_u32(std::numeric_limits<uint32_t>::max());
+        uint32x4_t vmax = vdupq_n_u32(0);
+        for (; i + 4 <= count; i += 4) {
+            const uint32x4_t v = vld1q_u32(indices + i);
+            vmin = vminq_u32(vmin, v);
+            vmax = vmaxq_u32(vmax, v);
+        }
+
+        IndexRange range = get_index_range_basic(indices + i, count - i);
+        if (i > 0) {
+            range.min = std::min(range.min, vminvq_u32(vmin));
+            range.max = std::max(range.max, vmaxvq_u32(vmax));
+        }
+        return range;
+    }
+}
+
+#else
+
+template <typename T>
+static IndexRange TARGET_SSE41 get_index_range_SSE41(const T *indices, uint32_t count) {
+    constexpr uint32_t lanes = 16 / sizeof(T);
+    __m128i vmin = _mm_set1_epi8(-1);
+    __m128i vmax = _mm_setzero_si128();
+
+    uint32_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i));
+        if constexpr (sizeof(T) == 2) {
+            vmin = _mm_min_epu16(vmin, v);
+            vmax = _mm_max_epu16(vmax, v);
+        } else {
+            vmin = _mm_min_epu32(vmin, v);
+            vmax = _mm_max_epu32(vmax, v);
+        }
+    }
+
+    if (i == 0)
+        return get_index_range_basic(indices, count);
+
+    T mins[lanes], maxs[lanes];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(mins), vmin);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(maxs), vmax);
+    return reduce_index_range(mins, maxs, indices + i, count - i);
+}
+
+template <typename T>
+static IndexRange TARGET_AVX2 get_index_range_AVX2(const T *indices, uint32_t count) {
+    constexpr uint32_t lanes = 32 / sizeof(T);
+    __m256i vmin = _mm256_set1_epi8(-1);
+    __m256i vmax = _mm256_setzero_si256();
+
+    uint32_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i));
+        if constexpr (sizeof(T) == 2) {
+            vmin = _mm256_min_epu16(vmin, v);
+            vmax = _mm256_max_epu16(vmax, v);
+        } else {
+            vmin = _mm256_min_epu32(vmin, v);
+            vmax = _mm256_max_epu32(vmax, v);
+        }
+    }
+
+    if (i == 0)
+        return get_index_range_basic(indices, count);
+
+    T mins[lanes], maxs[lanes];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(mins), vmin);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(maxs), vmax);
+    return reduce_index_range(mins, maxs, indices + i, count - i);
+}
+
+#endif
+
+struct IndexRangeFunctions {
+    IndexRange (*u16)(const uint16_t *indices, uint32_t count);
+    IndexRange (*u32)(const uint32_t *indices, uint32_t count);
+};
+
+// draws can be done from multiple threads, so the selection is done once in a thread-safe static
+static const IndexRangeFunctions &get_index_range_functions() {
+    static const IndexRangeFunctions functions = []() -> IndexRangeFunctions {
+#if defined(__aarch64__)
+        return { get_index_range_NEON<uint16_t>, get_index_range_NEON<uint32_t> };
+#else
+        const int instrset = util::instrset::instrset_detect();
+        if (instrset >= util::instrset::instrset_AVX2) {
+            LOG_INFO("AVX2 instruction set is supported. Using AVX2 index range scan");
+            return { get_index_range_AVX2<uint16_t>, get_index_range_AVX2<uint32_t> };
+        } else if (instrset >= util::instrset::instrset_SSE4_1) {
+            LOG_INFO("SSE4.1 instruction set is supported. Using SSE4.1 index range scan");
+            return { get_index_range_SSE41<uint16_t>, get_index_range_SSE41<uint32_t> };
+        }
+
+        LOG_INFO("SSE4.1 instruction set is not supported. Using basic index range scan");
+        return { get_index_range_basic<uint16_t>, get_index_range_basic<uint32_t> };
+#endif
+    }();
+    return functions;
+}
+
+IndexRange get_index_range(const void *indices, SceGxmIndexFormat format, uint32_t count) {
+    if (count == 0)
+        return { 0, 0 };
+
+    if (format == SCE_GXM_INDEX_FORMAT_U16)
+        return get_index_range_functions().u16(static_cast<const uint16_t *>(indices), count);
+    else
+        return get_index_range_functions().u32(static_cast<const uint32_t *>(indices), count);
+}
 } // namespace gxm
@@ -0,0 +1,98 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <gxm/index_range_cache.h>
+#include <mem/functions.h>
+#include <mem/ptr.h>
+#include <mem/state.h>
+#include <mem/test_state.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+class index_range_cache : public testing::Test {
+protected:
+    void SetUp() override {
+        MemState &mem = get_mem();
+        page_size = mem.page_size;
+        base = alloc(mem, page_size * 4, "index_range_cache");
+        ASSERT_NE(base, 0);
+        indices = Ptr<uint16_t>(base).get(mem);
+        fill(0);
+    }
+
+    void TearDown() override {
+        free(get_mem(), base);
+    }
+
+    // the first index is the smallest and the last one the biggest
+    void fill(uint16_t first) {
+        const uint32_t count = page_size * 4 / sizeof(uint16_t);
+        for (uint32_t i = 0; i < count; i++)
+            indices[i] = first + std::min<uint32_t>(i, 1000);
+    }
+
+    gxm::IndexRange get(uint32_t count) {
+        return cache.get(get_mem(), SCE_GXM_INDEX_FORMAT_U16, base, count);
+    }
+
+    gxm::IndexRangeCache cache;
+    uint32_t page_size = 0;
+    Address base = 0;
+    uint16_t *indices = nullptr;
+};
+
+TEST_F(index_range_cache, cached_until_written) {
+    const uint32_t count = page_size * 2 / sizeof(uint16_t);
+    gxm::IndexRange range = get(count);
+    EXPECT_EQ(range.min, 0);
+    EXPECT_EQ(range.max, 1000);
+    EXPECT_TRUE(is_protecting(get_mem(), base));
+
+    range = get(count);
+    EXPECT_EQ(range.min, 0);
+    EXPECT_EQ(range.max, 1000);
+
+    fill(10);
+    range = get(count);
+    EXPECT_EQ(range.min, 10);
+    EXPECT_EQ(range.max, 1010);
+    EXPECT_TRUE(is_protecting(get_mem(), base));
+}
+
+TEST_F(index_range_cache, alternating_counts_over_rewritten_buffer) {
+    // a ring buffered index buffer, drawn with a different count each time it is rewritten
+    const uint32_t counts[] = { page_size * 2 / sizeof(uint16_t), page_size * 3 / sizeof(uint16_t) + 7 };
+    for (uint16_t i = 0; i < 16; i++) {
+        fill(i);
+        const gxm::IndexRange range = get(counts[i % 2]);
+        EXPECT_EQ(range.min, i);
+        EXPECT_EQ(range.max, i + 1000);
+    }
+
+    // the pages keep on being modified whatever the index count, they are no longer write protected
+    EXPECT_FALSE(is_protecting(get_mem(), base));
+    EXPECT_FALSE(is_protecting(get_mem(), base + page_size));
+
+    // and the ranges are still right, with an index count never used before too
+    fill(100);
+    const gxm::IndexRange range = get(page_size * 2 / sizeof(uint16_t) + 1);
+    EXPECT_EQ(range.min, 100);
+    EXPECT_EQ(range.max, 1100);
+    EXPECT_FALSE(is_protecting(get_mem(), base));
+}
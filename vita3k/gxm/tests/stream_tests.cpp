@@ -0,0 +1,104 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <gxm/functions.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// the counts are not multiple of the vector sizes, so the remaining indices are tested too
+static constexpr uint32_t TEST_COUNTS[] = { 1, 2, 7, 8, 9, 15, 16, 17, 31, 33, 100, 1023 };
+
+template <typename T>
+static std::vector<T> make_indices(size_t count, uint32_t seed, uint32_t max_index) {
+    std::vector<T> indices(count);
+    for (T &index : indices) {
+        seed = seed * 1664525 + 1013904223;
+        index = static_cast<T>((seed >> 8) % max_index);
+    }
+
+    return indices;
+}
+
+template <typename T>
+static gxm::IndexRange get_index_range_reference(const std::vector<T> &indices) {
+    return { *std::min_element(indices.begin(), indices.end()), *std::max_element(indices.begin(), indices.end()) };
+}
+
+template <typename T>
+static void check_index_range(SceGxmIndexFormat format) {
+    for (const uint32_t count : TEST_COUNTS) {
+        // put the extremes at every position, so each lane and the remaining indices are checked
+        for (uint32_t position = 0; position < count; position++) {
+            std::vector<T> indices = make_indices<T>(count, position + 1, 1000);
+            indices[position] = 0;
+            indices[count - 1 - position] = 1500;
+
+            const gxm::IndexRange expected = get_index_range_reference(indices);
+            const gxm::IndexRange range = gxm::get_index_range(indices.data(), format, count);
+            ASSERT_EQ(range.min, expected.min) << count << " indices, position " << position;
+            ASSERT_EQ(range.max, expected.max) << count << " indices, position " << position;
+        }
+    }
+}
+
+TEST(gxm_stream, index_range_u16_matches_reference) {
+    check_index_range<uint16_t>(SCE_GXM_INDEX_FORMAT_U16);
+}
+
+TEST(gxm_stream, index_range_u32_matches_reference) {
+    check_index_range<uint32_t>(SCE_GXM_INDEX_FORMAT_U32);
+}
+
+TEST(gxm_stream, index_range_unaligned) {
+    // index buffers are not aligned to the vector size
+    for (const uint32_t count : TEST_COUNTS) {
+        const std::vector<uint16_t> indices = make_indices<uint16_t>(count + 1, count, 60000);
+        const std::vector<uint16_t> expected_indices(indices.begin() + 1, indices.end());
+
+        const gxm::IndexRange expected = get_index_range_reference(expected_indices);
+        const gxm::IndexRange range = gxm::get_index_range(indices.data() + 1, SCE_GXM_INDEX_FORMAT_U16, count);
+        ASSERT_EQ(range.min, expected.min) << count << " indices";
+        ASSERT_EQ(range.max, expected.max) << count << " indices";
+    }
+}
+
+TEST(gxm_stream, index_range_primitive_restart) {
+    // the primitive restart index is the biggest representable index, the range includes it like the scalar scan
+    for (const uint32_t count : TEST_COUNTS) {
+        std::vector<uint16_t> indices16 = make_indices<uint16_t>(count, count, 1000);
+        indices16[count / 2] = std::numeric_limits<uint16_t>::max();
+        const gxm::IndexRange range16 = gxm::get_index_range(indices16.data(), SCE_GXM_INDEX_FORMAT_U16, count);
+        EXPECT_EQ(range16.min, get_index_range_reference(indices16).min) << count << " indices";
+        EXPECT_EQ(range16.max, std::numeric_limits<uint16_t>::max()) << count << " indices";
+
+        std::vector<uint32_t> indices32 = make_indices<uint32_t>(count, count, 1000);
+        indices32[count - 1] = std::numeric_limits<uint32_t>::max();
+        const gxm::IndexRange range32 = gxm::get_index_range(indices32.data(), SCE_GXM_INDEX_FORMAT_U32, count);
+        EXPECT_EQ(range32.min, get_index_range_reference(indices32).min) << count << " indices";
+        EXPECT_EQ(range32.max, std::numeric_limits<uint32_t>::max()) << count << " indices";
+    }
+}
+
+TEST(gxm_stream, index_range_empty) {
+    const gxm::IndexRange range = gxm::get_index_range(nullptr, SCE_GXM_INDEX_FORMAT_U16, 0);
+    EXPECT_EQ(range.min, 0);
+    EXPECT_EQ(range.max, 0);
+}
@@ -384,8 +384,8 @@ uint32_t install_contents(EmuEnvState &emuenv, GuiState *gui, const fs::path &pa
 }
 
 static ExitCode load_app_impl(SceUID &main_module_id, EmuEnvState &emuenv) {
-    const auto call_import = [&emuenv](CPUState &cpu, uint32_t nid, SceUID thread_id) {
-        ::call_import(emuenv, cpu, nid, thread_id);
+    const auto call_import = [&emuenv](CPUState &cpu, uint32_t nid, uint32_t index, ThreadState &thread) {
+        ::call_import(emuenv, cpu, nid, index, thread);
     };
     if (!emuenv.kernel.init(emuenv.mem, call_import, emuenv.kernel.cpu_backend, emuenv.kernel.cpu_opt)) {
         LOG_WARN("Failed to init kernel!");
@@ -0,0 +1,84 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <threads/queue.h>
+#include <util/types.h>
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// Runs asynchronous file operations on worker threads.
+// Operations on the same file descriptor are run in the order they were submitted.
+class AsyncIoEngine {
+public:
+    typedef std::function<SceOff()> Operation;
+    typedef std::function<void(SceOff result)> CompletionCallback;
+
+    explicit AsyncIoEngine(size_t nb_workers = 2);
+    ~AsyncIoEngine();
+
+    AsyncIoEngine(const AsyncIoEngine &) = delete;
+    AsyncIoEngine &operator=(const AsyncIoEngine &) = delete;
+
+    // Queue an operation on fd (or on no file if fd is negative), on_complete is called from the worker once it is done.
+    // Returns the id of the operation.
+    SceUID submit(SceUID fd, Operation operation, CompletionCallback on_complete);
+
+    // Queue a background task nobody waits for, it has no id
+    void post(std::function<void()> task);
+
+    // Wait for the operation to be done and release its id, returns its result or nullopt if the id is unknown.
+    std::optional<SceOff> wait(SceUID id);
+
+    // Wait for all the operations on fd and release their ids, used before the file is closed.
+    void wait_fd(SceUID fd);
+
+private:
+    struct AsyncOperation {
+        SceUID id;
+        SceUID fd;
+        Operation operation;
+        CompletionCallback on_complete;
+        // previous operation on the same file, it must be done before this one starts
+        std::shared_ptr<AsyncOperation> previous;
+        SceOff result = 0;
+        bool done = false;
+    };
+    typedef std::shared_ptr<AsyncOperation> AsyncOperationPtr;
+
+    void worker_loop();
+    void wait_done(std::unique_lock<std::mutex> &lock, const AsyncOperation &operation);
+    void drop_unwaited_operations();
+
+    std::mutex mutex;
+    std::condition_variable operation_done;
+    SceUID next_id = 1;
+    std::map<SceUID, AsyncOperationPtr> operations;
+    // last operation submitted for each file descriptor
+    std::map<SceUID, std::weak_ptr<AsyncOperation>> last_fd_operations;
+
+    Queue<AsyncOperationPtr> queue;
+    std::vector<std::thread> workers;
+};
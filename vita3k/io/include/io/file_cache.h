@@ -0,0 +1,124 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <util/fs.h>
+#include <util/types.h>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class AsyncIoEngine;
+
+// Bounded LRU cache of pages of read-only game files (app0 and addcont0).
+// Pages are loaded on demand, and ahead of the reads when a file is read sequentially.
+class FileCache {
+public:
+    static constexpr uint32_t CACHE_PAGE_SIZE = 64 * 1024;
+    // how far ahead of a sequential read pages are prefetched
+    static constexpr uint32_t READ_AHEAD_SIZE = 512 * 1024;
+
+    explicit FileCache(size_t max_size = 64 * 1024 * 1024);
+    ~FileCache();
+
+    // Keep the host file of a guest file open, until as many close as open are done
+    void open(const fs::path &path);
+    void close(const fs::path &path);
+
+    // Read size bytes at offset of the host file, returns the number of bytes read or -1 on error.
+    // Pages following a sequential read are prefetched on prefetch_engine if it is not null.
+    SceOff read(const fs::path &path, void *data, SceOff offset, SceSize size, AsyncIoEngine *prefetch_engine);
+
+    // Load the pages of the range in the background
+    void prefetch(const fs::path &path, SceOff offset, SceSize size, AsyncIoEngine &engine);
+
+    // Drop the pages of a host file, or of all the files under a host directory, after they changed
+    void invalidate(const fs::path &path);
+
+    uint64_t get_hits() const {
+        return hits;
+    }
+
+    uint64_t get_misses() const {
+        return misses;
+    }
+
+    uint64_t get_prefetched() const {
+        return prefetched;
+    }
+
+private:
+    struct PageKey {
+        fs::path::string_type path;
+        uint64_t index;
+
+        bool operator==(const PageKey &rhs) const = default;
+    };
+
+    struct PageKeyHash {
+        size_t operator()(const PageKey &key) const {
+            return std::hash<fs::path::string_type>()(key.path) ^ (std::hash<uint64_t>()(key.index) * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    struct Page {
+        // shorter than CACHE_PAGE_SIZE for the last page of a file
+        std::vector<uint8_t> data;
+        std::list<PageKey>::iterator lru_it;
+    };
+
+    // Opened host file, shared by the reads and the prefetches of the guest files
+    struct HostFile;
+
+    struct File {
+        std::shared_ptr<HostFile> host;
+        // end of the last read, to detect sequential reads
+        SceOff read_end = 0;
+        uint32_t open_count = 0;
+    };
+
+    std::shared_ptr<HostFile> get_host_file(const PageKey &key);
+    static bool load_page(HostFile &host, uint64_t index, std::vector<uint8_t> &data);
+    // Assumes mutex is locked
+    void insert_page(const PageKey &key, std::vector<uint8_t> &&data);
+    void erase_page(const PageKey &key);
+
+    size_t max_size;
+    size_t current_size = 0;
+
+    std::mutex mutex;
+    std::unordered_map<PageKey, Page, PageKeyHash> pages;
+    // most recently used first
+    std::list<PageKey> lru;
+    // indexes of the cached pages of each file
+    std::unordered_map<fs::path::string_type, std::unordered_set<uint64_t>> file_pages;
+    // pages being loaded by a prefetch
+    std::unordered_set<PageKey, PageKeyHash> pending_pages;
+    std::unordered_map<fs::path::string_type, File> files;
+    // incremented when cached files change, pages loaded before are not inserted
+    uint64_t invalidations = 0;
+
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+    std::atomic<uint64_t> prefetched = 0;
+};
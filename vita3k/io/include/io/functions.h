@@ -27,6 +27,7 @@
 
 #include <util/fs.h>
 
+#include <optional>
 #include <string>
 
 struct IOState;
@@ -78,6 +79,16 @@ int close_file(IOState &io, SceUID fd, const char *export_name);
 int remove_file(IOState &io, const char *file, const fs::path &pref_path, const char *export_name);
 int rename(IOState &io, const char *old_name, const char *new_name, const fs::path &pref_path, const char *export_name);
 
+// Asynchronous operations return the id of the operation and write their result to param (if not null) once they are done.
+// Reads, writes and seeks of regular files run on the async IO workers, other operations are done right away.
+SceUID open_file_async(IOState &io, const char *path, const int flags, const fs::path &pref_path, SceIoAsyncParam *param, const char *export_name);
+SceUID close_file_async(IOState &io, SceUID fd, SceIoAsyncParam *param, const char *export_name);
+SceUID read_file_async(void *data, IOState &io, SceUID fd, SceSize size, std::optional<SceOff> offset, SceIoAsyncParam *param, const char *export_name);
+SceUID write_file_async(const void *data, IOState &io, SceUID fd, SceSize size, std::optional<SceOff> offset, SceIoAsyncParam *param, const char *export_name);
+SceUID seek_file_async(IOState &io, SceUID fd, SceOff offset, SceIoSeekMode whence, SceIoAsyncParam *param, const char *export_name);
+// Wait for an asynchronous operation to be done and release its id
+int complete_async(IOState &io, SceUID id, SceOff *result, const char *export_name);
+
 SceUID open_dir(IOState &io, const char *path, const fs::path &pref_path, const char *export_name);
 SceUID read_dir(IOState &io, SceUID fd, SceIoDirent *dent, const fs::path &pref_path, const char *export_name);
 int create_dir(IOState &io, const char *dir, int mode, const fs::path &pref_path, const char *export_name, const bool recursive = false);
@@ -0,0 +1,74 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <util/fs.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Index of all the files and directories of a tree the app does not modify (app0 and addcont0).
+// Paths are resolved case-insensitively from the index without touching the host filesystem, a path under the root
+// it does not know does not exist. Only the host paths differing in case from another one and the paths outside
+// of the root are looked up on the host. Directories are stat from the index, files can be rewritten in place and are not.
+// The index is saved once built and only walked again when a directory of the tree changed.
+class PathIndex {
+public:
+    struct Entry {
+        // path relative to the root, with the case of the host filesystem
+        std::string relative_path;
+        uint64_t size = 0;
+        // host times, in seconds
+        int64_t atime = 0;
+        int64_t mtime = 0;
+        int64_t ctime = 0;
+        bool is_directory = false;
+        // another host path only differs from this one in case, only exact matches are found then
+        bool case_collision = false;
+    };
+
+    // Load the index of root saved at index_path, or walk root to build it and save it there
+    PathIndex(const fs::path &root, const fs::path &index_path);
+
+    // Find a host path under the root, returns nullptr if it is outside of the root or not indexed.
+    // missing is set when the path is known not to exist, only then a miss does not need a host lookup
+    const Entry *find(const fs::path &path, bool case_sensitive, bool *missing = nullptr) const;
+
+    fs::path get_host_path(const Entry &entry) const;
+
+    const fs::path &get_index_path() const {
+        return index_path;
+    }
+
+private:
+    bool load();
+    void build();
+    void save() const;
+
+    fs::path root;
+    fs::path index_path;
+    // lowercase root with a trailing slash
+    std::string root_prefix;
+    // used to know quickly if the saved index is out of date, before checking each directory
+    int64_t root_mtime = 0;
+    int64_t sfo_mtime = 0;
+
+    // key is the lowercase relative path
+    std::unordered_map<std::string, Entry> entries;
+};
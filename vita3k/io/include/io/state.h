@@ -17,17 +17,23 @@
 
 #pragma once
 
+#include <io/async.h>
+#include <io/file_cache.h>
 #include <io/filesystem.h>
+#include <io/path_index.h>
 #include <io/types.h>
 #include <io/util.h>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 // Class for all needed information to access files on Vita3K.
 class FileStats : public VitaStats {
     // Shared file pointer
     FilePtr wrapped_file;
+    bool cached = false;
 
 public:
     // Constructor used for files
@@ -43,6 +49,15 @@ public:
         file_info.access_mode = SCE_S_IFREG;
     }
 
+    // Read-only game data, read through IOState::file_cache
+    bool is_cached() const {
+        return cached;
+    }
+
+    void set_cached(const bool value) {
+        cached = value;
+    }
+
     bool is_regular_file() const {
         return file_info.file_mode & SCE_SO_IFREG;
     }
@@ -63,6 +78,9 @@ public:
     // File functions
     SceOff read(void *input_data, int element_size, SceSize element_count) const;
     SceOff write(const void *data, SceSize size, int count) const;
+    // Read or write at offset without using or moving the position of the file
+    SceOff read_at(void *data, SceSize size, SceOff offset) const;
+    SceOff write_at(const void *data, SceSize size, SceOff offset) const;
     int truncate(const SceSize size) const;
     bool seek(SceOff offset, SceIoSeekMode seek_mode) const;
     SceOff tell() const;
@@ -98,6 +116,12 @@ typedef std::map<SceUID, TtyType> TtyFiles;
 typedef std::map<SceUID, FileStats> StdFiles;
 typedef std::map<SceUID, DirStats> DirEntries;
 
+struct PathIndexSlot {
+    std::shared_ptr<const PathIndex> index;
+    // set when the app writes to the tree, the index is not used anymore until the next boot
+    bool disabled = false;
+};
+
 struct IOState {
     struct DevicePaths {
         std::string app0;
@@ -121,7 +145,16 @@ struct IOState {
     StdFiles std_files;
     DirEntries dir_entries;
 
+    // the engine runs the file cache prefetches, so it must be destroyed first
+    std::unique_ptr<FileCache> file_cache;
+    std::unique_ptr<AsyncIoEngine> async_engine;
+
     std::unordered_map<std::string, std::string> cachemap;
+    // indexes of app0 and addcont0, loaded on first use
+    fs::path path_index_path;
+    std::mutex path_index_mutex;
+    PathIndexSlot app0_index;
+    PathIndexSlot addcont0_index;
     bool case_isens_find_enabled = false;
 
     std::mutex overlay_mutex;
@@ -115,6 +115,16 @@ struct SceIoDirent {
     int dummy;
 };
 
+// Filled in by asynchronous operations once they are done
+struct SceIoAsyncParam {
+    SceInt32 result; //!< Lower 32 bits of the result
+    SceInt32 result_high; //!< Upper 32 bits of the result, only used by lseek
+    SceInt32 unk_08;
+    SceInt32 unk_0C;
+    SceInt32 unk_10;
+    SceInt32 unk_14;
+};
+
 struct SceIoDevInfo {
     SceInt64 max_size;
     SceInt64 free_size;
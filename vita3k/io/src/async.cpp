@@ -0,0 +1,130 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <io/async.h>
+
+// operations nobody waits for are dropped once they are done and there are too many of them
+static constexpr size_t MAX_KEPT_OPERATIONS = 1024;
+
+AsyncIoEngine::AsyncIoEngine(size_t nb_workers) {
+    for (size_t i = 0; i < nb_workers; i++)
+        workers.emplace_back(&AsyncIoEngine::worker_loop, this);
+}
+
+AsyncIoEngine::~AsyncIoEngine() {
+    queue.abort();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+SceUID AsyncIoEngine::submit(SceUID fd, Operation operation, CompletionCallback on_complete) {
+    auto async_operation = std::make_shared<AsyncOperation>();
+    async_operation->fd = fd;
+    async_operation->operation = std::move(operation);
+    async_operation->on_complete = std::move(on_complete);
+
+    {
+        const std::lock_guard<std::mutex> guard(mutex);
+        async_operation->id = next_id++;
+        if (fd >= 0) {
+            auto &last_operation = last_fd_operations[fd];
+            async_operation->previous = last_operation.lock();
+            last_operation = async_operation;
+        }
+        operations.emplace(async_operation->id, async_operation);
+        drop_unwaited_operations();
+    }
+
+    const SceUID id = async_operation->id;
+    queue.push(std::move(async_operation));
+    return id;
+}
+
+void AsyncIoEngine::drop_unwaited_operations() {
+    // the oldest ones first, the ids are increasing
+    for (auto it = operations.begin(); it != operations.end() && operations.size() > MAX_KEPT_OPERATIONS;) {
+        if (it->second->done)
+            it = operations.erase(it);
+        else
+            ++it;
+    }
+}
+
+void AsyncIoEngine::post(std::function<void()> task) {
+    auto async_operation = std::make_shared<AsyncOperation>();
+    async_operation->id = 0;
+    async_operation->fd = -1;
+    async_operation->operation = [task = std::move(task)]() -> SceOff {
+        task();
+        return 0;
+    };
+    queue.push(std::move(async_operation));
+}
+
+void AsyncIoEngine::wait_done(std::unique_lock<std::mutex> &lock, const AsyncOperation &operation) {
+    operation_done.wait(lock, [&]() { return operation.done; });
+}
+
+std::optional<SceOff> AsyncIoEngine::wait(SceUID id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    const auto it = operations.find(id);
+    if (it == operations.end())
+        return std::nullopt;
+
+    const AsyncOperationPtr operation = it->second;
+    wait_done(lock, *operation);
+    operations.erase(id);
+    return operation->result;
+}
+
+void AsyncIoEngine::wait_fd(SceUID fd) {
+    std::unique_lock<std::mutex> lock(mutex);
+    const auto it = last_fd_operations.find(fd);
+    if (it == last_fd_operations.end())
+        return;
+
+    // operations are run in order, so the last one is done after all the others
+    if (const AsyncOperationPtr operation = it->second.lock())
+        wait_done(lock, *operation);
+    last_fd_operations.erase(fd);
+
+    // the file is closed, nobody can wait for its operations anymore
+    std::erase_if(operations, [fd](const auto &operation) { return operation.second->fd == fd; });
+}
+
+void AsyncIoEngine::worker_loop() {
+    // the queue is FIFO, so the previous operation on the same file was already taken by a worker and waiting for it can't deadlock
+    while (auto next = queue.pop()) {
+        AsyncOperation &operation = **next;
+        if (operation.previous) {
+            std::unique_lock<std::mutex> lock(mutex);
+            wait_done(lock, *operation.previous);
+            operation.previous.reset();
+        }
+
+        const SceOff result = operation.operation();
+        if (operation.on_complete)
+            operation.on_complete(result);
+
+        {
+            const std::lock_guard<std::mutex> guard(mutex);
+            operation.result = result;
+            operation.done = true;
+        }
+        operation_done.notify_all();
+    }
+}
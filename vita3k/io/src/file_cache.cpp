@@ -0,0 +1,263 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <io/file_cache.h>
+
+#include <io/async.h>
+#include <io/state.h>
+#include <util/log.h>
+
+#include <algorithm>
+#include <cstring>
+
+FileCache::FileCache(size_t max_size)
+    : max_size(max_size) {
+}
+
+FileCache::~FileCache() {
+    if (hits || misses)
+        LOG_INFO("File cache: {} page hits, {} page misses, {} pages prefetched", hits.load(), misses.load(), prefetched.load());
+}
+
+struct FileCache::HostFile {
+    explicit HostFile(const fs::path &path)
+        : file("", "", path, SCE_O_RDONLY) {
+    }
+
+    // separate from the guest file, whose position must not change
+    FileStats file;
+    // the pages of a file are loaded one at a time, they move the same position
+    std::mutex mutex;
+};
+
+void FileCache::open(const fs::path &path) {
+    const std::lock_guard<std::mutex> guard(mutex);
+    files[path.native()].open_count++;
+}
+
+void FileCache::close(const fs::path &path) {
+    const std::lock_guard<std::mutex> guard(mutex);
+    const auto file = files.find(path.native());
+    if (file != files.end() && --file->second.open_count == 0)
+        files.erase(file);
+}
+
+std::shared_ptr<FileCache::HostFile> FileCache::get_host_file(const PageKey &key) {
+    {
+        const std::lock_guard<std::mutex> guard(mutex);
+        const auto file = files.find(key.path);
+        if (file != files.end() && file->second.host)
+            return file->second.host;
+    }
+
+    // open it without holding the lock, another thread may have opened it meanwhile
+    auto host = std::make_shared<HostFile>(fs::path(key.path));
+    if (!host->file.get_file_pointer())
+        return nullptr;
+
+    // the host file is only kept while the guest file is open, a late prefetch must not add it back
+    const std::lock_guard<std::mutex> guard(mutex);
+    const auto file = files.find(key.path);
+    if (file == files.end())
+        return host;
+    if (!file->second.host)
+        file->second.host = std::move(host);
+    return file->second.host;
+}
+
+bool FileCache::load_page(HostFile &host, const uint64_t index, std::vector<uint8_t> &data) {
+    const std::lock_guard<std::mutex> guard(host.mutex);
+    if (!host.file.seek(index * CACHE_PAGE_SIZE, SCE_SEEK_SET))
+        return false;
+
+    data.resize(CACHE_PAGE_SIZE);
+    const SceOff read = host.file.read(data.data(), 1, CACHE_PAGE_SIZE);
+    if (read < 0)
+        return false;
+
+    data.resize(read);
+    return true;
+}
+
+void FileCache::insert_page(const PageKey &key, std::vector<uint8_t> &&data) {
+    if (pages.contains(key))
+        return;
+
+    current_size += data.size();
+    lru.push_front(key);
+    pages.emplace(key, Page{ std::move(data), lru.begin() });
+    file_pages[key.path].insert(key.index);
+
+    while (current_size > max_size && lru.size() > 1)
+        erase_page(lru.back());
+}
+
+void FileCache::erase_page(const PageKey &key) {
+    const auto page = pages.find(key);
+    if (page == pages.end())
+        return;
+
+    current_size -= page->second.data.size();
+    lru.erase(page->second.lru_it);
+    pages.erase(page);
+
+    const auto indexes = file_pages.find(key.path);
+    if (indexes != file_pages.end()) {
+        indexes->second.erase(key.index);
+        if (indexes->second.empty())
+            file_pages.erase(indexes);
+    }
+}
+
+SceOff FileCache::read(const fs::path &path, void *data, SceOff offset, SceSize size, AsyncIoEngine *prefetch_engine) {
+    PageKey key{ path.native(), 0 };
+    uint8_t *const dst = static_cast<uint8_t *>(data);
+
+    SceOff done = 0;
+    while (done < size) {
+        const SceOff position = offset + done;
+        key.index = position / CACHE_PAGE_SIZE;
+        const uint32_t page_offset = position % CACHE_PAGE_SIZE;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        // used when the file changed while the page was loaded, it is not cached then
+        std::vector<uint8_t> loaded_data;
+        const std::vector<uint8_t> *page = nullptr;
+        const auto cached = pages.find(key);
+        if (cached == pages.end()) {
+            const uint64_t load_invalidations = invalidations;
+            lock.unlock();
+            misses++;
+
+            const auto host = get_host_file(key);
+            if (!host || !load_page(*host, key.index, loaded_data))
+                return done > 0 ? done : -1;
+
+            lock.lock();
+            if (invalidations == load_invalidations) {
+                insert_page(key, std::move(loaded_data));
+                page = &pages.find(key)->second.data;
+            } else {
+                page = &loaded_data;
+            }
+        } else {
+            hits++;
+            lru.splice(lru.begin(), lru, cached->second.lru_it);
+            page = &cached->second.data;
+        }
+
+        const std::vector<uint8_t> &page_data = *page;
+        if (page_offset >= page_data.size())
+            break; // end of file
+
+        const size_t count = std::min<size_t>(page_data.size() - page_offset, size - done);
+        memcpy(dst + done, page_data.data() + page_offset, count);
+        done += count;
+
+        if (page_data.size() < CACHE_PAGE_SIZE && page_offset + count == page_data.size())
+            break; // end of file
+    }
+
+    bool sequential;
+    {
+        const std::lock_guard<std::mutex> guard(mutex);
+        const auto file = files.find(key.path);
+        sequential = file != files.end() && file->second.read_end == offset;
+        if (file != files.end())
+            file->second.read_end = offset + done;
+    }
+
+    if (sequential && prefetch_engine && done == size)
+        prefetch(path, offset + done, READ_AHEAD_SIZE, *prefetch_engine);
+
+    return done;
+}
+
+void FileCache::prefetch(const fs::path &path, SceOff offset, SceSize size, AsyncIoEngine &engine) {
+    if (size == 0)
+        return;
+
+    const uint64_t first_page = offset / CACHE_PAGE_SIZE;
+    const uint64_t last_page = (offset + size - 1) / CACHE_PAGE_SIZE;
+    for (uint64_t index = first_page; index <= last_page; index++) {
+        PageKey key{ path.native(), index };
+        uint64_t post_invalidations;
+        {
+            const std::lock_guard<std::mutex> guard(mutex);
+            if (pages.contains(key) || !pending_pages.insert(key).second)
+                continue;
+            post_invalidations = invalidations;
+        }
+
+        engine.post([this, key = std::move(key), post_invalidations]() {
+            const auto host = get_host_file(key);
+            std::vector<uint8_t> data;
+            const bool loaded = host && load_page(*host, key.index, data);
+
+            const std::lock_guard<std::mutex> guard(mutex);
+            // the pending page was dropped if the file changed meanwhile
+            const bool pending = pending_pages.erase(key) > 0;
+            if (pending && post_invalidations == invalidations && loaded && !data.empty()) {
+                insert_page(key, std::move(data));
+                prefetched++;
+            }
+        });
+    }
+}
+
+void FileCache::invalidate(const fs::path &path) {
+    // the cached files are opened with normal paths, a trailing separator is normalized to a trailing dot
+    fs::path normal_path = path.lexically_normal();
+    if (normal_path.filename_is_dot())
+        normal_path.remove_filename();
+    const fs::path::string_type file_path = normal_path.remove_trailing_separator().native();
+    const auto is_invalidated = [&](const fs::path::string_type &cached_path) {
+        if (!cached_path.starts_with(file_path))
+            return false;
+        if (cached_path.size() == file_path.size())
+            return true;
+        const auto next = cached_path[file_path.size()];
+        return next == '/' || next == fs::path::preferred_separator;
+    };
+
+    const std::lock_guard<std::mutex> guard(mutex);
+    bool changed = false;
+
+    std::vector<PageKey> erased;
+    for (const auto &[cached_path, indexes] : file_pages) {
+        if (is_invalidated(cached_path)) {
+            for (const uint64_t index : indexes)
+                erased.push_back({ cached_path, index });
+        }
+    }
+    for (const auto &key : erased)
+        erase_page(key);
+    changed |= !erased.empty();
+
+    changed |= std::erase_if(pending_pages, [&](const PageKey &key) { return is_invalidated(key.path); }) > 0;
+
+    // the host file may have been replaced, it is opened again by the next read
+    for (auto &[cached_path, file] : files) {
+        if (file.host && is_invalidated(cached_path)) {
+            file.host.reset();
+            changed = true;
+        }
+    }
+
+    if (changed)
+        invalidations++;
+}
@@ -116,6 +116,9 @@ bool init(IOState &io, const fs::path &cache_path, const fs::path &log_path, con
     fs::create_directory(log_path / "texturelog");
 
     io.redirect_stdio = redirect_stdio;
+    io.async_engine = std::make_unique<AsyncIoEngine>();
+    io.file_cache = std::make_unique<FileCache>();
+    io.path_index_path = cache_path / "path_index";
 
 #ifndef _WIN32
     io.case_isens_find_enabled = true;
@@ -187,6 +190,78 @@ fs::path find_in_cache(IOState &io, const std::string &system_path) {
     }
 }
 
+static PathIndexSlot *get_path_index_slot(IOState &io, const VitaIoDevice device) {
+    switch (device) {
+    case +VitaIoDevice::app0: return io.app_path.empty() ? nullptr : &io.app0_index;
+    case +VitaIoDevice::addcont0: return io.addcont.empty() ? nullptr : &io.addcont0_index;
+    default: return nullptr;
+    }
+}
+
+static fs::path get_path_index_file(const IOState &io, const VitaIoDevice device) {
+    const std::string &name = (device == VitaIoDevice::app0) ? io.app_path : io.addcont;
+    return io.path_index_path / fmt::format("{}_{}.bin", device._to_string(), name);
+}
+
+// Returns the index of app0 or addcont0, loaded on first use, or nullptr for the other devices
+static std::shared_ptr<const PathIndex> get_path_index(IOState &io, const VitaIoDevice device, const fs::path &pref_path) {
+    PathIndexSlot *const slot = get_path_index_slot(io, device);
+    if (!slot)
+        return nullptr;
+
+    const std::lock_guard<std::mutex> guard(io.path_index_mutex);
+    if (slot->disabled)
+        return nullptr;
+
+    if (!slot->index) {
+        const std::string &relative_root = (device == VitaIoDevice::app0) ? io.device_paths.app0 : io.device_paths.addcont0;
+        const fs::path root = device::construct_emulated_path(VitaIoDevice::ux0, relative_root, pref_path, io.redirect_stdio);
+        slot->index = std::make_shared<const PathIndex>(root, get_path_index_file(io, device));
+    }
+
+    return slot->index;
+}
+
+// The app is modifying the tree of the device, stop using its index until the next boot
+static void invalidate_path_index(IOState &io, const VitaIoDevice device) {
+    PathIndexSlot *const slot = get_path_index_slot(io, device);
+    if (!slot)
+        return;
+
+    const std::lock_guard<std::mutex> guard(io.path_index_mutex);
+    if (slot->disabled)
+        return;
+
+    slot->disabled = true;
+    slot->index.reset();
+    boost::system::error_code error_code{};
+    fs::remove(get_path_index_file(io, device), error_code);
+}
+
+// app0 and addcont0 are also reachable through ux0:app and ux0:addcont, check the path once translated
+static void invalidate_path_indexes(IOState &io, const VitaIoDevice device, const std::string &translated_path) {
+    if (device != VitaIoDevice::ux0)
+        return;
+
+    const std::string path = string_utils::tolower(translated_path) + '/';
+    for (const VitaIoDevice indexed_device : { VitaIoDevice::app0, VitaIoDevice::addcont0 }) {
+        const std::string &root = (indexed_device == VitaIoDevice::app0) ? io.device_paths.app0 : io.device_paths.addcont0;
+        const std::string root_prefix = string_utils::tolower(root) + '/';
+        // the parents of the root count too, removing or renaming them changes the tree
+        if (path.starts_with(root_prefix) || root_prefix.starts_with(path))
+            invalidate_path_index(io, indexed_device);
+    }
+}
+
+static bool is_path_index_case_sensitive(const IOState &io) {
+#ifdef _WIN32
+    // the host filesystem is not case sensitive either
+    return false;
+#else
+    return !io.case_isens_find_enabled;
+#endif
+}
+
 std::string translate_path(const char *path, VitaIoDevice &device, const IOState::DevicePaths &device_paths) {
     auto relative_path = device::remove_duplicate_device(path, device);
 
@@ -307,14 +382,28 @@ SceUID open_file(IOState &io, const char *path, const int flags, const fs::path
         return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
     }
 
+    if (can_write(flags))
+        invalidate_path_indexes(io, device, translated_path);
+
     auto system_path = device::construct_emulated_path(device, translated_path, pref_path, io.redirect_stdio);
-    if (fs::is_directory(system_path)) {
+    const auto path_index = get_path_index(io, device_for_icase, pref_path);
+    bool indexed_missing = false;
+    const PathIndex::Entry *indexed_entry = path_index ? path_index->find(system_path, is_path_index_case_sensitive(io), &indexed_missing) : nullptr;
+    if (indexed_entry) {
+        if (indexed_entry->is_directory) {
+            LOG_ERROR("Cannot open directory: {}", system_path);
+            return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
+        }
+        system_path = path_index->get_host_path(*indexed_entry);
+    } else if (indexed_missing && !(flags & SCE_O_CREAT)) {
+        // the directories of the index are checked when it is loaded, the tree is not walked again
+        LOG_ERROR("Missing file at {} (target path: {})", system_path, path);
+        return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
+    } else if (fs::is_directory(system_path)) {
         LOG_ERROR("Cannot open directory: {}", system_path);
         return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
-    }
-
-    // Do not allow any new files if they do not have a write flag.
-    if (!fs::exists(system_path)) {
+    } else if (!fs::exists(system_path)) {
+        // Do not allow any new files if they do not have a write flag.
         if (!(flags & SCE_O_CREAT)) {
             if (io.case_isens_find_enabled) {
                 // Attempt a case-insensitive file search.
@@ -347,7 +436,17 @@ SceUID open_file(IOState &io, const char *path, const int flags, const fs::path
 
     const auto normalized_path = device::construct_normalized_path(device, translated_path);
 
+    const bool cached = (device_for_icase == VitaIoDevice::app0 || device_for_icase == VitaIoDevice::addcont0) && !can_write(flags);
+    // the file cache is invalidated with normal paths
+    if (cached)
+        system_path = system_path.lexically_normal();
+
     FileStats f{ path, normalized_path, system_path, flags };
+    f.set_cached(cached);
+    if (f.is_cached())
+        io.file_cache->open(system_path);
+    else if (can_write(flags))
+        io.file_cache->invalidate(system_path);
     const auto fd = io.next_fd++;
     io.std_files.emplace(fd, f);
 
@@ -355,13 +454,25 @@ SceUID open_file(IOState &io, const char *path, const int flags, const fs::path
     return fd;
 }
 
+// Read at the current position of the file through the file cache, and move the position past the data
+static SceOff read_cached_file(IOState &io, const FileStats &file, void *data, const SceSize size) {
+    const SceOff position = file.tell();
+    if (position < 0)
+        return -1;
+
+    const SceOff read = io.file_cache->read(file.get_system_location(), data, position, size, io.async_engine.get());
+    if (read > 0)
+        file.seek(position + read, SCE_SEEK_SET);
+    return read;
+}
+
 int read_file(void *data, IOState &io, const SceUID fd, const SceSize size, const char *export_name) {
     assert(data != nullptr);
     assert(size >= 0);
 
     const auto file = io.std_files.find(fd);
     if (file != io.std_files.end()) {
-        const auto read = file->second.read(data, 1, size);
+        const auto read = file->second.is_cached() ? read_cached_file(io, file->second, data, size) : file->second.read(data, 1, size);
         LOG_TRACE_IF(log_file_op && log_file_read, "{}: Reading {} bytes of fd {}", export_name, read, log_hex(fd));
         return static_cast<int>(read);
     }
@@ -417,6 +528,7 @@ int write_file(SceUID fd, const void *data, const SceSize size, const IOState &i
 
     if (file->second.can_write_file()) {
         const auto written = file->second.write(data, 1, size);
+        io.file_cache->invalidate(file->second.get_system_location());
         LOG_TRACE_IF(log_file_op, "{}: Writing to fd: {}, size: {}", export_name, log_hex(fd), size);
         return static_cast<int>(written);
     }
@@ -432,6 +544,7 @@ int truncate_file(const SceUID fd, unsigned long long length, const IOState &io,
     if (file == io.std_files.end())
         return IO_ERROR(SCE_ERROR_ERRNO_EBADFD);
     auto trunc = file->second.truncate(length);
+    io.file_cache->invalidate(file->second.get_system_location());
     LOG_TRACE_IF(log_file_op, "{}: Truncating fd: {}, to size: {}", export_name, log_hex(fd), length);
     return trunc;
 }
@@ -482,6 +595,9 @@ int stat_file(IOState &io, const char *file, SceIoStat *statp, const fs::path &p
     memset(statp, '\0', sizeof(SceIoStat));
 
     fs::path file_path = "";
+    // set for the directories of app0 and addcont0, the host filesystem is not accessed then
+    std::shared_ptr<const PathIndex> path_index;
+    const PathIndex::Entry *indexed_entry = nullptr;
     if (fd == invalid_fd) {
         auto device = device::get_device(file);
         auto device_for_icase = device;
@@ -493,7 +609,20 @@ int stat_file(IOState &io, const char *file, SceIoStat *statp, const fs::path &p
         const auto translated_path = translate_path(file, device, io.device_paths);
         file_path = device::construct_emulated_path(device, translated_path, pref_path, io.redirect_stdio);
 
-        if (!fs::exists(file_path)) {
+        path_index = get_path_index(io, device_for_icase, pref_path);
+        bool indexed_missing = false;
+        if (path_index)
+            indexed_entry = path_index->find(file_path, is_path_index_case_sensitive(io), &indexed_missing);
+
+        if (indexed_entry) {
+            file_path = path_index->get_host_path(*indexed_entry);
+            // a file can be rewritten in place without its directory changing, only the directories of the index are up to date
+            if (!indexed_entry->is_directory)
+                indexed_entry = nullptr;
+        } else if (indexed_missing) {
+            LOG_ERROR("Missing file at {} (target path: {})", file_path, file);
+            return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
+        } else if (!fs::exists(file_path)) {
             if (io.case_isens_find_enabled) {
                 // Attempt a case-insensitive file search.
                 const auto original_file_path = file_path;
@@ -532,19 +661,25 @@ int stat_file(IOState &io, const char *file, SceIoStat *statp, const fs::path &p
     std::uint64_t creation_time_ticks;
     std::uint64_t last_modification_time_ticks;
 
+    if (indexed_entry) {
+        last_access_time_ticks = (uint64_t)indexed_entry->atime * VITA_CLOCKS_PER_SEC;
+        creation_time_ticks = (uint64_t)indexed_entry->ctime * VITA_CLOCKS_PER_SEC;
+        last_modification_time_ticks = (uint64_t)indexed_entry->mtime * VITA_CLOCKS_PER_SEC;
+    } else {
 #ifdef _WIN32
-    struct _stati64 sb;
-    if (_wstati64(file_path.generic_path().wstring().c_str(), &sb) < 0)
-        return IO_ERROR_UNK();
+        struct _stati64 sb;
+        if (_wstati64(file_path.generic_path().wstring().c_str(), &sb) < 0)
+            return IO_ERROR_UNK();
 #else
-    struct stat64 sb;
-    if (stat64(file_path.generic_path().string().c_str(), &sb) < 0)
-        return IO_ERROR_UNK();
+        struct stat64 sb;
+        if (stat64(file_path.generic_path().string().c_str(), &sb) < 0)
+            return IO_ERROR_UNK();
 #endif
 
-    last_access_time_ticks = (uint64_t)sb.st_atime * VITA_CLOCKS_PER_SEC;
-    creation_time_ticks = (uint64_t)sb.st_ctime * VITA_CLOCKS_PER_SEC;
-    last_modification_time_ticks = (uint64_t)sb.st_mtime * VITA_CLOCKS_PER_SEC;
+        last_access_time_ticks = (uint64_t)sb.st_atime * VITA_CLOCKS_PER_SEC;
+        creation_time_ticks = (uint64_t)sb.st_ctime * VITA_CLOCKS_PER_SEC;
+        last_modification_time_ticks = (uint64_t)sb.st_mtime * VITA_CLOCKS_PER_SEC;
+    }
 
 #ifndef _WIN32
 #undef st_atime
@@ -554,12 +689,12 @@ int stat_file(IOState &io, const char *file, SceIoStat *statp, const fs::path &p
 
     statp->st_mode = SCE_S_IRUSR | SCE_S_IRGRP | SCE_S_IROTH | SCE_S_IXUSR | SCE_S_IXGRP | SCE_S_IXOTH;
 
-    if (fs::is_regular_file(file_path)) {
-        statp->st_size = fs::file_size(file_path);
+    if (indexed_entry ? !indexed_entry->is_directory : fs::is_regular_file(file_path)) {
+        statp->st_size = indexed_entry ? indexed_entry->size : fs::file_size(file_path);
         statp->st_attr = SCE_SO_IFREG;
         statp->st_mode |= SCE_S_IFREG;
     }
-    if (fs::is_directory(file_path)) {
+    if (indexed_entry ? indexed_entry->is_directory : fs::is_directory(file_path)) {
         statp->st_attr = SCE_SO_IFDIR;
         statp->st_mode |= SCE_S_IFDIR;
     }
@@ -589,12 +724,124 @@ int close_file(IOState &io, const SceUID fd, const char *export_name) {
 
     LOG_TRACE_IF(log_file_op, "{}: Closing file fd: {}", export_name, log_hex(fd));
 
+    if (io.async_engine)
+        io.async_engine->wait_fd(fd);
     io.tty_files.erase(fd);
-    io.std_files.erase(fd);
+    const auto file = io.std_files.find(fd);
+    if (file != io.std_files.end()) {
+        if (file->second.is_cached())
+            io.file_cache->close(file->second.get_system_location());
+        io.std_files.erase(file);
+    }
 
     return 0;
 }
 
+// ***************************
+// * Asynchronous operations *
+// ***************************
+
+static AsyncIoEngine::CompletionCallback write_async_result(SceIoAsyncParam *param) {
+    return [param](const SceOff result) {
+        if (param) {
+            param->result = static_cast<SceInt32>(result);
+            param->result_high = static_cast<SceInt32>(result >> 32);
+        }
+    };
+}
+
+// Used for operations done right away, only their completion goes through the async IO workers
+static SceUID submit_async_result(IOState &io, const SceOff result, SceIoAsyncParam *param) {
+    return io.async_engine->submit(invalid_fd, [result]() { return result; }, write_async_result(param));
+}
+
+SceUID open_file_async(IOState &io, const char *path, const int flags, const fs::path &pref_path, SceIoAsyncParam *param, const char *export_name) {
+    // The file tables are only modified from the guest threads, opening a file only costs a path lookup anyway
+    return submit_async_result(io, open_file(io, path, flags, pref_path, export_name), param);
+}
+
+SceUID close_file_async(IOState &io, const SceUID fd, SceIoAsyncParam *param, const char *export_name) {
+    return submit_async_result(io, close_file(io, fd, export_name), param);
+}
+
+SceUID read_file_async(void *data, IOState &io, const SceUID fd, const SceSize size, const std::optional<SceOff> offset, SceIoAsyncParam *param, const char *export_name) {
+    assert(data != nullptr);
+
+    const auto file = io.std_files.find(fd);
+    if (file == io.std_files.end())
+        return submit_async_result(io, read_file(data, io, fd, size, export_name), param);
+
+    // The worker gets a copy of the file stats, which shares the host file
+    const FileStats stats = file->second;
+    if (stats.is_cached()) {
+        return io.async_engine->submit(
+            fd, [&io, stats, data, size, offset]() -> SceOff {
+                if (offset)
+                    return io.file_cache->read(stats.get_system_location(), data, *offset, size, io.async_engine.get());
+                return read_cached_file(io, stats, data, size);
+            },
+            write_async_result(param));
+    }
+
+    return io.async_engine->submit(
+        fd, [stats, data, size, offset, fd, export_name]() -> SceOff {
+            const SceOff read = offset ? stats.read_at(data, size, *offset) : stats.read(data, 1, size);
+
+            LOG_TRACE_IF(log_file_op && log_file_read, "{}: Reading {} bytes of fd {}", export_name, read, log_hex(fd));
+            return read;
+        },
+        write_async_result(param));
+}
+
+SceUID write_file_async(const void *data, IOState &io, const SceUID fd, const SceSize size, const std::optional<SceOff> offset, SceIoAsyncParam *param, const char *export_name) {
+    assert(data != nullptr);
+
+    const auto file = io.std_files.find(fd);
+    if (file == io.std_files.end())
+        return submit_async_result(io, write_file(fd, data, size, io, export_name), param);
+    if (!file->second.can_write_file())
+        return submit_async_result(io, IO_ERROR(SCE_ERROR_ERRNO_EBADFD), param);
+
+    const FileStats stats = file->second;
+    return io.async_engine->submit(
+        fd, [stats, file_cache = io.file_cache.get(), data, size, offset, fd, export_name]() -> SceOff {
+            const SceOff written = offset ? stats.write_at(data, size, *offset) : stats.write(data, 1, size);
+            file_cache->invalidate(stats.get_system_location());
+
+            LOG_TRACE_IF(log_file_op, "{}: Writing to fd: {}, size: {}", export_name, log_hex(fd), size);
+            return written;
+        },
+        write_async_result(param));
+}
+
+SceUID seek_file_async(IOState &io, const SceUID fd, const SceOff offset, const SceIoSeekMode whence, SceIoAsyncParam *param, const char *export_name) {
+    if (!(whence == SCE_SEEK_SET || whence == SCE_SEEK_CUR || whence == SCE_SEEK_END))
+        return submit_async_result(io, IO_ERROR(SCE_ERROR_ERRNO_EOPNOTSUPP), param);
+
+    const auto file = io.std_files.find(fd);
+    if (file == io.std_files.end())
+        return submit_async_result(io, IO_ERROR(SCE_ERROR_ERRNO_EBADFD), param);
+
+    const FileStats stats = file->second;
+    return io.async_engine->submit(
+        fd, [stats, offset, whence, export_name]() -> SceOff {
+            if (!stats.seek(offset, whence))
+                return io_error_impl(SCE_ERROR_ERRNO_EBADFD, export_name, "seek_file_async");
+            return stats.tell();
+        },
+        write_async_result(param));
+}
+
+int complete_async(IOState &io, const SceUID id, SceOff *result, const char *export_name) {
+    const std::optional<SceOff> res = io.async_engine->wait(id);
+    if (!res)
+        return IO_ERROR(SCE_ERROR_ERRNO_EBADFD);
+
+    if (result)
+        *result = *res;
+    return 0;
+}
+
 int remove_file(IOState &io, const char *file, const fs::path &pref_path, const char *export_name) {
     auto device = device::get_device(file);
     if (device == VitaIoDevice::_INVALID) {
@@ -608,6 +855,8 @@ int remove_file(IOState &io, const char *file, const fs::path &pref_path, const
         return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
     }
 
+    invalidate_path_indexes(io, device, translated_path);
+
     const auto emulated_path = device::construct_emulated_path(device, translated_path, pref_path, io.redirect_stdio);
     if (!fs::exists(emulated_path) || fs::is_directory(emulated_path)) {
         LOG_ERROR("File does not exist at path: {} (target path: {})", emulated_path, file);
@@ -617,6 +866,7 @@ int remove_file(IOState &io, const char *file, const fs::path &pref_path, const
 
     boost::system::error_code error_code{};
     auto res = fs::detail::remove(emulated_path, &error_code);
+    io.file_cache->invalidate(emulated_path);
 
     if (!(res && !(error_code.value()))) {
         LOG_ERROR("Cannot remove file: {} ({})", file, device::construct_normalized_path(device, translated_path));
@@ -646,6 +896,9 @@ int rename(IOState &io, const char *old_name, const char *new_name, const fs::pa
         return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
     }
 
+    invalidate_path_indexes(io, device, translated_old_path);
+    invalidate_path_indexes(io, device, translated_new_path);
+
     const auto emulated_old_path = device::construct_emulated_path(device, translated_old_path, pref_path, io.redirect_stdio);
     if (!fs::exists(emulated_old_path)) {
         LOG_ERROR("File does not exist at path: {} (target path: {})", emulated_old_path, old_name);
@@ -658,6 +911,8 @@ int rename(IOState &io, const char *old_name, const char *new_name, const fs::pa
 
     boost::system::error_code error_code{};
     fs::rename(emulated_old_path, emulated_new_path, error_code);
+    io.file_cache->invalidate(emulated_old_path);
+    io.file_cache->invalidate(emulated_new_path);
 
     if (error_code.value()) {
         LOG_ERROR("Cannot rename file: {} to {} ({} to {})", old_name, new_name, emulated_old_path, emulated_new_path);
@@ -674,7 +929,16 @@ SceUID open_dir(IOState &io, const char *path, const fs::path &pref_path, const
     const auto translated_path = translate_path(path, device, io.device_paths);
 
     auto dir_path = device::construct_emulated_path(device, translated_path, pref_path, io.redirect_stdio) / "";
-    if (!fs::exists(dir_path)) {
+    const auto path_index = get_path_index(io, device_for_icase, pref_path);
+    bool indexed_missing = false;
+    const PathIndex::Entry *indexed_entry = path_index ? path_index->find(dir_path, is_path_index_case_sensitive(io), &indexed_missing) : nullptr;
+    if (indexed_missing || (indexed_entry && !indexed_entry->is_directory)) {
+        LOG_ERROR("Directory does not exist at: {} (target path: {})", dir_path, path);
+        return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
+    }
+    if (indexed_entry) {
+        dir_path = path_index->get_host_path(*indexed_entry) / "";
+    } else if (!fs::exists(dir_path)) {
         if (io.case_isens_find_enabled) {
             // Attempt a case-insensitive file search.
             const auto original_dir_path = dir_path;
@@ -794,6 +1058,8 @@ int create_dir(IOState &io, const char *dir, int mode, const fs::path &pref_path
         return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
     }
 
+    invalidate_path_indexes(io, device, translated_path);
+
     const auto emulated_path = device::construct_emulated_path(device, translated_path, pref_path, io.redirect_stdio);
     if (recursive)
         return fs::create_directories(emulated_path);
@@ -841,9 +1107,14 @@ int remove_dir(IOState &io, const char *dir, const fs::path &pref_path, const ch
         return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
     }
 
+    invalidate_path_indexes(io, device, translated_path);
+
     LOG_TRACE_IF(log_file_op, "{}: Removing dir {} ({})", export_name, dir, device::construct_normalized_path(device, translated_path));
 
-    if (!fs::remove_all(device::construct_emulated_path(device, translated_path, pref_path, io.redirect_stdio))) {
+    const auto emulated_path = device::construct_emulated_path(device, translated_path, pref_path, io.redirect_stdio);
+    const bool removed = fs::remove_all(emulated_path);
+    io.file_cache->invalidate(emulated_path);
+    if (!removed) {
         LOG_ERROR("Cannot remove dir: {} ({})", dir, device::construct_normalized_path(device, translated_path));
         return IO_ERROR(SCE_ERROR_ERRNO_ENOENT);
     }
@@ -0,0 +1,237 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <io/path_index.h>
+
+#include <util/log.h>
+#include <util/string_utils.h>
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <vector>
+
+#if defined(__aarch64__) && defined(__APPLE__)
+#define stat64 stat
+#endif
+
+static constexpr char INDEX_MAGIC[8] = { 'V', '3', 'K', 'P', 'I', 'D', 'X', '\0' };
+static constexpr uint32_t INDEX_VERSION = 3;
+// symbolic links to directories are followed, this stops loops between them
+static constexpr int MAX_INDEX_DEPTH = 32;
+
+static bool stat_host_path(const fs::path &path, PathIndex::Entry &entry) {
+#ifdef _WIN32
+    struct _stati64 sb;
+    if (_wstati64(path.generic_path().wstring().c_str(), &sb) < 0)
+        return false;
+    entry.is_directory = (sb.st_mode & _S_IFMT) == _S_IFDIR;
+#else
+    struct stat64 sb;
+    if (stat64(path.generic_path().string().c_str(), &sb) < 0)
+        return false;
+    entry.is_directory = S_ISDIR(sb.st_mode);
+#endif
+    entry.size = entry.is_directory ? 0 : sb.st_size;
+    entry.atime = sb.st_atime;
+    entry.mtime = sb.st_mtime;
+    entry.ctime = sb.st_ctime;
+    return true;
+}
+
+static int64_t get_host_mtime(const fs::path &path) {
+    PathIndex::Entry entry;
+    return stat_host_path(path, entry) ? entry.mtime : 0;
+}
+
+template <typename T>
+static void write_value(std::vector<uint8_t> &data, const T &value) {
+    const auto bytes = reinterpret_cast<const uint8_t *>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static bool read_value(const std::vector<uint8_t> &data, size_t &offset, T &value) {
+    if (data.size() - offset < sizeof(T))
+        return false;
+    memcpy(&value, &data[offset], sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+PathIndex::PathIndex(const fs::path &root, const fs::path &index_path)
+    : root(root)
+    , index_path(index_path) {
+    std::string root_string = fs_utils::path_to_utf8(root.generic_path());
+    if (!root_string.ends_with('/'))
+        root_string += '/';
+    root_prefix = string_utils::tolower(root_string);
+
+    // the param.sfo is rewritten by every install of the app, even when the root itself does not change
+    root_mtime = get_host_mtime(root);
+    sfo_mtime = get_host_mtime(root / "sce_sys/param.sfo");
+
+    if (!load()) {
+        build();
+        save();
+    }
+}
+
+const PathIndex::Entry *PathIndex::find(const fs::path &path, const bool case_sensitive, bool *missing) const {
+    if (missing)
+        *missing = false;
+
+    // the index only has normal paths, without . or .. components nor repeated separators
+    std::string path_string = fs_utils::path_to_utf8(path.lexically_normal().generic_path());
+    // a trailing separator is normalized to a trailing dot
+    if (path_string.ends_with("/."))
+        path_string.pop_back();
+    if (!path_string.ends_with('/'))
+        path_string += '/';
+    if (path_string.size() < root_prefix.size() || string_utils::tolower(path_string.substr(0, root_prefix.size())) != root_prefix)
+        return nullptr;
+
+    const std::string relative_path = path_string.substr(root_prefix.size(), path_string.size() - root_prefix.size() - 1);
+    const auto entry = entries.find(string_utils::tolower(relative_path));
+    if (entry == entries.end()) {
+        if (missing)
+            *missing = true;
+        return nullptr;
+    }
+    if (entry->second.relative_path != relative_path) {
+        // when several host paths only differ in case, the index only knows one of them
+        if (entry->second.case_collision)
+            return nullptr;
+        if (case_sensitive) {
+            if (missing)
+                *missing = true;
+            return nullptr;
+        }
+    }
+
+    return &entry->second;
+}
+
+fs::path PathIndex::get_host_path(const Entry &entry) const {
+    if (entry.relative_path.empty())
+        return root;
+
+    return root / fs_utils::utf8_to_path(entry.relative_path);
+}
+
+bool PathIndex::load() {
+    std::vector<uint8_t> data;
+    if (!fs_utils::read_data(index_path, data))
+        return false;
+
+    size_t offset = 0;
+    char magic[sizeof(INDEX_MAGIC)];
+    uint32_t version;
+    int64_t saved_root_mtime, saved_sfo_mtime;
+    uint32_t count;
+    if (!read_value(data, offset, magic) || memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0
+        || !read_value(data, offset, version) || version != INDEX_VERSION
+        || !read_value(data, offset, saved_root_mtime) || saved_root_mtime != root_mtime
+        || !read_value(data, offset, saved_sfo_mtime) || saved_sfo_mtime != sfo_mtime
+        || !read_value(data, offset, count))
+        return false;
+
+    entries.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        Entry entry;
+        uint32_t path_size;
+        uint8_t is_directory, case_collision;
+        if (!read_value(data, offset, path_size) || data.size() - offset < path_size)
+            return false;
+        entry.relative_path.assign(reinterpret_cast<const char *>(&data[offset]), path_size);
+        offset += path_size;
+
+        if (!read_value(data, offset, entry.size) || !read_value(data, offset, entry.atime)
+            || !read_value(data, offset, entry.mtime) || !read_value(data, offset, entry.ctime)
+            || !read_value(data, offset, is_directory) || !read_value(data, offset, case_collision))
+            return false;
+        entry.is_directory = is_directory != 0;
+        entry.case_collision = case_collision != 0;
+
+        entries.emplace(string_utils::tolower(entry.relative_path), std::move(entry));
+    }
+
+    // files are only added, removed or renamed by changing the directory holding them
+    for (const auto &[key, entry] : entries) {
+        if (entry.is_directory && get_host_mtime(get_host_path(entry)) != entry.mtime) {
+            LOG_INFO("Directory {} of {} changed, indexing it again", entry.relative_path, root);
+            entries.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void PathIndex::build() {
+    entries.clear();
+
+    Entry root_entry;
+    if (!stat_host_path(root, root_entry) || !root_entry.is_directory)
+        return;
+    entries.emplace("", root_entry);
+
+    const size_t root_size = root_prefix.size();
+    boost::system::error_code error_code{};
+    for (fs::recursive_directory_iterator it(root, fs::directory_options::follow_directory_symlink, error_code), end; !error_code && it != end; it.increment(error_code)) {
+        if (it.depth() >= MAX_INDEX_DEPTH)
+            it.disable_recursion_pending();
+
+        Entry entry;
+        if (!stat_host_path(it->path(), entry))
+            continue;
+
+        entry.relative_path = fs_utils::path_to_utf8(it->path().generic_path()).substr(root_size);
+        const auto [indexed, inserted] = entries.emplace(string_utils::tolower(entry.relative_path), std::move(entry));
+        if (!inserted)
+            indexed->second.case_collision = true;
+    }
+
+    LOG_INFO("Indexed {} paths of {}", entries.size(), root);
+}
+
+void PathIndex::save() const {
+    // nothing worth saving when the tree does not exist
+    if (entries.empty())
+        return;
+
+    std::vector<uint8_t> data;
+    data.insert(data.end(), std::begin(INDEX_MAGIC), std::end(INDEX_MAGIC));
+    write_value(data, INDEX_VERSION);
+    write_value(data, root_mtime);
+    write_value(data, sfo_mtime);
+    write_value(data, static_cast<uint32_t>(entries.size()));
+    for (const auto &[key, entry] : entries) {
+        write_value(data, static_cast<uint32_t>(entry.relative_path.size()));
+        data.insert(data.end(), entry.relative_path.begin(), entry.relative_path.end());
+        write_value(data, entry.size);
+        write_value(data, entry.atime);
+        write_value(data, entry.mtime);
+        write_value(data, entry.ctime);
+        write_value(data, static_cast<uint8_t>(entry.is_directory));
+        write_value(data, static_cast<uint8_t>(entry.case_collision));
+    }
+
+    boost::system::error_code error_code{};
+    fs::create_directories(index_path.parent_path(), error_code);
+    fs_utils::dump_data(index_path, data.data(), data.size());
+}
@@ -16,6 +16,7 @@
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
 #ifdef _WIN32
+#include <Windows.h>
 #include <io.h>
 #else
 #define _FILE_OFFSET_BITS 64
@@ -40,6 +41,57 @@ SceOff FileStats::write(const void *data, const SceSize size, const int count) c
     return fwrite(data, size, count, get_file_pointer());
 }
 
+// The positioned read and write leave the position of the shared file alone, so they can run at the same time as the
+// other operations on it. Data written through the shared file may still be in its buffer, flush it before.
+#ifdef _WIN32
+// Windows moves the file pointer of a synchronous handle even when an offset is given, use another handle for the file
+static SceOff access_file_at(const fs::path &path, const bool write, void *data, const SceSize size, const SceOff offset) {
+    const HANDLE handle = CreateFileW(path.generic_path().wstring().c_str(), write ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return -1;
+
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD transferred = 0;
+    const BOOL ret = write ? WriteFile(handle, data, size, &transferred, &overlapped) : ReadFile(handle, data, size, &transferred, &overlapped);
+    CloseHandle(handle);
+
+    // reading past the end of the file is not an error
+    if (!ret && GetLastError() != ERROR_HANDLE_EOF)
+        return -1;
+    return transferred;
+}
+#endif
+
+SceOff FileStats::read_at(void *data, const SceSize size, const SceOff offset) const {
+    if (!wrapped_file)
+        return -1;
+
+    if (can_write_file())
+        fflush(wrapped_file.get());
+
+#ifdef _WIN32
+    return access_file_at(get_system_location(), false, data, size, offset);
+#else
+    return pread(fileno(wrapped_file.get()), data, size, offset);
+#endif
+}
+
+SceOff FileStats::write_at(const void *data, const SceSize size, const SceOff offset) const {
+    if (!can_write_file())
+        return -1;
+
+    fflush(wrapped_file.get());
+
+#ifdef _WIN32
+    return access_file_at(get_system_location(), true, const_cast<void *>(data), size, offset);
+#else
+    return pwrite(fileno(wrapped_file.get()), data, size, offset);
+#endif
+}
+
 int FileStats::truncate(const SceSize size) const {
 #ifdef _WIN32
     return _chsize_s(_fileno(get_file_pointer()), size);
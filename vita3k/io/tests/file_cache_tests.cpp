@@ -0,0 +1,95 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <io/file_cache.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+class file_cache : public testing::Test {
+protected:
+    void SetUp() override {
+        base = fs::temp_directory_path() / fs::unique_path("vita3k-file-cache-%%%%-%%%%");
+        fs::create_directories(base / "Data");
+        path = base / "Data/level.dat";
+        write_file(path, "old level");
+        cache.open(path);
+    }
+
+    void TearDown() override {
+        cache.close(path);
+        fs::remove_all(base);
+    }
+
+    static void write_file(const fs::path &path, const std::string &content) {
+        std::ofstream file(path.string(), std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    std::string read() {
+        char data[64];
+        const SceOff read = cache.read(path, data, 0, sizeof(data), nullptr);
+        return read < 0 ? "" : std::string(data, read);
+    }
+
+    FileCache cache;
+    fs::path base;
+    fs::path path;
+};
+
+TEST_F(file_cache, read_write_read) {
+    EXPECT_EQ(read(), "old level");
+    EXPECT_EQ(cache.get_misses(), 1);
+
+    // the page is served from the cache until the file is invalidated
+    write_file(path, "new level!");
+    EXPECT_EQ(read(), "old level");
+    EXPECT_EQ(cache.get_hits(), 1);
+
+    cache.invalidate(path);
+    EXPECT_EQ(read(), "new level!");
+    EXPECT_EQ(cache.get_misses(), 2);
+}
+
+TEST_F(file_cache, replaced_file) {
+    EXPECT_EQ(read(), "old level");
+
+    // the host file kept open must not be read again after the file is replaced
+    fs::remove(path);
+    write_file(path, "replaced");
+    cache.invalidate(path);
+    EXPECT_EQ(read(), "replaced");
+}
+
+TEST_F(file_cache, invalidate_directory) {
+    EXPECT_EQ(read(), "old level");
+
+    write_file(path, "new level!");
+    cache.invalidate(base / "Data/");
+    EXPECT_EQ(read(), "new level!");
+}
+
+TEST_F(file_cache, invalidate_other_file) {
+    EXPECT_EQ(read(), "old level");
+
+    // a file whose name starts with the same characters is not under it
+    write_file(path, "new level!");
+    cache.invalidate(base / "Data/level");
+    cache.invalidate(base / "Dat");
+    EXPECT_EQ(read(), "old level");
+}
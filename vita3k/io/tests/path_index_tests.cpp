@@ -0,0 +1,214 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <io/path_index.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+class path_index : public testing::Test {
+protected:
+    void SetUp() override {
+        base = fs::temp_directory_path() / fs::unique_path("vita3k-path-index-%%%%-%%%%");
+        root = base / "app0";
+        index_path = base / "index" / "app0.idx";
+        fs::create_directories(root / "Data/Sub");
+        write_file(root / "eboot.bin", "eboot");
+        write_file(root / "Data/Sub/Level1.dat", "level");
+    }
+
+    void TearDown() override {
+        fs::remove_all(base);
+    }
+
+    static void write_file(const fs::path &path, const std::string &content) {
+        std::ofstream file(path.string(), std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    // the index compares mtimes in seconds, move the directory forward instead of waiting for the clock
+    static void touch_directory(const fs::path &path) {
+        fs::last_write_time(path, fs::last_write_time(path) + 10);
+    }
+
+    fs::path base;
+    fs::path root;
+    fs::path index_path;
+};
+
+TEST_F(path_index, build) {
+    const PathIndex index(root, index_path);
+
+    const auto root_entry = index.find(root, true);
+    ASSERT_NE(root_entry, nullptr);
+    EXPECT_TRUE(root_entry->is_directory);
+    EXPECT_EQ(index.get_host_path(*root_entry), root);
+
+    const auto dir = index.find(root / "Data/Sub", true);
+    ASSERT_NE(dir, nullptr);
+    EXPECT_TRUE(dir->is_directory);
+
+    const auto file = index.find(root / "Data/Sub/Level1.dat", true);
+    ASSERT_NE(file, nullptr);
+    EXPECT_FALSE(file->is_directory);
+    EXPECT_EQ(file->size, 5);
+    EXPECT_EQ(index.get_host_path(*file), root / "Data/Sub/Level1.dat");
+}
+
+TEST_F(path_index, case_insensitive_find) {
+    const PathIndex index(root, index_path);
+
+    const auto file = index.find(root / "data/sub/LEVEL1.DAT", false);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->relative_path, "Data/Sub/Level1.dat");
+    EXPECT_EQ(index.get_host_path(*file), root / "Data/Sub/Level1.dat");
+
+    EXPECT_EQ(index.find(root / "data/sub/LEVEL1.DAT", true), nullptr);
+}
+
+TEST_F(path_index, miss) {
+    const PathIndex index(root, index_path);
+
+    EXPECT_EQ(index.find(root / "Data/Missing.dat", false), nullptr);
+    EXPECT_EQ(index.find(root / "Data/Sub/Level1.dat/child", false), nullptr);
+    EXPECT_EQ(index.find(base / "outside.dat", false), nullptr);
+}
+
+TEST_F(path_index, missing_path) {
+    const PathIndex index(root, index_path);
+
+    // a path under the root the index does not know does not exist, the host is not looked up
+    bool missing = false;
+    EXPECT_EQ(index.find(root / "Data/Missing.dat", false, &missing), nullptr);
+    EXPECT_TRUE(missing);
+    EXPECT_EQ(index.find(root / "data/sub/../Missing/", false, &missing), nullptr);
+    EXPECT_TRUE(missing);
+
+    // the case only differs, it does not exist on a case sensitive host
+    EXPECT_EQ(index.find(root / "data/sub/LEVEL1.DAT", true, &missing), nullptr);
+    EXPECT_TRUE(missing);
+
+    // the index can not tell for paths outside of the root
+    EXPECT_EQ(index.find(base / "outside.dat", false, &missing), nullptr);
+    EXPECT_FALSE(missing);
+
+    EXPECT_NE(index.find(root / "Data/Sub/Level1.dat", false, &missing), nullptr);
+    EXPECT_FALSE(missing);
+}
+
+TEST_F(path_index, dot_components) {
+    const PathIndex index(root, index_path);
+
+    const auto file = index.find(root / "Data/./Sub//Level1.dat", true);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->relative_path, "Data/Sub/Level1.dat");
+
+    const auto dir = index.find(root / "Data/Sub/.", true);
+    ASSERT_NE(dir, nullptr);
+    EXPECT_EQ(dir->relative_path, "Data/Sub");
+
+    const auto trailing_separator = index.find(root / "Data/Sub/", true);
+    ASSERT_NE(trailing_separator, nullptr);
+    EXPECT_EQ(trailing_separator->relative_path, "Data/Sub");
+}
+
+TEST_F(path_index, dot_dot_components) {
+    const PathIndex index(root, index_path);
+
+    const auto file = index.find(root / "Data/Sub/../../eboot.bin", true);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(index.get_host_path(*file), root / "eboot.bin");
+
+    const auto dir = index.find(root / "Data/Sub/..", false);
+    ASSERT_NE(dir, nullptr);
+    EXPECT_EQ(dir->relative_path, "Data");
+
+    // going out of the root is left to the host
+    EXPECT_EQ(index.find(root / "../outside.dat", false), nullptr);
+}
+
+TEST_F(path_index, case_collision) {
+    write_file(root / "Data/save.dat", "lower");
+    write_file(root / "Data/SAVE.dat", "upper!");
+    if (fs::file_size(root / "Data/save.dat") == fs::file_size(root / "Data/SAVE.dat"))
+        GTEST_SKIP() << "the host filesystem is not case sensitive";
+
+    const PathIndex index(root, index_path);
+
+    // the exact paths are found or left to the host, never mixed up
+    for (const auto &name : { "save.dat", "SAVE.dat" }) {
+        const auto file = index.find(root / "Data" / name, true);
+        if (file)
+            EXPECT_EQ(file->relative_path, std::string("Data/") + name);
+    }
+    // they are left to the host, it knows which one is meant
+    bool missing = true;
+    EXPECT_EQ(index.find(root / "Data/Save.dat", false, &missing), nullptr);
+    EXPECT_FALSE(missing);
+
+    // the collision is kept when the index is loaded again
+    const PathIndex loaded(root, index_path);
+    EXPECT_EQ(loaded.find(root / "Data/Save.dat", false, &missing), nullptr);
+    EXPECT_FALSE(missing);
+}
+
+TEST_F(path_index, save_and_load) {
+    {
+        const PathIndex index(root, index_path);
+    }
+    ASSERT_TRUE(fs::exists(index_path));
+
+    // rewriting a file in place does not change its directory, a loaded index still has the old size
+    write_file(root / "Data/Sub/Level1.dat", "a longer level");
+
+    const PathIndex index(root, index_path);
+    const auto file = index.find(root / "Data/Sub/Level1.dat", true);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->size, 5);
+    EXPECT_NE(index.find(root / "eboot.bin", true), nullptr);
+}
+
+TEST_F(path_index, revalidate_changed_directory) {
+    {
+        const PathIndex index(root, index_path);
+        EXPECT_EQ(index.find(root / "Data/Sub/Level2.dat", true), nullptr);
+    }
+
+    write_file(root / "Data/Sub/Level2.dat", "level 2");
+    touch_directory(root / "Data/Sub");
+
+    const PathIndex index(root, index_path);
+    const auto file = index.find(root / "Data/Sub/Level2.dat", true);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->size, 7);
+}
+
+TEST_F(path_index, revalidate_removed_directory) {
+    {
+        const PathIndex index(root, index_path);
+        EXPECT_NE(index.find(root / "Data/Sub/Level1.dat", true), nullptr);
+    }
+
+    fs::remove_all(root / "Data/Sub");
+    touch_directory(root / "Data");
+
+    const PathIndex index(root, index_path);
+    EXPECT_EQ(index.find(root / "Data/Sub", false), nullptr);
+    EXPECT_EQ(index.find(root / "Data/Sub/Level1.dat", false), nullptr);
+    EXPECT_NE(index.find(root / "Data", false), nullptr);
+}
@@ -18,11 +18,23 @@
 #pragma once
 
 #include <cpu/common.h>
+#include <nids/functions.h>
 
 struct MemState;
 struct KernelState;
-typedef int SceUID;
-typedef std::function<void(CPUState &cpu, uint32_t nid, SceUID thread_id)> CallImportFunc;
+typedef std::function<void(CPUState &cpu, uint32_t nid, uint32_t index, ThreadState &thread)> CallImportFunc;
+
+// Import stubs of NIDs known to the HLE modules use svc #(SVC_IMPORT_INDEX_BASE + import index),
+// other stubs use svc #0 and the NID is read after the stub
+constexpr uint32_t SVC_IMPORT_INDEX_BASE = 0x100000;
+
+inline void write_import_stub(uint32_t *stub, uint32_t nid) {
+    const uint32_t index = import_index(nid);
+    const uint32_t svc = (index == INVALID_IMPORT_INDEX) ? 0 : SVC_IMPORT_INDEX_BASE + index;
+    stub[0] = 0xef000000 | svc; // svc - Call our interrupt hook.
+    stub[1] = 0xe1a0f00e; // mov pc, lr - Return to the caller.
+    stub[2] = nid; // Our interrupt hook will read this.
+}
 
 struct CPUProtocol : public CPUProtocolBase {
     CPUProtocol(KernelState &kernel, MemState &mem, const CallImportFunc &func);
@@ -30,6 +42,7 @@ struct CPUProtocol : public CPUProtocolBase {
     void call_svc(CPUState &cpu, uint32_t svc, Address pc, ThreadState &thread) override;
     Address get_watch_memory_addr(Address addr) override;
     ExclusiveMonitorPtr get_exclusive_monitor() override;
+    JitPoolPtr get_jit_pool() override;
 
 private:
     CallImportFunc call_import;
@@ -92,6 +92,7 @@ typedef std::map<uint32_t, uint32_t> ModuleUidByNid;
 
 struct KernelState {
     KernelState();
+    ~KernelState();
 
     std::mutex mutex;
     CodecEngineBlocks codec_blocks;
@@ -135,6 +136,7 @@ struct KernelState {
     CorenumAllocator corenum_allocator;
     CPUProtocolPtr cpu_protocol;
     ExclusiveMonitorPtr exclusive_monitor;
+    JitPoolPtr jit_pool = nullptr;
 
     ObjectStore obj_store;
 
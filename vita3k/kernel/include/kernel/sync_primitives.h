@@ -122,10 +122,18 @@ struct Semaphore : SyncPrimitive {
 typedef std::shared_ptr<Semaphore> SemaphorePtr;
 typedef std::map<SceUID, SemaphorePtr> SemaphorePtrs;
 
+// Lightweight mutexes keep their owner thread id and lock count in the guest workarea instead of
+// lock_count/owner, so that lock and unlock without contention only need an atomic operation on it.
+// The owner has this bit set while other threads may be waiting on the kernel object.
+constexpr uint32_t LW_MUTEX_OWNER_CONTENDED = 0x80000000;
+// The workarea also keeps its uid xored with this value while the mutex exists, lock and unlock without
+// contention check it instead of looking up the kernel object to reject unknown and deleted mutexes.
+constexpr uint32_t LW_MUTEX_UID_CHECK = 0x4C574D58;
+
 struct Mutex : SyncPrimitive {
     int init_count;
-    int lock_count;
-    ThreadStatePtr owner;
+    int lock_count; // heavy mutexes only
+    ThreadStatePtr owner; // heavy mutexes only
     WaitingThreadQueuePtr waiting_threads;
     Ptr<SceKernelLwMutexWork> workarea;
 };
@@ -225,8 +233,10 @@ SceUID mutex_find(KernelState &kernel, const char *export_name, const char *pNam
 int mutex_lock(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, SceUID mutexid, int lock_count, unsigned int *timeout, SyncWeight weight);
 int mutex_try_lock(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, SceUID mutexid, int lock_count, SyncWeight weight);
 int mutex_unlock(KernelState &kernel, const char *export_name, SceUID thread_id, SceUID mutexid, int unlock_count, SyncWeight weight);
-int mutex_delete(KernelState &kernel, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight);
-MutexPtr mutex_get(KernelState &kernel, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight);
+int mutex_delete(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight);
+int lwmutex_lock(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, Ptr<SceKernelLwMutexWork> workarea, int lock_count, unsigned int *timeout, bool only_try);
+int lwmutex_unlock(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, Ptr<SceKernelLwMutexWork> workarea, int unlock_count);
+MutexPtr mutex_get(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight);
 
 // RWLock
 SceUID rwlock_create(KernelState &kernel, MemState &mem, const char *export_name, const char *name, SceUID thread_id, SceUInt32 attr);
@@ -679,7 +679,8 @@ struct SceKernelLwMutexWork {
     std::uint32_t lockCount;
     std::uint32_t attr;
     SceUID uid;
-    std::uint32_t unknown1[3];
+    std::uint32_t uid_check; // uid ^ LW_MUTEX_UID_CHECK while the mutex exists
+    std::uint32_t unknown1[2];
 };
 
 static_assert(sizeof(SceKernelLwMutexWork) == 32, "Incorrect size");
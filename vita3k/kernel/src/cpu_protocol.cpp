@@ -50,10 +50,14 @@ void CPUProtocol::call_svc(CPUState &cpu, uint32_t svc, Address pc, ThreadState
     }
 
     // This is usual service call
-    uint32_t nid = *Ptr<uint32_t>(pc + 4).get(*mem);
-    // TODO: just supply ThreadStatePtr to call_import
-    // the only benefit of using thread_id instead--namely less locking-- has been gone for long
-    call_import(cpu, nid, thread.id);
+    // the svc number comes from guest code, an index out of the table is handled as an unknown stub
+    if (svc >= SVC_IMPORT_INDEX_BASE && svc - SVC_IMPORT_INDEX_BASE < import_count()) {
+        const uint32_t index = svc - SVC_IMPORT_INDEX_BASE;
+        call_import(cpu, import_nid(index), index, thread);
+    } else {
+        const uint32_t nid = *Ptr<uint32_t>(pc + 4).get(*mem);
+        call_import(cpu, nid, import_index(nid), thread);
+    }
 
     // ARM recommends clearing exclusive state inside interrupt handler
     clear_exclusive(kernel->exclusive_monitor, get_processor_id(cpu));
@@ -66,3 +70,7 @@ Address CPUProtocol::get_watch_memory_addr(Address addr) {
 ExclusiveMonitorPtr CPUProtocol::get_exclusive_monitor() {
     return kernel->exclusive_monitor;
 }
+
+JitPoolPtr CPUProtocol::get_jit_pool() {
+    return kernel->jit_pool;
+}
@@ -82,11 +82,16 @@ KernelState::KernelState()
     : debugger(*this) {
 }
 
+KernelState::~KernelState() {
+    free_jit_pool(jit_pool);
+}
+
 bool KernelState::init(MemState &mem, const CallImportFunc &call_import, CPUBackend cpu_backend, bool cpu_opt) {
     constexpr std::size_t MAX_CORE_COUNT = 150;
 
     corenum_allocator.set_max_core_count(MAX_CORE_COUNT);
     exclusive_monitor = new_exclusive_monitor(MAX_CORE_COUNT);
+    jit_pool = new_jit_pool();
     start_tick = rtc_get_ticks(rtc_base_ticks());
     base_tick = { rtc_base_ticks() };
     cpu_protocol = std::make_unique<CPUProtocol>(*this, mem, call_import);
@@ -127,6 +132,8 @@ void KernelState::invalidate_jit_cache(Address start, size_t length) {
     for (const auto &[_, thread] : threads) {
         ::invalidate_jit_cache(*thread->cpu, start, length);
     }
+    // JITs of exited threads are kept for reuse and must not keep stale code either
+    invalidate_jit_pool(jit_pool, start, length);
 }
 
 ThreadStatePtr KernelState::get_thread(SceUID thread_id) {
@@ -142,6 +149,8 @@ ThreadStatePtr KernelState::create_thread(MemState &mem, const char *name, Ptr<c
     if (thread->init(name, entry_point, init_priority, affinity_mask, stack_size, option) < 0)
         return nullptr;
     const auto lock = std::lock_guard(mutex);
+    // invalidations are only sent to the registered threads, the JIT may have missed some since it was created
+    sync_jit_pool(*thread->cpu);
     threads.emplace(thread->id, thread);
 
     ThreadParams params;
@@ -22,6 +22,7 @@
 #include <kernel/types.h>
 
 #include <nids/functions.h>
+#include <threads/thread_pool.h>
 #include <util/arm.h>
 #include <util/fs.h>
 #include <util/log.h>
@@ -141,9 +142,7 @@ static bool load_func_imports(const uint32_t *nids, const Ptr<uint32_t> *entries
 
         kernel.func_binding_infos.emplace(nid, entry.address());
         if (export_address == kernel.export_nids.end()) {
-            stub[0] = 0xef000000; // svc #0 - Call our interrupt hook.
-            stub[1] = 0xe1a0f00e; // mov pc, lr - Return to the caller.
-            stub[2] = nid; // Our interrupt hook will read this.
+            write_import_stub(stub, nid);
         } else {
             Address func_address = export_address->second;
             stub[0] = encode_arm_inst(INSTRUCTION_MOVW, (uint16_t)func_address, 12);
@@ -301,9 +300,7 @@ static bool unload_func_exports(SceKernelModuleInfo *kernel_module_info, const u
             Address entry = it->second;
             uint32_t *stub = Ptr<uint32_t>(entry).get(mem);
 
-            stub[0] = 0xef000000; // svc #0 - Call our interrupt hook.
-            stub[1] = 0xe1a0f00e; // mov pc, lr - Return to the caller.
-            stub[2] = nid; // Our interrupt hook will read this.
+            write_import_stub(stub, nid);
             kernel.invalidate_jit_cache(entry, 3 * sizeof(uint32_t));
         }
     }
@@ -569,6 +566,24 @@ SceUID load_self(KernelState &kernel, MemState &mem, const void *self, const std
 
     SegmentInfosForReloc segment_reloc_info;
 
+    // The segments are all allocated first, then copied and inflated in parallel, then relocated
+    struct SegmentCopy {
+        uint8_t *dest;
+        const uint8_t *source;
+        uint32_t source_size;
+        uint32_t size;
+        bool compressed;
+    };
+    std::vector<SegmentCopy> segment_copies;
+
+    struct RelocationSegment {
+        const uint8_t *entries;
+        uint32_t size;
+        // holds the entries of a compressed segment
+        std::unique_ptr<uint8_t[]> inflated;
+    };
+    std::vector<RelocationSegment> relocation_segments;
+
     auto free_all_segments = [](MemState &mem, SegmentInfosForReloc &segs_info) {
         for (auto &[_, segment] : segs_info) {
             free(mem, segment.addr);
@@ -625,42 +640,22 @@ SceUID load_self(KernelState &kernel, MemState &mem, const void *self, const std
                 }
 
                 const Ptr<uint8_t> seg_ptr(segment_address);
-                if (seg_infos[seg_index].compression == 2) {
-                    unsigned long dest_bytes = seg_header.p_filesz;
-                    const uint8_t *const compressed_segment_bytes = self_bytes + seg_infos[seg_index].offset;
-
-                    int res = mz_uncompress(seg_ptr.get(mem), &dest_bytes, compressed_segment_bytes, static_cast<mz_ulong>(seg_infos[seg_index].length));
-                    assert(res == MZ_OK);
-                } else {
-                    memcpy(seg_ptr.get(mem), seg_bytes, seg_header.p_filesz);
-                }
-
-                for (auto &patch : patches) {
-                    // TODO patches should maybe be able to specify the path/file to patch?
-                    if (seg_index == patch.seg && self_path.find("eboot.bin") != std::string::npos) {
-                        LOG_INFO("Patching segment {} at offset 0x{:X} with {} values", seg_index, patch.offset, patch.values.size());
-                        memcpy(seg_ptr.get(mem) + patch.offset, patch.values.data(), patch.values.size());
-                    }
-                }
+                if (seg_infos[seg_index].compression == 2)
+                    segment_copies.push_back({ seg_ptr.get(mem), self_bytes + seg_infos[seg_index].offset, static_cast<uint32_t>(seg_infos[seg_index].length), seg_header.p_filesz, true });
+                else
+                    segment_copies.push_back({ seg_ptr.get(mem), seg_bytes, seg_header.p_filesz, seg_header.p_filesz, false });
 
                 segment_reloc_info[seg_index] = { segment_address, seg_header.p_vaddr, seg_header.p_memsz };
             }
         } else if (seg_header.p_type == PT_SCE_RELA) {
+            RelocationSegment &relocation = relocation_segments.emplace_back();
+            relocation.size = seg_header.p_filesz;
             if (seg_infos[seg_index].compression == 2) {
-                unsigned long dest_bytes = seg_header.p_filesz;
-                const uint8_t *const compressed_segment_bytes = self_bytes + seg_infos[seg_index].offset;
-                auto uncompressed = std::make_unique<uint8_t[]>(dest_bytes);
-
-                int res = mz_uncompress(uncompressed.get(), &dest_bytes, compressed_segment_bytes, static_cast<mz_ulong>(seg_infos[seg_index].length));
-                assert(res == MZ_OK);
-                if (!relocate(uncompressed.get(), seg_header.p_filesz, segment_reloc_info, mem)) {
-                    return -1;
-                }
-
+                relocation.inflated = std::make_unique<uint8_t[]>(seg_header.p_filesz);
+                relocation.entries = relocation.inflated.get();
+                segment_copies.push_back({ relocation.inflated.get(), self_bytes + seg_infos[seg_index].offset, static_cast<uint32_t>(seg_infos[seg_index].length), seg_header.p_filesz, true });
             } else {
-                if (!relocate(seg_bytes, seg_header.p_filesz, segment_reloc_info, mem)) {
-                    return -1;
-                }
+                relocation.entries = seg_bytes;
             }
         } else if ((seg_header.p_type == PT_SCE_COMMENT) || (seg_header.p_type == PT_SCE_VERSION)
             || (seg_header.p_type == PT_ARM_EXIDX) /* TODO: this may be important and require being loaded */) {
@@ -670,6 +665,34 @@ SceUID load_self(KernelState &kernel, MemState &mem, const void *self, const std
         }
     }
 
+    get_shared_thread_pool().parallel_for(segment_copies.size(), [&](size_t i) {
+        const SegmentCopy &copy = segment_copies[i];
+        if (copy.compressed) {
+            unsigned long dest_bytes = copy.size;
+            int res = mz_uncompress(copy.dest, &dest_bytes, copy.source, static_cast<mz_ulong>(copy.source_size));
+            assert(res == MZ_OK);
+        } else {
+            memcpy(copy.dest, copy.source, copy.size);
+        }
+    });
+
+    // TODO patches should maybe be able to specify the path/file to patch?
+    if (self_path.find("eboot.bin") != std::string::npos) {
+        for (auto &patch : patches) {
+            const auto segment = segment_reloc_info.find(patch.seg);
+            if (segment != segment_reloc_info.end()) {
+                LOG_INFO("Patching segment {} at offset 0x{:X} with {} values", patch.seg, patch.offset, patch.values.size());
+                memcpy(Ptr<uint8_t>(segment->second.addr).get(mem) + patch.offset, patch.values.data(), patch.values.size());
+            }
+        }
+    }
+
+    for (const RelocationSegment &relocation : relocation_segments) {
+        if (!relocate(relocation.entries, relocation.size, segment_reloc_info, mem)) {
+            return -1;
+        }
+    }
+
     if (kernel.debugger.dump_elfs) {
         // Dump elf
         std::vector<uint8_t> dump_elf(self_bytes + self_header.header_len, self_bytes + self_header.self_filesize);
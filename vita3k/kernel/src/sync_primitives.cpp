@@ -23,6 +23,8 @@
 #include <util/lock_and_find.h>
 #include <util/log.h>
 
+#include <atomic>
+
 static constexpr bool LOG_SYNC_PRIMITIVES = false;
 
 // ***********
@@ -571,9 +573,10 @@ SceUID mutex_create(SceUID *uid_out, KernelState &kernel, MemState &mem, const c
     if (weight == SyncWeight::Light) {
         SceKernelLwMutexWork *workarea_mem = workarea.get(mem);
         workarea_mem->lockCount = init_count;
-        if (workarea_mem->lockCount)
-            workarea_mem->owner = thread_id;
+        workarea_mem->owner = init_count > 0 ? thread_id : 0;
         workarea_mem->attr = attr;
+        workarea_mem->uid = uid;
+        workarea_mem->uid_check = static_cast<uint32_t>(uid) ^ LW_MUTEX_UID_CHECK;
     }
 
     const std::lock_guard<std::mutex> kernel_lock(kernel.mutex);
@@ -630,9 +633,6 @@ inline static int mutex_lock_impl(KernelState &kernel, MemState &mem, const char
         if (mutex->owner == thread) {
             if (is_recursive) {
                 mutex->lock_count += lock_count;
-                if (weight == SyncWeight::Light)
-                    mutex->workarea.get(mem)->lockCount += lock_count;
-
                 return SCE_KERNEL_OK;
             }
             if (weight == SyncWeight::Light)
@@ -662,16 +662,7 @@ inline static int mutex_lock_impl(KernelState &kernel, MemState &mem, const char
         const auto data_it = mutex->waiting_threads->push(data);
         thread_lock.unlock();
 
-        int res = handle_timeout(thread, thread_lock, mutex_lock, mutex->waiting_threads, data_it, export_name, timeout);
-
-        if (weight == SyncWeight::Light) {
-            mutex->workarea.get(mem)->lockCount = mutex->lock_count;
-            if (mutex->owner == thread) {
-                mutex->workarea.get(mem)->owner = thread_id;
-            }
-        }
-
-        return res;
+        return handle_timeout(thread, thread_lock, mutex_lock, mutex->waiting_threads, data_it, export_name, timeout);
     }
     // Not owned
     // Take ownership!
@@ -679,13 +670,6 @@ inline static int mutex_lock_impl(KernelState &kernel, MemState &mem, const char
     mutex->lock_count += lock_count;
     mutex->owner = thread;
 
-    if (weight == SyncWeight::Light) {
-        mutex->workarea.get(mem)->lockCount = mutex->lock_count;
-        if (mutex->owner == thread) {
-            mutex->workarea.get(mem)->owner = thread_id;
-        }
-    }
-
     return SCE_KERNEL_OK;
 }
 
@@ -758,7 +742,161 @@ int mutex_unlock(KernelState &kernel, const char *export_name, SceUID thread_id,
     return mutex_unlock_impl(kernel, export_name, thread_id, unlock_count, mutex);
 }
 
-int mutex_delete(KernelState &kernel, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight) {
+// Uncontended lock and unlock only work on the workarea, the kernel object is looked up (when not given)
+// and its mutex taken only when the owner word shows that threads have to sleep or be woken up.
+inline static bool is_lwmutex_alive(const SceKernelLwMutexWork &work) {
+    return work.uid > 0 && (static_cast<uint32_t>(work.uid) ^ LW_MUTEX_UID_CHECK) == work.uid_check;
+}
+
+inline static int lwmutex_lock_recursive(const char *export_name, SceKernelLwMutexWork &work, int lock_count) {
+    if (!(work.attr & SCE_KERNEL_MUTEX_ATTR_RECURSIVE))
+        return RET_ERROR(SCE_KERNEL_ERROR_LW_MUTEX_RECURSIVE);
+
+    work.lockCount += lock_count;
+    return SCE_KERNEL_OK;
+}
+
+static int lwmutex_lock_impl(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, int lock_count, Ptr<SceKernelLwMutexWork> workarea, MutexPtr mutex, SceUInt *timeout, bool only_try) {
+    SceKernelLwMutexWork &work = *workarea.get(mem);
+    std::atomic_ref<uint32_t> owner(work.owner);
+    const uint32_t self = static_cast<uint32_t>(thread_id);
+
+    if (!is_lwmutex_alive(work))
+        return unknown_mutex_id(export_name, SyncWeight::Light);
+
+    uint32_t current = 0;
+    if (owner.compare_exchange_strong(current, self, std::memory_order_acquire)) {
+        work.lockCount = lock_count;
+        return SCE_KERNEL_OK;
+    }
+    if ((current & ~LW_MUTEX_OWNER_CONTENDED) == self)
+        return lwmutex_lock_recursive(export_name, work, lock_count);
+    if (only_try)
+        return RET_ERROR(SCE_KERNEL_ERROR_LW_MUTEX_FAILED_TO_OWN);
+
+    if (!mutex) {
+        if (auto error = find_mutex(mutex, nullptr, kernel, export_name, work.uid, SyncWeight::Light))
+            return error;
+    }
+
+    if (LOG_SYNC_PRIMITIVES) {
+        LOG_DEBUG("{}: uid: {} thread_id: {} name: \"{}\" attr: {} owner: {} lock_count: {} timeout: {} waiting_threads: {}",
+            export_name, mutex->uid, thread_id, mutex->name, mutex->attr, current & ~LW_MUTEX_OWNER_CONTENDED, work.lockCount,
+            timeout ? *timeout : 0, mutex->waiting_threads->size());
+    }
+
+    const ThreadStatePtr thread = kernel.get_thread(thread_id);
+
+    std::unique_lock<std::mutex> mutex_lock(mutex->mutex);
+
+    // Flag the owner as contended so that its unlock goes through the kernel object,
+    // unless it released the mutex in the meantime
+    current = owner.load(std::memory_order_relaxed);
+    while (true) {
+        if (current == 0) {
+            if (owner.compare_exchange_weak(current, self, std::memory_order_acquire)) {
+                work.lockCount = lock_count;
+                return SCE_KERNEL_OK;
+            }
+        } else if ((current & ~LW_MUTEX_OWNER_CONTENDED) == self) {
+            return lwmutex_lock_recursive(export_name, work, lock_count);
+        } else if ((current & LW_MUTEX_OWNER_CONTENDED) || owner.compare_exchange_weak(current, current | LW_MUTEX_OWNER_CONTENDED, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    // Sleep thread! The unlocking thread hands the mutex over to us before waking us up
+    std::unique_lock<std::mutex> thread_lock(thread->mutex);
+    thread->update_status(ThreadStatus::wait, ThreadStatus::run);
+
+    WaitingThreadData data;
+    data.thread = thread;
+    data.lock_count = lock_count;
+    data.priority = thread->priority;
+
+    const auto data_it = mutex->waiting_threads->push(data);
+    thread_lock.unlock();
+
+    const int res = handle_timeout(thread, thread_lock, mutex_lock, mutex->waiting_threads, data_it, export_name, timeout);
+    if (res < 0 && mutex->waiting_threads->empty())
+        owner.fetch_and(~LW_MUTEX_OWNER_CONTENDED, std::memory_order_relaxed);
+
+    return res;
+}
+
+static int lwmutex_unlock_impl(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, int unlock_count, Ptr<SceKernelLwMutexWork> workarea, MutexPtr mutex) {
+    SceKernelLwMutexWork &work = *workarea.get(mem);
+    std::atomic_ref<uint32_t> owner(work.owner);
+    const uint32_t self = static_cast<uint32_t>(thread_id);
+
+    if (!is_lwmutex_alive(work))
+        return unknown_mutex_id(export_name, SyncWeight::Light);
+
+    if ((owner.load(std::memory_order_relaxed) & ~LW_MUTEX_OWNER_CONTENDED) != self)
+        return SCE_KERNEL_OK;
+
+    if (unlock_count > static_cast<int>(work.lockCount))
+        return RET_ERROR(SCE_KERNEL_ERROR_LW_MUTEX_UNLOCK_UDF);
+
+    work.lockCount -= unlock_count;
+    if (work.lockCount > 0)
+        return SCE_KERNEL_OK;
+
+    uint32_t current = self;
+    if (owner.compare_exchange_strong(current, 0, std::memory_order_release))
+        return SCE_KERNEL_OK;
+
+    // Contended, hand the mutex over to the first waiting thread
+    if (!mutex) {
+        if (auto error = find_mutex(mutex, nullptr, kernel, export_name, work.uid, SyncWeight::Light))
+            return error;
+    }
+
+    if (LOG_SYNC_PRIMITIVES) {
+        LOG_DEBUG("{}: uid: {} thread_id: {} name: \"{}\" attr: {} unlock_count: {} waiting_threads: {}",
+            export_name, mutex->uid, thread_id, mutex->name, mutex->attr, unlock_count,
+            mutex->waiting_threads->size());
+    }
+
+    const std::lock_guard<std::mutex> mutex_lock(mutex->mutex);
+
+    if (mutex->waiting_threads->empty()) {
+        owner.store(0, std::memory_order_release);
+        return SCE_KERNEL_OK;
+    }
+
+    const auto waiting_thread_data = *mutex->waiting_threads->begin();
+    const auto waiting_thread = waiting_thread_data.thread;
+    mutex->waiting_threads->pop();
+
+    work.lockCount = waiting_thread_data.lock_count;
+    owner.store(static_cast<uint32_t>(waiting_thread->id) | (mutex->waiting_threads->empty() ? 0 : LW_MUTEX_OWNER_CONTENDED), std::memory_order_release);
+
+    const std::lock_guard<std::mutex> waiting_thread_lock(waiting_thread->mutex);
+    waiting_thread->update_status(ThreadStatus::run, ThreadStatus::wait);
+
+    return SCE_KERNEL_OK;
+}
+
+int lwmutex_lock(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, Ptr<SceKernelLwMutexWork> workarea, int lock_count, unsigned int *timeout, bool only_try) {
+    return lwmutex_lock_impl(kernel, mem, export_name, thread_id, lock_count, workarea, nullptr, timeout, only_try);
+}
+
+int lwmutex_unlock(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, Ptr<SceKernelLwMutexWork> workarea, int unlock_count) {
+    return lwmutex_unlock_impl(kernel, mem, export_name, thread_id, unlock_count, workarea, nullptr);
+}
+
+// lightweight mutexes keep their lock count in the workarea
+inline static int get_lock_count(const MemState &mem, const Mutex &mutex, SyncWeight weight) {
+    if (weight == SyncWeight::Light) {
+        const SceKernelLwMutexWork &work = *mutex.workarea.get(mem);
+        return (work.owner & ~LW_MUTEX_OWNER_CONTENDED) ? static_cast<int>(work.lockCount) : 0;
+    }
+
+    return mutex.lock_count;
+}
+
+int mutex_delete(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight) {
     assert(mutexid >= 0);
 
     MutexPtr mutex;
@@ -768,11 +906,14 @@ int mutex_delete(KernelState &kernel, const char *export_name, SceUID thread_id,
 
     if (LOG_SYNC_PRIMITIVES) {
         LOG_DEBUG("{}: uid: {} thread_id: {} name: \"{}\" attr: {} lock_count: {} waiting_threads: {}",
-            export_name, mutexid, thread_id, mutex->name, mutex->attr, mutex->lock_count,
+            export_name, mutexid, thread_id, mutex->name, mutex->attr, get_lock_count(mem, *mutex, weight),
             mutex->waiting_threads->size());
     }
 
     if (mutex->waiting_threads->empty()) {
+        if (weight == SyncWeight::Light)
+            mutex->workarea.get(mem)->uid_check = 0;
+
         const std::lock_guard<std::mutex> kernel_guard(kernel.mutex);
         mutexes->erase(mutexid);
     } else {
@@ -783,7 +924,7 @@ int mutex_delete(KernelState &kernel, const char *export_name, SceUID thread_id,
     return SCE_KERNEL_OK;
 }
 
-MutexPtr mutex_get(KernelState &kernel, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight) {
+MutexPtr mutex_get(KernelState &kernel, MemState &mem, const char *export_name, SceUID thread_id, SceUID mutexid, SyncWeight weight) {
     assert(mutexid >= 0);
 
     MutexPtr mutex;
@@ -793,7 +934,7 @@ MutexPtr mutex_get(KernelState &kernel, const char *export_name, SceUID thread_i
 
     if (LOG_SYNC_PRIMITIVES) {
         LOG_DEBUG("{}: uid: {} thread_id: {} name: \"{}\" attr: {} lock_count: {} waiting_threads: {}",
-            export_name, mutexid, thread_id, mutex->name, mutex->attr, mutex->lock_count,
+            export_name, mutexid, thread_id, mutex->name, mutex->attr, get_lock_count(mem, *mutex, weight),
             mutex->waiting_threads->size());
     }
     return mutex;
@@ -1240,8 +1381,13 @@ int condvar_wait(KernelState &kernel, MemState &mem, const char *export_name, Sc
 
     std::unique_lock<std::mutex> condition_variable_lock(condvar->mutex);
 
-    if (auto error = mutex_unlock_impl(kernel, export_name, thread_id, 1, condvar->associated_mutex))
+    const MutexPtr &mutex = condvar->associated_mutex;
+    if (weight == SyncWeight::Light) {
+        if (auto error = lwmutex_unlock_impl(kernel, mem, export_name, thread_id, 1, mutex->workarea, mutex))
+            return error;
+    } else if (auto error = mutex_unlock_impl(kernel, export_name, thread_id, 1, condvar->associated_mutex)) {
         return error;
+    }
 
     std::unique_lock<std::mutex> thread_lock(thread->mutex);
     thread->update_status(ThreadStatus::wait, ThreadStatus::run);
@@ -1257,6 +1403,9 @@ int condvar_wait(KernelState &kernel, MemState &mem, const char *export_name, Sc
         return error;
 
     condition_variable_lock.unlock();
+    if (weight == SyncWeight::Light)
+        return lwmutex_lock_impl(kernel, mem, export_name, thread_id, 1, mutex->workarea, mutex, timeout, false);
+
     return mutex_lock_impl(kernel, mem, export_name, thread_id, 1, condvar->associated_mutex, weight, timeout, false);
 }
 
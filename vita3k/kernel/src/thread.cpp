@@ -260,7 +260,7 @@ bool ThreadState::run_loop() {
 
             // handle svc call if this was what stopped the cpu
             if (cpu->svc_called) {
-                cpu->protocol->call_svc(*cpu, cpu->svc_called, read_pc(*cpu), *this);
+                cpu->protocol->call_svc(*cpu, cpu->svc, read_pc(*cpu), *this);
             }
 
             lock.lock();
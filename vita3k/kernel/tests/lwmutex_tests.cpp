@@ -0,0 +1,126 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <kernel/state.h>
+#include <kernel/sync_primitives.h>
+#include <mem/functions.h>
+#include <mem/state.h>
+#include <mem/test_state.h>
+
+#include <gtest/gtest.h>
+
+// only the uncontended paths are tested, they do not need any guest thread
+static constexpr SceUID THREAD_ID = 0x40010003;
+static constexpr SceUID OTHER_THREAD_ID = 0x40010005;
+
+class lwmutex : public testing::Test {
+protected:
+    void SetUp() override {
+        workarea = Ptr<SceKernelLwMutexWork>(alloc(get_mem(), sizeof(SceKernelLwMutexWork), "lwmutex_tests"));
+        ASSERT_TRUE(workarea);
+    }
+
+    void TearDown() override {
+        free(get_mem(), workarea.address());
+    }
+
+    SceUID create(SceUInt attr) {
+        SceUID uid = 0;
+        EXPECT_EQ(mutex_create(&uid, kernel, get_mem(), "create", "lwmutex", THREAD_ID, attr, 0, workarea, SyncWeight::Light), SCE_KERNEL_OK);
+        return uid;
+    }
+
+    int lock(SceUID thread_id, int count, bool only_try = false) {
+        return lwmutex_lock(kernel, get_mem(), "lock", thread_id, workarea, count, nullptr, only_try);
+    }
+
+    int unlock(SceUID thread_id, int count) {
+        return lwmutex_unlock(kernel, get_mem(), "unlock", thread_id, workarea, count);
+    }
+
+    SceKernelLwMutexWork &work() {
+        return *workarea.get(get_mem());
+    }
+
+    KernelState kernel;
+    Ptr<SceKernelLwMutexWork> workarea;
+};
+
+TEST_F(lwmutex, lock_unlock) {
+    const SceUID uid = create(0);
+    EXPECT_EQ(work().uid, uid);
+
+    ASSERT_EQ(lock(THREAD_ID, 1), SCE_KERNEL_OK);
+    EXPECT_EQ(work().owner, static_cast<uint32_t>(THREAD_ID));
+    EXPECT_EQ(work().lockCount, 1);
+
+    // another thread can't take it
+    EXPECT_EQ(lock(OTHER_THREAD_ID, 1, true), SCE_KERNEL_ERROR_LW_MUTEX_FAILED_TO_OWN);
+
+    ASSERT_EQ(unlock(THREAD_ID, 1), SCE_KERNEL_OK);
+    EXPECT_EQ(work().owner, 0);
+    EXPECT_EQ(work().lockCount, 0);
+
+    EXPECT_EQ(lock(OTHER_THREAD_ID, 1, true), SCE_KERNEL_OK);
+    EXPECT_EQ(work().owner, static_cast<uint32_t>(OTHER_THREAD_ID));
+    EXPECT_EQ(unlock(OTHER_THREAD_ID, 1), SCE_KERNEL_OK);
+}
+
+TEST_F(lwmutex, recursion) {
+    create(SCE_KERNEL_MUTEX_ATTR_RECURSIVE);
+
+    ASSERT_EQ(lock(THREAD_ID, 1), SCE_KERNEL_OK);
+    ASSERT_EQ(lock(THREAD_ID, 2), SCE_KERNEL_OK);
+    EXPECT_EQ(work().lockCount, 3);
+
+    ASSERT_EQ(unlock(THREAD_ID, 2), SCE_KERNEL_OK);
+    EXPECT_EQ(work().owner, static_cast<uint32_t>(THREAD_ID));
+    EXPECT_EQ(unlock(THREAD_ID, 2), SCE_KERNEL_ERROR_LW_MUTEX_UNLOCK_UDF);
+    ASSERT_EQ(unlock(THREAD_ID, 1), SCE_KERNEL_OK);
+    EXPECT_EQ(work().owner, 0);
+}
+
+TEST_F(lwmutex, not_recursive) {
+    create(0);
+
+    ASSERT_EQ(lock(THREAD_ID, 1), SCE_KERNEL_OK);
+    EXPECT_EQ(lock(THREAD_ID, 1), SCE_KERNEL_ERROR_LW_MUTEX_RECURSIVE);
+    EXPECT_EQ(work().lockCount, 1);
+    EXPECT_EQ(unlock(THREAD_ID, 1), SCE_KERNEL_OK);
+}
+
+TEST_F(lwmutex, deleted_uid) {
+    const SceUID uid = create(0);
+    ASSERT_EQ(lock(THREAD_ID, 1), SCE_KERNEL_OK);
+    ASSERT_EQ(unlock(THREAD_ID, 1), SCE_KERNEL_OK);
+    ASSERT_EQ(mutex_delete(kernel, get_mem(), "delete", THREAD_ID, uid, SyncWeight::Light), SCE_KERNEL_OK);
+
+    // the owner word is free, but the mutex does not exist anymore
+    EXPECT_EQ(lock(THREAD_ID, 1), SCE_KERNEL_ERROR_UNKNOWN_LW_MUTEX_ID);
+    EXPECT_EQ(lock(THREAD_ID, 1, true), SCE_KERNEL_ERROR_UNKNOWN_LW_MUTEX_ID);
+    EXPECT_EQ(unlock(THREAD_ID, 1), SCE_KERNEL_ERROR_UNKNOWN_LW_MUTEX_ID);
+    EXPECT_EQ(work().owner, 0);
+    EXPECT_EQ(mutex_get(kernel, get_mem(), "get", THREAD_ID, uid, SyncWeight::Light), nullptr);
+}
+
+TEST_F(lwmutex, unknown_uid) {
+    // a workarea which was never given to mutex_create
+    memset(&work(), 0, sizeof(SceKernelLwMutexWork));
+    work().uid = 0x10005;
+    EXPECT_EQ(lock(THREAD_ID, 1), SCE_KERNEL_ERROR_UNKNOWN_LW_MUTEX_ID);
+    EXPECT_EQ(unlock(THREAD_ID, 1), SCE_KERNEL_ERROR_UNKNOWN_LW_MUTEX_ID);
+}
@@ -442,7 +442,8 @@ struct LangState {
     std::map<std::string, std::string> performance_overlay = {
         { "avg", "Avg" },
         { "min", "Min" },
-        { "max", "Max" }
+        { "max", "Max" },
+        { "commands_per_sec", "Commands/s" }
     };
     struct Settings {
         std::map<std::string, std::string> main = { { "title", "Settings" } };
@@ -714,6 +715,9 @@ struct LangState {
             { "log_active_shaders_description", "Log shaders being used on each draw call." },
             { "log_uniforms", "Uniform logging" },
             { "log_uniforms_description", "Log shader uniform names and values." },
+            { "shader_log_mode", "Shader dumps" },
+            { "shader_log_mode_description", "Files written to the shaderlog folder when a shader is generated.\nGXP only keeps the original programs, Full also keeps the disassembly and translated code." },
+            { "shader_log_full", "Full" },
             { "color_surface_debug", "Save color surfaces" },
             { "color_surface_debug_description", "Save color surfaces to files." },
             { "dump_elfs", "ELF dumping" },
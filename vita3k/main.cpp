@@ -390,17 +390,16 @@ int main(int argc, char *argv[]) {
     emuenv.renderer->set_app(emuenv.io.title_id.c_str(), emuenv.self_name.c_str());
     if (renderer::get_shaders_cache_hashs(*emuenv.renderer) && cfg.shader_cache) {
         SDL_SetWindowTitle(emuenv.window.get(), fmt::format("{} | {} ({}) | Please wait, compiling shaders...", window_title, emuenv.current_app_title, emuenv.io.title_id).c_str());
-        for (const auto &hash : emuenv.renderer->shaders_cache_hashs) {
+        renderer::precompile_shaders(*emuenv.renderer, [&]() {
             handle_events(emuenv, gui);
             gui::draw_begin(gui, emuenv);
             draw_app_background(gui, emuenv);
 
-            emuenv.renderer->precompile_shader(hash);
             gui::draw_pre_compiling_shaders_progress(gui, emuenv, static_cast<uint32_t>(emuenv.renderer->shaders_cache_hashs.size()));
 
             gui::draw_end(gui);
             emuenv.renderer->swap_window(emuenv.window.get());
-        }
+        });
     }
     {
         const auto err = run_app(emuenv, main_module_id);
@@ -48,6 +48,11 @@ void close_access_parent_protect_segment(MemState &state, Address addr);
 void add_external_mapping(MemState &mem, Address addr, uint32_t size, uint8_t *addr_ptr);
 void remove_external_mapping(MemState &mem, uint8_t *addr_ptr);
 bool is_protecting(MemState &state, Address addr, MemPerm *perm = nullptr);
+// Write protect the pages entirely inside this range which are not tracked yet, the next write to one of them increases its write generation
+void track_page_writes(MemState &state, Address addr, uint32_t size);
+// Return a value which changes each time one of the pages of this range is written to since it was tracked,
+// the bytes of the range on the pages it only partly covers are compared by their content instead
+uint64_t get_page_write_generation(const MemState &state, Address addr, uint32_t size);
 bool is_valid_addr(const MemState &state, Address addr);
 bool is_valid_addr_range(const MemState &state, Address start, Address end);
 bool handle_access_violation(MemState &state, uint8_t *addr, bool write) noexcept;
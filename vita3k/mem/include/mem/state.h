@@ -21,6 +21,7 @@
 #include <mem/functions.h>
 #include <mem/util.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -36,6 +37,7 @@ typedef uint8_t *PagePtr;
 typedef std::unique_ptr<uint8_t[], std::function<void(uint8_t *)>> Memory;
 typedef std::unique_ptr<AllocMemPage[]> AllocPageTable;
 typedef std::unique_ptr<PagePtr[]> PageTable;
+typedef std::unique_ptr<std::atomic<uint32_t>[]> PageGenerationTable;
 typedef std::map<int, std::string> PageNameMap;
 
 struct ProtectBlockInfo {
@@ -72,6 +74,9 @@ struct MemState {
     AllocPageTable alloc_table;
     BitmapAllocator allocator;
     ProtectSegmentTrees protect_tree;
+    // Increased each time a tracked page is written to or starts being tracked again,
+    // the lowest bit is set while the page is write protected
+    PageGenerationTable page_write_generation;
 
     PageNameMap page_name_map;
 
@@ -103,6 +103,7 @@ bool init(MemState &state, const bool use_page_table) {
     memset(state.alloc_table.get(), 0, sizeof(AllocMemPage) * table_length);
 
     state.allocator.set_maximum(table_length);
+    state.page_write_generation = PageGenerationTable(new std::atomic<uint32_t>[table_length]());
 
     const auto handler = [&state](uint8_t *addr, bool write) noexcept {
         return handle_access_violation(state, addr, write);
@@ -215,7 +216,7 @@ Address alloc_aligned(MemState &state, uint32_t size, const char *name, unsigned
     return align_addr;
 }
 
-static void align_to_page(MemState &state, Address &addr, Address &size) {
+static void align_to_page(const MemState &state, Address &addr, Address &size) {
     const Address end = align(addr + size, state.page_size);
     addr = align_down(addr, state.page_size);
     size = end - addr;
@@ -225,6 +226,15 @@ void unprotect_inner(MemState &state, Address addr, uint32_t size) {
     if (LOG_PROTECT) {
         fmt::print("Unprotect: {} {}\n", log_hex(addr), size);
     }
+
+    // the tracked pages of this range can now be written to without us knowing, consider them as written
+    for (uint32_t page = addr / state.page_size; page < align(addr + size, state.page_size) / state.page_size; page++) {
+        std::atomic<uint32_t> &generation = state.page_write_generation[page];
+        uint32_t value = generation.load();
+        while ((value & 1) && !generation.compare_exchange_weak(value, value + 1))
+            ;
+    }
+
     uint8_t *addr_ptr = state.use_page_table ? state.page_table[addr / KiB(4)] : state.memory.get();
 
 #ifdef _WIN32
@@ -390,6 +400,71 @@ bool is_protecting(MemState &state, Address addr, MemPerm *perm) {
     return false;
 }
 
+// Only the pages entirely covered by the range are tracked, the first and last pages may also hold
+// unrelated data written all the time, protecting them would make each of these writes fault.
+static void get_tracked_pages(const MemState &state, Address addr, uint32_t size, uint32_t &first_page, uint32_t &end_page) {
+    first_page = align(addr, state.page_size) / state.page_size;
+    end_page = std::max(first_page, static_cast<uint32_t>(align_down(static_cast<uint64_t>(addr) + size, state.page_size) / state.page_size));
+}
+
+void track_page_writes(MemState &state, Address addr, uint32_t size) {
+    uint32_t first_page, end_page;
+    get_tracked_pages(state, addr, size, first_page, end_page);
+
+    // protect each run of pages not tracked yet with a single block,
+    // the generation of its pages is increased by unprotect_inner on the first write to any of them
+    const auto protect_run = [&](uint32_t run_start, uint32_t run_end) {
+        if (run_start == run_end)
+            return;
+        add_protect(state, run_start * state.page_size, (run_end - run_start) * state.page_size, MemPerm::ReadOnly, [](Address, bool) {
+            return true;
+        });
+    };
+
+    uint32_t run_start = first_page;
+    for (uint32_t page = first_page; page < end_page; page++) {
+        // set the lowest bit before protecting the page so that a write happening right after is not missed
+        if (state.page_write_generation[page].fetch_or(1) & 1) {
+            // already tracked
+            protect_run(run_start, page);
+            run_start = page + 1;
+        }
+    }
+    protect_run(run_start, end_page);
+}
+
+// FNV-1a, the partly covered pages are at most two small ranges
+static uint64_t hash_range(const MemState &state, Address addr, Address end, uint64_t hash) {
+    while (addr < end) {
+        // with the page table, only the content of a single 4KiB page is contiguous
+        const Address chunk_end = std::min<uint64_t>(end, align_down(static_cast<uint64_t>(addr), KiB(4)) + KiB(4));
+        const uint8_t *addr_ptr = state.use_page_table ? state.page_table[addr / KiB(4)] : state.memory.get();
+        for (; addr < chunk_end; addr++)
+            hash = (hash ^ addr_ptr[addr]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+uint64_t get_page_write_generation(const MemState &state, Address addr, uint32_t size) {
+    uint32_t first_page, end_page;
+    get_tracked_pages(state, addr, size, first_page, end_page);
+
+    // each generation can only increase, so does their sum
+    uint64_t sum = 0;
+    for (uint32_t page = first_page; page < end_page; page++)
+        sum += state.page_write_generation[page].load(std::memory_order_relaxed);
+
+    // the bytes on the pages which are not tracked are compared by their content
+    const uint64_t end = static_cast<uint64_t>(addr) + size;
+    const uint64_t head_end = std::min<uint64_t>(static_cast<uint64_t>(first_page) * state.page_size, end);
+    const uint64_t tail_start = std::max<uint64_t>(static_cast<uint64_t>(end_page) * state.page_size, head_end);
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = hash_range(state, addr, static_cast<Address>(head_end), hash);
+    hash = hash_range(state, static_cast<Address>(tail_start), static_cast<Address>(end), hash);
+
+    return (hash ^ sum) * 0x100000001B3ULL;
+}
+
 void open_access_parent_protect_segment(MemState &state, Address addr) {
     const std::lock_guard<std::mutex> lock(state.protect_mutex);
     auto ite = state.protect_tree.lower_bound(addr);
@@ -533,6 +608,14 @@ void free(MemState &state, Address address) {
     if (!page.allocated) {
         LOG_CRITICAL("Freeing unallocated page");
     }
+
+    // the next allocation makes the pages writable without faulting, handle the protected ones
+    // as if they were written to so their tracked generations change and their callbacks are called
+    for (uint32_t freed_page = page_num; freed_page < page_num + page.size; freed_page++) {
+        const Address page_addr = freed_page * state.page_size;
+        if (is_protecting(state, page_addr))
+            handle_access_violation(state, &state.memory[page_addr], true);
+    }
     page.allocated = 0;
 
     state.allocator.free(page_num, page.size);
@@ -0,0 +1,129 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <mem/functions.h>
+#include <mem/ptr.h>
+#include <mem/state.h>
+#include <mem/test_state.h>
+
+#include <gtest/gtest.h>
+
+class page_tracking : public testing::Test {
+protected:
+    void SetUp() override {
+        MemState &mem = get_mem();
+        page_size = mem.page_size;
+        base = alloc(mem, page_size * 4, "page_tracking");
+        ASSERT_NE(base, 0);
+        ptr = Ptr<uint8_t>(base).get(mem);
+    }
+
+    void TearDown() override {
+        free(get_mem(), base);
+    }
+
+    uint32_t page_size = 0;
+    Address base = 0;
+    uint8_t *ptr = nullptr;
+};
+
+TEST_F(page_tracking, write_changes_generation) {
+    MemState &mem = get_mem();
+    track_page_writes(mem, base, page_size * 4);
+    const uint64_t generation = get_page_write_generation(mem, base, page_size * 4);
+    ASSERT_TRUE(is_protecting(mem, base + page_size * 2));
+
+    // the write faults, the handler unprotects the pages and increases their generation
+    ptr[page_size * 2] = 1;
+    EXPECT_FALSE(is_protecting(mem, base + page_size * 2));
+    EXPECT_NE(get_page_write_generation(mem, base, page_size * 4), generation);
+
+    // the pages are not tracked anymore, further writes are not seen until they are tracked again
+    const uint64_t written_generation = get_page_write_generation(mem, base, page_size * 4);
+    ptr[page_size * 3] = 1;
+    EXPECT_EQ(get_page_write_generation(mem, base, page_size * 4), written_generation);
+
+    track_page_writes(mem, base, page_size * 4);
+    const uint64_t tracked_generation = get_page_write_generation(mem, base, page_size * 4);
+    ptr[page_size * 3] = 2;
+    EXPECT_NE(get_page_write_generation(mem, base, page_size * 4), tracked_generation);
+}
+
+TEST_F(page_tracking, unprotect_changes_generation) {
+    MemState &mem = get_mem();
+    track_page_writes(mem, base, page_size * 2);
+    const uint64_t first_generation = get_page_write_generation(mem, base, page_size);
+    const uint64_t second_generation = get_page_write_generation(mem, base + page_size, page_size);
+
+    // once unprotected, the page can be written to without faulting, it must be considered as written
+    unprotect_inner(mem, base, page_size);
+    EXPECT_NE(get_page_write_generation(mem, base, page_size), first_generation);
+    EXPECT_EQ(get_page_write_generation(mem, base + page_size, page_size), second_generation);
+
+    ptr[page_size] = 1;
+    EXPECT_NE(get_page_write_generation(mem, base + page_size, page_size), second_generation);
+}
+
+TEST_F(page_tracking, partial_pages_are_not_protected) {
+    MemState &mem = get_mem();
+    const Address addr = base + page_size / 2;
+    const uint32_t size = page_size * 2;
+    track_page_writes(mem, addr, size);
+
+    // only the page entirely inside the range is protected
+    EXPECT_FALSE(is_protecting(mem, base));
+    EXPECT_TRUE(is_protecting(mem, base + page_size));
+    EXPECT_FALSE(is_protecting(mem, base + page_size * 2));
+
+    // the bytes on the partly covered pages are still compared by their content
+    const uint64_t generation = get_page_write_generation(mem, addr, size);
+    ptr[page_size / 2] = 1;
+    EXPECT_NE(get_page_write_generation(mem, addr, size), generation);
+    ptr[page_size / 2] = 0;
+    EXPECT_EQ(get_page_write_generation(mem, addr, size), generation);
+
+    ptr[page_size * 2 + page_size / 2 - 1] = 1;
+    EXPECT_NE(get_page_write_generation(mem, addr, size), generation);
+
+    // bytes outside of the range do not matter
+    const uint64_t tail_generation = get_page_write_generation(mem, addr, size);
+    ptr[page_size / 2 - 1] = 1;
+    ptr[page_size * 2 + page_size / 2] = 1;
+    EXPECT_EQ(get_page_write_generation(mem, addr, size), tail_generation);
+
+    ptr[page_size] = 1;
+    EXPECT_NE(get_page_write_generation(mem, addr, size), tail_generation);
+}
+
+TEST_F(page_tracking, free_changes_generation) {
+    MemState &mem = get_mem();
+    track_page_writes(mem, base, page_size * 4);
+    const uint64_t generation = get_page_write_generation(mem, base, page_size * 4);
+
+    // the memory allocated again at the same address can be written to without faulting
+    free(mem, base);
+    ASSERT_EQ(alloc(mem, page_size * 4, "page_tracking"), base);
+    EXPECT_FALSE(is_protecting(mem, base));
+    EXPECT_NE(get_page_write_generation(mem, base, page_size * 4), generation);
+
+    // and its pages can be tracked again
+    track_page_writes(mem, base, page_size * 4);
+    const uint64_t tracked_generation = get_page_write_generation(mem, base, page_size * 4);
+    EXPECT_TRUE(is_protecting(mem, base));
+    ptr[page_size] = 1;
+    EXPECT_NE(get_page_write_generation(mem, base, page_size * 4), tracked_generation);
+}
@@ -21,6 +21,7 @@
 
 #include <span>
 #include <stack>
+#include <unordered_map>
 #if defined(__x86_64__) && !defined(__APPLE__)
 #include <xxh_x86dispatch.h>
 #else
@@ -31,9 +32,11 @@
 #include <display/functions.h>
 #include <display/state.h>
 #include <gxm/functions.h>
+#include <gxm/index_range_cache.h>
 #include <gxm/state.h>
 #include <gxm/types.h>
 #include <kernel/state.h>
+#include <mem/functions.h>
 #include <mem/state.h>
 
 #include <SDL.h>
@@ -1010,6 +1013,8 @@ struct SceGxmContext {
     bool was_vert_default_uniform_reserved = false;
     bool was_frag_default_uniform_reserved = false;
 
+    gxm::IndexRangeCache index_range_cache;
+
     explicit SceGxmContext(std::mutex &callback_lock_)
         : callback_lock(callback_lock_) {
     }
@@ -2113,6 +2118,47 @@ static void gxmSetUniformBuffers(renderer::State &state, GxmState &gxm, SceGxmCo
     }
 }
 
+static void gxmSetVertexStreams(EmuEnvState &emuenv, SceGxmContext *context, const SceGxmVertexProgram &vertex_program, const StreamData *stream_data, SceGxmIndexFormat index_format, Ptr<const void> index_data, uint32_t index_count, uint32_t instance_count) {
+    // Update vertex data. We should stores a copy of the data to pass it to GPU later, since another scene
+    // may start to overwrite stuff when this scene is being processed in our queue (in case of OpenGL).
+    gxm::IndexRange index_range = { 0, 0 };
+    if (!emuenv.renderer->features.support_memory_mapping) {
+        // we don't need to get the vertex buffer size with memory mapping
+        index_range = context->index_range_cache.get(emuenv.mem, index_format, index_data.address(), index_count);
+    }
+
+    size_t max_data_length[SCE_GXM_MAX_VERTEX_STREAMS] = {};
+    size_t data_start[SCE_GXM_MAX_VERTEX_STREAMS] = {};
+    std::uint32_t stream_used = 0;
+    for (const SceGxmVertexAttribute &attribute : vertex_program.attributes) {
+        if (!emuenv.renderer->features.support_memory_mapping) {
+            const size_t attribute_size = gxm::attribute_format_size(attribute.format) * attribute.componentCount;
+            const SceGxmVertexStream &stream = vertex_program.streams[attribute.streamIndex];
+            const SceGxmIndexSource index_source = static_cast<SceGxmIndexSource>(stream.indexSource);
+            const bool is_instancing = gxm::is_stream_instancing(index_source);
+            const size_t data_passed_length = is_instancing ? ((instance_count - 1) * stream.stride) : (static_cast<size_t>(index_range.max) * stream.stride);
+            const size_t data_length = attribute.offset + data_passed_length + attribute_size;
+            max_data_length[attribute.streamIndex] = std::max<size_t>(max_data_length[attribute.streamIndex], data_length);
+            // vertices before the smallest index are not read by the draw
+            data_start[attribute.streamIndex] = is_instancing ? 0 : (static_cast<size_t>(index_range.min) * stream.stride);
+        }
+
+        stream_used |= (1 << attribute.streamIndex);
+    }
+
+    // Copy and queue upload
+    for (size_t stream_index = 0; stream_index < SCE_GXM_MAX_VERTEX_STREAMS; ++stream_index) {
+        // Upload it
+        if (stream_used & (1 << static_cast<std::uint16_t>(stream_index))) {
+            const size_t data_length = max_data_length[stream_index];
+            const Ptr<const void> data = stream_data[stream_index];
+
+            renderer::set_vertex_stream(*emuenv.renderer, context->renderer.get(), stream_index,
+                data_length, data_start[stream_index], data);
+        }
+    }
+}
+
 static int gxmDrawElementGeneral(EmuEnvState &emuenv, const char *export_name, const SceUID thread_id, SceGxmContext *context, SceGxmPrimitiveType primType, SceGxmIndexFormat indexType, Ptr<const void> indexData, uint32_t indexCount, uint32_t instanceCount) {
     if (!context || !indexData)
         return RET_ERROR(SCE_GXM_ERROR_INVALID_POINTER);
@@ -2136,8 +2182,6 @@ static int gxmDrawElementGeneral(EmuEnvState &emuenv, const char *export_name, c
     const SceGxmProgram &vertex_program_gxp = *gxm_vertex_program.program.get(emuenv.mem);
     const SceGxmProgram &fragment_program_gxp = *gxm_fragment_program.program.get(emuenv.mem);
 
-    const void *indices_ptr = indexData.get(emuenv.mem);
-
     gxmSetUniformBuffers(*emuenv.renderer, emuenv.gxm, context, vertex_program_gxp, context->state.vertex_uniform_buffers, gxm_vertex_program.renderer_data->uniform_buffer_sizes,
         emuenv.mem);
     gxmSetUniformBuffers(*emuenv.renderer, emuenv.gxm, context, fragment_program_gxp, context->state.fragment_uniform_buffers, gxm_fragment_program.renderer_data->uniform_buffer_sizes,
@@ -2168,46 +2212,7 @@ static int gxmDrawElementGeneral(EmuEnvState &emuenv, const char *export_name, c
             renderer::set_texture(*emuenv.renderer, context->renderer.get(), texture_index, textures[texture_index]);
     }
 
-    // Update vertex data. We should stores a copy of the data to pass it to GPU later, since another scene
-    // may start to overwrite stuff when this scene is being processed in our queue (in case of OpenGL).
-    size_t max_index = 0;
-    if (!emuenv.renderer->features.support_memory_mapping) {
-        // we don't need to get the vertex buffer size with memory mapping
-        if (indexType == SCE_GXM_INDEX_FORMAT_U16) {
-            const uint16_t *const data = static_cast<const uint16_t *>(indices_ptr);
-            max_index = *std::max_element(&data[0], &data[indexCount]);
-        } else {
-            const uint32_t *const data = static_cast<const uint32_t *>(indices_ptr);
-            max_index = *std::max_element(&data[0], &data[indexCount]);
-        }
-    }
-
-    size_t max_data_length[SCE_GXM_MAX_VERTEX_STREAMS] = {};
-    std::uint32_t stream_used = 0;
-    for (const SceGxmVertexAttribute &attribute : gxm_vertex_program.attributes) {
-        if (!emuenv.renderer->features.support_memory_mapping) {
-            const size_t attribute_size = gxm::attribute_format_size(attribute.format) * attribute.componentCount;
-            const SceGxmVertexStream &stream = gxm_vertex_program.streams[attribute.streamIndex];
-            const SceGxmIndexSource index_source = static_cast<SceGxmIndexSource>(stream.indexSource);
-            const size_t data_passed_length = gxm::is_stream_instancing(index_source) ? ((instanceCount - 1) * stream.stride) : (max_index * stream.stride);
-            const size_t data_length = attribute.offset + data_passed_length + attribute_size;
-            max_data_length[attribute.streamIndex] = std::max<size_t>(max_data_length[attribute.streamIndex], data_length);
-        }
-
-        stream_used |= (1 << attribute.streamIndex);
-    }
-
-    // Copy and queue upload
-    for (size_t stream_index = 0; stream_index < SCE_GXM_MAX_VERTEX_STREAMS; ++stream_index) {
-        // Upload it
-        if (stream_used & (1 << static_cast<std::uint16_t>(stream_index))) {
-            const size_t data_length = max_data_length[stream_index];
-            const Ptr<const void> data = context->state.stream_data[stream_index];
-
-            renderer::set_vertex_stream(*emuenv.renderer, context->renderer.get(), stream_index,
-                data_length, data);
-        }
-    }
+    gxmSetVertexStreams(emuenv, context, gxm_vertex_program, context->state.stream_data.data(), indexType, indexData, indexCount, instanceCount);
 
     renderer::draw(*emuenv.renderer, context->renderer.get(), primType, indexType, indexData, indexCount, instanceCount);
 
@@ -2290,20 +2295,6 @@ EXPORT(int, sceGxmDrawPrecomputed, SceGxmContext *context, SceGxmPrecomputedDraw
     gxmSetUniformBuffers(*emuenv.renderer, emuenv.gxm, context, fragment_program_gxp, fragment_buffers, fragment_program->renderer_data->uniform_buffer_sizes,
         emuenv.mem);
 
-    // Update vertex data. We should stores a copy of the data to pass it to GPU later, since another scene
-    // may start to overwrite stuff when this scene is being processed in our queue (in case of OpenGL).
-    uint32_t max_index = 0;
-    if (!emuenv.renderer->features.support_memory_mapping) {
-        // we don't need to get the vertex buffer size with memory mapping
-        if (draw->index_format == SCE_GXM_INDEX_FORMAT_U16) {
-            const uint16_t *const data = draw->index_data.cast<const uint16_t>().get(emuenv.mem);
-            max_index = *std::max_element(&data[0], &data[draw->vertex_count]);
-        } else {
-            const uint32_t *const data = draw->index_data.cast<const uint32_t>().get(emuenv.mem);
-            max_index = *std::max_element(&data[0], &data[draw->vertex_count]);
-        }
-    }
-
     // set all textures that are used and mark them as dirty
     const gxp::TextureInfo vert_textures_sync = vertex_program->renderer_data->textures_used;
     context->is_vert_texture_dirty |= vert_textures_sync;
@@ -2321,33 +2312,7 @@ EXPORT(int, sceGxmDrawPrecomputed, SceGxmContext *context, SceGxmPrecomputedDraw
             renderer::set_texture(*emuenv.renderer, context->renderer.get(), texture_index, frag_textures[texture_index]);
     }
 
-    size_t max_data_length[SCE_GXM_MAX_VERTEX_STREAMS] = {};
-    std::uint32_t stream_used = 0;
-    for (const SceGxmVertexAttribute &attribute : vertex_program->attributes) {
-        if (!emuenv.renderer->features.support_memory_mapping) {
-            const size_t attribute_size = gxm::attribute_format_size(attribute.format) * attribute.componentCount;
-            const SceGxmVertexStream &stream = vertex_program->streams[attribute.streamIndex];
-            const SceGxmIndexSource index_source = static_cast<SceGxmIndexSource>(stream.indexSource);
-            const size_t data_passed_length = gxm::is_stream_instancing(index_source) ? ((draw->instance_count - 1) * stream.stride) : (max_index * stream.stride);
-            const size_t data_length = attribute.offset + data_passed_length + attribute_size;
-            max_data_length[attribute.streamIndex] = std::max<size_t>(max_data_length[attribute.streamIndex], data_length);
-        }
-
-        stream_used |= (1 << attribute.streamIndex);
-    }
-
-    auto stream_data = draw->stream_data.get(emuenv.mem);
-    // Copy and queue upload
-    for (size_t stream_index = 0; stream_index < SCE_GXM_MAX_VERTEX_STREAMS; ++stream_index) {
-        // Upload it
-        if (stream_used & (1 << static_cast<std::uint16_t>(stream_index))) {
-            const size_t data_length = max_data_length[stream_index];
-            const Ptr<const void> data = stream_data[stream_index];
-
-            renderer::set_vertex_stream(*emuenv.renderer, context->renderer.get(), stream_index,
-                data_length, data);
-        }
-    }
+    gxmSetVertexStreams(emuenv, context, *vertex_program, draw->stream_data.get(emuenv.mem), draw->index_format, draw->index_data, draw->vertex_count, draw->instance_count);
 
     renderer::draw(*emuenv.renderer, context->renderer.get(), draw->type, draw->index_format, draw->index_data, draw->vertex_count, draw->instance_count);
 
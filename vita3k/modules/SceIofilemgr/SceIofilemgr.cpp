@@ -96,9 +96,9 @@ EXPORT(SceOff, _sceIoLseek, const SceUID fd, Ptr<_sceIoLseekOpt> opt) {
     return seek_file(fd, opt.get(emuenv.mem)->offset, opt.get(emuenv.mem)->whence, emuenv.io, export_name);
 }
 
-EXPORT(int, _sceIoLseekAsync) {
-    TRACY_FUNC(_sceIoLseekAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, _sceIoLseekAsync, const SceUID fd, Ptr<_sceIoLseekOpt> opt, SceIoAsyncParam *param) {
+    TRACY_FUNC(_sceIoLseekAsync, fd, opt, param);
+    return seek_file_async(emuenv.io, fd, opt.get(emuenv.mem)->offset, opt.get(emuenv.mem)->whence, param, export_name);
 }
 
 EXPORT(int, _sceIoMkdir, const char *dir, const SceMode mode) {
@@ -120,9 +120,13 @@ EXPORT(int, _sceIoOpen, const char *file, const int flags, const SceMode mode) {
     return open_file(emuenv.io, file, flags, emuenv.pref_path, export_name);
 }
 
-EXPORT(int, _sceIoOpenAsync) {
-    TRACY_FUNC(_sceIoOpenAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, _sceIoOpenAsync, const char *file, const int flags, const SceMode mode, SceIoAsyncParam *param) {
+    TRACY_FUNC(_sceIoOpenAsync, file, flags, mode, param);
+    if (file == nullptr) {
+        return RET_ERROR(SCE_ERROR_ERRNO_EINVAL);
+    }
+    LOG_INFO("Opening file: {}", file);
+    return open_file_async(emuenv.io, file, flags, emuenv.pref_path, param, export_name);
 }
 
 EXPORT(int, _sceIoPread) {
@@ -200,14 +204,14 @@ EXPORT(int, sceIoClose, const SceUID fd) {
     return close_file(emuenv.io, fd, export_name);
 }
 
-EXPORT(int, sceIoCloseAsync) {
-    TRACY_FUNC(sceIoCloseAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, sceIoCloseAsync, const SceUID fd, SceIoAsyncParam *param) {
+    TRACY_FUNC(sceIoCloseAsync, fd, param);
+    return close_file_async(emuenv.io, fd, param, export_name);
 }
 
-EXPORT(int, sceIoComplete) {
-    TRACY_FUNC(sceIoComplete);
-    return UNIMPLEMENTED();
+EXPORT(int, sceIoComplete, const SceUID async_id) {
+    TRACY_FUNC(sceIoComplete, async_id);
+    return complete_async(emuenv.io, async_id, nullptr, export_name);
 }
 
 EXPORT(int, sceIoDclose, const SceUID fd) {
@@ -275,9 +279,12 @@ EXPORT(int, sceIoRead, const SceUID fd, void *data, const SceSize size) {
     return read_file(data, emuenv.io, fd, size, export_name);
 }
 
-EXPORT(int, sceIoReadAsync) {
-    TRACY_FUNC(sceIoReadAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, sceIoReadAsync, const SceUID fd, void *data, const SceSize size, SceIoAsyncParam *param) {
+    TRACY_FUNC(sceIoReadAsync, fd, data, size, param);
+    if (data == nullptr) {
+        return RET_ERROR(SCE_KERNEL_ERROR_ILLEGAL_ADDR);
+    }
+    return read_file_async(data, emuenv.io, fd, size, std::nullopt, param, export_name);
 }
 
 EXPORT(int, sceIoSetPriority) {
@@ -320,7 +327,10 @@ EXPORT(int, sceIoWrite, const SceUID fd, const void *data, const SceSize size) {
     return write_file(fd, data, size, emuenv.io, export_name);
 }
 
-EXPORT(int, sceIoWriteAsync) {
-    TRACY_FUNC(sceIoWriteAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, sceIoWriteAsync, const SceUID fd, const void *data, const SceSize size, SceIoAsyncParam *param) {
+    TRACY_FUNC(sceIoWriteAsync, fd, data, size, param);
+    if (data == nullptr) {
+        return RET_ERROR(SCE_KERNEL_ERROR_ILLEGAL_ADDR);
+    }
+    return write_file_async(data, emuenv.io, fd, size, std::nullopt, param, export_name);
 }
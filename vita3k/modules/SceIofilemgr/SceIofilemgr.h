@@ -30,4 +30,5 @@ DECL_EXPORT(int, _sceIoDopen, const char *dir);
 DECL_EXPORT(int, _sceIoDread, const SceUID fd, SceIoDirent *dir);
 DECL_EXPORT(int, _sceIoMkdir, const char *dir, const SceMode mode);
 DECL_EXPORT(SceOff, _sceIoLseek, const SceUID fd, Ptr<_sceIoLseekOpt> opt);
+DECL_EXPORT(SceUID, _sceIoOpenAsync, const char *file, const int flags, const SceMode mode, SceIoAsyncParam *param);
 DECL_EXPORT(int, _sceIoGetstat, const char *file, SceIoStat *stat);
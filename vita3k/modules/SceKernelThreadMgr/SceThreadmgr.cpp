@@ -165,7 +165,7 @@ EXPORT(int, _sceKernelDeleteLwMutex, Ptr<SceKernelLwMutexWork> workarea) {
 
     const auto lightweight_mutex_id = workarea.get(emuenv.mem)->uid;
 
-    return mutex_delete(emuenv.kernel, export_name, thread_id, lightweight_mutex_id, SyncWeight::Light);
+    return mutex_delete(emuenv.kernel, emuenv.mem, export_name, thread_id, lightweight_mutex_id, SyncWeight::Light);
 }
 
 EXPORT(int, _sceKernelExitCallback) {
@@ -280,19 +280,16 @@ EXPORT(int, _sceKernelGetLwMutexInfoById, SceUID lightweight_mutex_id, Ptr<SceKe
         info_data = &info_data_local;
         info_data_local.size = info_size;
     }
-    MutexPtr mutex = mutex_get(emuenv.kernel, export_name, thread_id, lightweight_mutex_id, SyncWeight::Light);
+    MutexPtr mutex = mutex_get(emuenv.kernel, emuenv.mem, export_name, thread_id, lightweight_mutex_id, SyncWeight::Light);
     if (mutex) {
         info_data->uid = lightweight_mutex_id;
         strncpy(info_data->name, mutex->name, KERNELOBJECT_MAX_NAME_LENGTH + 1);
         info_data->attr = mutex->attr;
         info_data->pWork = mutex->workarea;
         info_data->initCount = mutex->init_count;
-        info_data->currentCount = mutex->lock_count;
-        if (mutex->owner == 0) {
-            info_data->currentOwnerId = 0;
-        } else {
-            info_data->currentOwnerId = mutex->owner->id;
-        }
+        const SceKernelLwMutexWork *work = mutex->workarea.get(emuenv.mem);
+        info_data->currentOwnerId = work->owner & ~LW_MUTEX_OWNER_CONTENDED;
+        info_data->currentCount = info_data->currentOwnerId ? work->lockCount : 0;
         info_data->numWaitThreads = static_cast<SceUInt32>(mutex->waiting_threads->size());
         if (info_size < sizeof(SceKernelLwMutexInfo)) {
             memcpy(info.get(emuenv.mem), &info_data_local, info_size);
@@ -547,8 +544,7 @@ EXPORT(int, _sceKernelLockLwMutex, Ptr<SceKernelLwMutexWork> workarea, int lock_
     if (!workarea)
         return RET_ERROR(SCE_KERNEL_ERROR_INVALID_ARGUMENT);
 
-    const auto lwmutexid = workarea.get(emuenv.mem)->uid;
-    return mutex_lock(emuenv.kernel, emuenv.mem, export_name, thread_id, lwmutexid, lock_count, ptimeout, SyncWeight::Light);
+    return lwmutex_lock(emuenv.kernel, emuenv.mem, export_name, thread_id, workarea, lock_count, ptimeout, false);
 }
 
 EXPORT(int, _sceKernelLockMutex, SceUID mutexid, int lock_count, unsigned int *timeout) {
@@ -1125,7 +1121,7 @@ EXPORT(SceInt32, sceKernelDeleteMsgPipe, SceUID msgPipeId) {
 
 EXPORT(int, sceKernelDeleteMutex, SceUID mutexid) {
     TRACY_FUNC(sceKernelDeleteMutex, mutexid);
-    return mutex_delete(emuenv.kernel, export_name, thread_id, mutexid, SyncWeight::Heavy);
+    return mutex_delete(emuenv.kernel, emuenv.mem, export_name, thread_id, mutexid, SyncWeight::Heavy);
 }
 
 EXPORT(SceInt32, sceKernelDeleteRWLock, SceUID lock_id) {
@@ -607,9 +607,9 @@ EXPORT(SceOff, sceIoLseek, const SceUID fd, const SceOff offset, const SceIoSeek
     return res;
 }
 
-EXPORT(int, sceIoLseekAsync) {
-    TRACY_FUNC(sceIoLseekAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, sceIoLseekAsync, const SceUID fd, const SceOff offset, const SceIoSeekMode whence, SceIoAsyncParam *param) {
+    TRACY_FUNC(sceIoLseekAsync, fd, offset, whence, param);
+    return seek_file_async(emuenv.io, fd, offset, whence, param, export_name);
 }
 
 EXPORT(int, sceIoMkdir, const char *dir, const SceMode mode) {
@@ -635,9 +635,12 @@ EXPORT(SceUID, sceIoOpen, const char *file, const int flags, const SceMode mode)
     return open_file(emuenv.io, file, flags, emuenv.pref_path, export_name);
 }
 
-EXPORT(int, sceIoOpenAsync) {
-    TRACY_FUNC(sceIoOpenAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, sceIoOpenAsync, const char *file, const int flags, const SceMode mode, SceIoAsyncParam *param) {
+    TRACY_FUNC(sceIoOpenAsync, file, flags, mode, param);
+    if (emuenv.cfg.current_config.file_loading_delay > 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(emuenv.cfg.current_config.file_loading_delay));
+
+    return CALL_EXPORT(_sceIoOpenAsync, file, flags, mode, param);
 }
 
 EXPORT(SceSSize, sceIoPread, SceUID fd, void *buf, SceSize nbyte, SceOff offset) {
@@ -652,9 +655,12 @@ EXPORT(SceSSize, sceIoPread, SceUID fd, void *buf, SceSize nbyte, SceOff offset)
     return res;
 }
 
-EXPORT(int, sceIoPreadAsync) {
-    TRACY_FUNC(sceIoPreadAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, sceIoPreadAsync, SceUID fd, void *buf, SceSize nbyte, SceOff offset, SceIoAsyncParam *param) {
+    TRACY_FUNC(sceIoPreadAsync, fd, buf, nbyte, offset, param);
+    if (buf == nullptr) {
+        return RET_ERROR(SCE_KERNEL_ERROR_ILLEGAL_ADDR);
+    }
+    return read_file_async(buf, emuenv.io, fd, nbyte, offset, param, export_name);
 }
 
 EXPORT(SceSSize, sceIoPwrite, SceUID fd, const void *buf, SceSize nbyte, SceOff offset) {
@@ -669,9 +675,12 @@ EXPORT(SceSSize, sceIoPwrite, SceUID fd, const void *buf, SceSize nbyte, SceOff
     return res;
 }
 
-EXPORT(int, sceIoPwriteAsync) {
-    TRACY_FUNC(sceIoPwriteAsync);
-    return UNIMPLEMENTED();
+EXPORT(SceUID, sceIoPwriteAsync, SceUID fd, const void *buf, SceSize nbyte, SceOff offset, SceIoAsyncParam *param) {
+    TRACY_FUNC(sceIoPwriteAsync, fd, buf, nbyte, offset, param);
+    if (buf == nullptr) {
+        return RET_ERROR(SCE_KERNEL_ERROR_ILLEGAL_ADDR);
+    }
+    return write_file_async(buf, emuenv.io, fd, nbyte, offset, param, export_name);
 }
 
 EXPORT(int, sceIoRead2) {
@@ -1742,8 +1751,7 @@ EXPORT(int, sceKernelStopUnloadModule, SceUID uid, SceSize args, Ptr<const void>
 
 EXPORT(int, sceKernelTryLockLwMutex, Ptr<SceKernelLwMutexWork> workarea, int lock_count) {
     TRACY_FUNC(sceKernelTryLockLwMutex, workarea, lock_count);
-    const auto lwmutexid = workarea.get(emuenv.mem)->uid;
-    return mutex_try_lock(emuenv.kernel, emuenv.mem, export_name, thread_id, lwmutexid, lock_count, SyncWeight::Light);
+    return lwmutex_lock(emuenv.kernel, emuenv.mem, export_name, thread_id, workarea, lock_count, nullptr, true);
 }
 
 EXPORT(int, sceKernelTryReceiveMsgPipe, SceUID msgpipe_id, char *recv_buf, SceSize msg_size, SceUInt32 wait_mode, SceSize *result) {
@@ -1791,8 +1799,7 @@ EXPORT(int, sceKernelUnloadModule, SceUID uid, SceUInt32 flags, const void *pOpt
 
 EXPORT(int, sceKernelUnlockLwMutex, Ptr<SceKernelLwMutexWork> workarea, int unlock_count) {
     TRACY_FUNC(sceKernelUnlockLwMutex, workarea, unlock_count);
-    const auto lwmutexid = workarea.get(emuenv.mem)->uid;
-    return mutex_unlock(emuenv.kernel, export_name, thread_id, lwmutexid, unlock_count, SyncWeight::Light);
+    return lwmutex_unlock(emuenv.kernel, emuenv.mem, export_name, thread_id, workarea, unlock_count);
 }
 
 EXPORT(int, sceKernelUnlockLwMutex_0, Ptr<SceKernelLwMutexWork> workarea, int unlock_count) {
@@ -1802,8 +1809,7 @@ EXPORT(int, sceKernelUnlockLwMutex_0, Ptr<SceKernelLwMutexWork> workarea, int un
 
 EXPORT(int, sceKernelUnlockLwMutex2, Ptr<SceKernelLwMutexWork> workarea, int unlock_count) {
     TRACY_FUNC(sceKernelUnlockLwMutex2, workarea, unlock_count);
-    const auto lwmutexid = workarea.get(emuenv.mem)->uid;
-    return mutex_unlock(emuenv.kernel, export_name, thread_id, lwmutexid, unlock_count, SyncWeight::Light);
+    return lwmutex_unlock(emuenv.kernel, emuenv.mem, export_name, thread_id, workarea, unlock_count);
 }
 
 EXPORT(SceInt32, sceKernelWaitCond, SceUID condId, SceUInt32 *pTimeout) {
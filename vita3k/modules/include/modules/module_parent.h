@@ -24,10 +24,11 @@
 struct CPUState;
 struct EmuEnvState;
 struct KernelState;
+struct ThreadState;
 
 void init_libraries(EmuEnvState &emuenv);
 void init_exported_vars(EmuEnvState &emuenv);
-void call_import(EmuEnvState &emuenv, CPUState &cpu, uint32_t nid, SceUID thread_id);
+void call_import(EmuEnvState &emuenv, CPUState &cpu, uint32_t nid, uint32_t index, ThreadState &thread);
 
 /**
  * \brief Loads a dynamic module into memory if it wasn't already loaded. If it was, find it and return it.
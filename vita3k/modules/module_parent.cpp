@@ -28,6 +28,7 @@
 #include <io/vfs.h>
 #include <kernel/load_self.h>
 #include <kernel/state.h>
+#include <kernel/thread/thread_state.h>
 #include <module/load_module.h>
 #include <nids/functions.h>
 #include <packages/license.h>
@@ -54,19 +55,14 @@ static constexpr bool LOG_UNK_NIDS_ALWAYS = false;
 
 struct EmuEnvState;
 
-static const ImportFn *resolve_import(uint32_t nid) {
-    switch (nid) {
+// Indexed by import_index(nid)
+static const auto import_table = std::to_array<const ImportFn *>({
 #define VAR_NID(name, nid)
-#define NID(name, nid) \
-    case nid:          \
-        return &import_##name;
+#define NID(name, nid) &import_##name,
 #include <nids/nids.inc>
 #undef NID
 #undef VAR_NID
-    default:
-        return nullptr;
-    }
-}
+});
 
 struct VarExport {
     uint32_t nid;
@@ -102,9 +98,7 @@ Ptr<void> create_vtable(const std::vector<uint32_t> &nids, MemState &mem) {
     for (uint32_t nid : nids) {
         *function_pointer = function_location;
         // encode svc call
-        function_svc[0] = 0xef000000; // svc #0 - Call our interrupt hook.
-        function_svc[1] = 0xe1a0f00e; // mov pc, lr - Return to the caller.
-        function_svc[2] = nid; // Our interrupt hook will read this.
+        write_import_stub(function_svc, nid);
 
         function_pointer++;
         function_svc += 3;
@@ -120,7 +114,7 @@ static void log_import_call(char emulation_level, uint32_t nid, SceUID thread_id
     }
 }
 
-void call_import(EmuEnvState &emuenv, CPUState &cpu, uint32_t nid, SceUID thread_id) {
+void call_import(EmuEnvState &emuenv, CPUState &cpu, uint32_t nid, uint32_t index, ThreadState &thread) {
     // HLE - call our C++ function
     if (emuenv.kernel.debugger.watch_import_calls) {
         const std::unordered_set<uint32_t> hle_nid_blacklist = {
@@ -129,18 +123,16 @@ void call_import(EmuEnvState &emuenv, CPUState &cpu, uint32_t nid, SceUID thread
             0x91FA6614, // sceKernelUnlockLwMutex
         };
         auto lr = read_lr(cpu);
-        log_import_call('H', nid, thread_id, hle_nid_blacklist, lr);
+        log_import_call('H', nid, thread.id, hle_nid_blacklist, lr);
     }
-    const ImportFn *fn = resolve_import(nid);
-    if (fn) {
-        (*fn)(emuenv, cpu, thread_id);
+    if (index < import_table.size()) {
+        (*import_table[index])(emuenv, cpu, thread.id);
     } else {
-        const ThreadStatePtr thread = emuenv.kernel.get_thread(thread_id);
         // make the function return 0
-        write_reg(*thread->cpu, 0, 0);
+        write_reg(cpu, 0, 0);
 
         if (!emuenv.missing_nids.contains(nid) || LOG_UNK_NIDS_ALWAYS) {
-            LOG_ERROR("Import function for NID {} not found (thread name: {}, thread ID: {})", log_hex(nid), thread->name, thread_id);
+            LOG_ERROR("Import function for NID {} not found (thread name: {}, thread ID: {})", log_hex(nid), thread.name, thread.id);
             if (!LOG_UNK_NIDS_ALWAYS)
                 emuenv.missing_nids.insert(nid);
         }
@@ -0,0 +1,30 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <cstdint>
+
+// Sample loops used by the voices. The samples are interleaved stereo float in [-1, 1].
+namespace ngs::dsp {
+// Add the src frames to dest through a patch volume matrix (volume_matrix[source channel][dest channel])
+// and clamp the result, the way the inputs of a voice are mixed
+void mix_stereo(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]);
+
+// Convert nb_samples samples to s16, saturating
+void convert_to_s16(int16_t *dest, const float *src, int nb_samples);
+} // namespace ngs::dsp
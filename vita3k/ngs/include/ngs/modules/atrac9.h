@@ -70,21 +70,21 @@ struct SceNgsAT9States {
     // used if the input must be resampled
     SwrContext *swr = nullptr;
     int8_t current_loop_count = 0;
-    // necessary if the decoder is using multiple states
-    Atrac9DecoderSavedState saved_state{};
 };
 
 namespace ngs {
-class Atrac9Module : public Module {
-private:
+struct Atrac9Scratch : public ModuleScratch {
     std::unique_ptr<Atrac9DecoderState> decoder;
-    uint32_t last_config = 0;
+    uint32_t config = 0;
+    // superframe overlapping two buffers
     std::vector<uint8_t> temp_buffer;
-    SceNgsAT9States *last_state = nullptr;
-
-    static SwrContext *swr_mono_to_stereo;
-    static SwrContext *swr_stereo;
+    // the buffers below are kept to not allocate them for each superframe
+    std::vector<int16_t> frame_samples;
+    std::vector<float> superframe_samples;
+};
 
+class Atrac9Module : public Module {
+private:
     // return false if data could not be decoded (error or no more data available)
     bool decode_more_data(KernelState &kern, const MemState &mem, const SceUID thread_id, ModuleData &data, const SceNgsAT9Params *params, SceNgsAT9States *state, std::unique_lock<std::recursive_mutex> &scheduler_lock, std::unique_lock<std::mutex> &voice_lock);
 
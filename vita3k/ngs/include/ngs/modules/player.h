@@ -84,10 +84,13 @@ struct SceNgsPlayerParamsBlock {
 
 namespace ngs {
 
-class PlayerModule : public Module {
-private:
+struct PlayerScratch : public ModuleScratch {
     std::unique_ptr<PCMDecoderState> decoder;
+    // decoder output waiting to be resampled, kept to not allocate it each time
+    std::vector<uint8_t> decoded;
+};
 
+class PlayerModule : public Module {
 public:
     bool process(KernelState &kern, const MemState &mem, const SceUID thread_id, ModuleData &data, std::unique_lock<std::recursive_mutex> &scheduler_lock, std::unique_lock<std::mutex> &voice_lock) override;
     uint32_t module_id() const override { return 0x5CE6; }
@@ -20,9 +20,15 @@
 #include <util/types.h>
 
 #include <mem/ptr.h>
+#include <threads/thread_pool.h>
 
 #include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 struct MemState;
@@ -64,9 +70,43 @@ struct VoiceScheduler {
     std::condition_variable_any condvar;
     bool is_updating = false;
 
+    // process the voices that do not depend on each other on worker threads
+    bool parallel_update = true;
+
 protected:
+    // guest callback requested by a voice processed on a worker thread, run by the update thread
+    struct CallbackRequest {
+        const std::function<void()> *callback;
+        bool done = false;
+    };
+
+    std::unique_ptr<ThreadPool> thread_pool;
+    std::mutex callbacks_mutex;
+    std::condition_variable callbacks_cond;
+    std::vector<CallbackRequest *> callbacks_pending;
+    // tasks of the current level processing a voice, the others are done or waiting for a callback
+    uint32_t running_tasks = 0;
+    // set while guest callbacks are run, the tasks wait for it to be cleared before processing a voice
+    bool running_callbacks = false;
+    std::thread::id update_thread;
+
+    // kept between updates to avoid allocating them each time
+    std::unordered_map<Voice *, size_t> queue_positions;
+    std::vector<uint32_t> voice_levels;
+
     void deque_insert(const MemState &mem, Voice *voice);
 
+    void finish_voice(KernelState &kern, const MemState &mem, const SceUID thread_id, const std::vector<Voice *> &queue_copy, size_t position,
+        bool finished, uint32_t finished_module, std::unique_lock<std::recursive_mutex> &scheduler_lock, std::unique_lock<std::mutex> &voice_lock);
+    void update_serial(KernelState &kern, const MemState &mem, const SceUID thread_id, const std::vector<Voice *> &queue_copy, std::unique_lock<std::recursive_mutex> &scheduler_lock);
+    void update_parallel(KernelState &kern, const MemState &mem, const SceUID thread_id, const std::vector<Voice *> &queue_copy, std::unique_lock<std::recursive_mutex> &scheduler_lock);
+    void run_pending_callbacks(std::unique_lock<std::recursive_mutex> &scheduler_lock);
+    void begin_task();
+    void end_task();
+    void stop_tasks(std::unique_lock<std::mutex> &lock);
+    void resume_tasks();
+    void run_requested_callbacks(std::unique_lock<std::mutex> &lock);
+
     bool resort_to_respect_dependencies(const MemState &mem, Voice *source);
 
     std::int32_t get_position(Voice *v);
@@ -82,6 +122,11 @@ public:
 
     void update(KernelState &kern, const MemState &mem, const SceUID thread_id);
 
+    // Run a guest callback of a voice being processed. Guest code can only run on the update thread,
+    // so when called from a worker thread the callback is handed over to it and this waits for it to be done.
+    // The guest code can use the voices, so the other voices stop being processed while it runs.
+    void run_callback(const std::function<void()> &callback);
+
     Ptr<Patch> patch(const MemState &mem, SceNgsPatchSetupInfo *info);
 };
 } // namespace ngs
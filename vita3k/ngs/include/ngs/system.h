@@ -26,7 +26,9 @@
 
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <span>
 #include <vector>
 
 struct MemState;
@@ -57,6 +59,11 @@ struct Patch {
     float volume_matrix[2][2];
 };
 
+// Native data a module keeps for each voice, like its decoder, destroyed with the voice
+struct ModuleScratch {
+    virtual ~ModuleScratch() = default;
+};
+
 struct ModuleData {
     Voice *parent;
     uint32_t index;
@@ -68,6 +75,7 @@ struct ModuleData {
 
     std::vector<uint8_t> voice_state_data; ///< Voice state.
     std::vector<uint8_t> extra_storage; ///< Local data storage for module.
+    std::unique_ptr<ModuleScratch> scratch; ///< Native data of the module for this voice.
 
     SceNgsBufferInfo info;
     std::vector<uint8_t> last_info;
@@ -90,6 +98,14 @@ struct ModuleData {
         return reinterpret_cast<T *>(&voice_state_data[0]);
     }
 
+    template <typename T>
+    T *get_scratch() {
+        if (!scratch)
+            scratch = std::make_unique<T>();
+
+        return static_cast<T *>(scratch.get());
+    }
+
     template <typename T>
     T *get_parameters(const MemState &mem) {
         if (flags & PARAMS_LOCK) {
@@ -214,7 +230,7 @@ struct System : public MempoolObject {
     static uint32_t get_required_memspace_size(SceNgsSystemInitParams *parameters);
 };
 
-bool deliver_data(const MemState &mem, const std::vector<Voice *> &voice_queue, Voice *source, const uint8_t output_port,
+bool deliver_data(const MemState &mem, const std::span<Voice *const> voice_queue, Voice *source, const uint8_t output_port,
     const VoiceProduct &data_to_deliver);
 
 bool init_system(State &ngs, const MemState &mem, SceNgsSystemInitParams *parameters, Ptr<void> memspace, const uint32_t memspace_size);
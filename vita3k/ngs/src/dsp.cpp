@@ -0,0 +1,215 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+/*
+sample loops of the voices
+1 program compiled for aarch64: use NEON
+2 otherwise SSE2 is always available, autodetect AVX2 at runtime and use it if possible
+the vector loops leave the last frames to the basic implementation, and do the operations
+in the same order as it, so the results are the same
+*/
+
+#include <ngs/dsp.h>
+
+#include <util/log.h>
+
+#include <algorithm>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#else
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((__target__("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define TARGET_AVX2
+#include <intrin.h>
+#else
+#error "Compiler is not supported"
+#endif
+
+#include <util/instrset_detect.h>
+#endif
+
+namespace ngs::dsp {
+
+static void mix_stereo_basic(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) {
+    for (int k = 0; k < nb_frames; k++) {
+        dest[k * 2] = std::clamp(dest[k * 2] + src[k * 2] * volume_matrix[0][0] + src[k * 2 + 1] * volume_matrix[1][0], -1.0f, 1.0f);
+        dest[k * 2 + 1] = std::clamp(dest[k * 2 + 1] + src[k * 2] * volume_matrix[0][1] + src[k * 2 + 1] * volume_matrix[1][1], -1.0f, 1.0f);
+    }
+}
+
+static void convert_to_s16_basic(int16_t *dest, const float *src, int nb_samples) {
+    for (int i = 0; i < nb_samples; i++)
+        dest[i] = static_cast<int16_t>(std::clamp(src[i] * 32768.0f, -32768.0f, 32767.0f));
+}
+
+#if defined(__aarch64__)
+void mix_stereo(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) {
+    // volumes applied to the left and to the right source channel
+    const float left_volumes[4] = { volume_matrix[0][0], volume_matrix[0][1], volume_matrix[0][0], volume_matrix[0][1] };
+    const float right_volumes[4] = { volume_matrix[1][0], volume_matrix[1][1], volume_matrix[1][0], volume_matrix[1][1] };
+    const float32x4_t left_volume = vld1q_f32(left_volumes);
+    const float32x4_t right_volume = vld1q_f32(right_volumes);
+    const float32x4_t min = vdupq_n_f32(-1.0f);
+    const float32x4_t max = vdupq_n_f32(1.0f);
+
+    // 2 frames per iteration
+    int frame = 0;
+    for (; frame + 2 <= nb_frames; frame += 2) {
+        const float32x4_t samples = vld1q_f32(src + 2 * frame);
+        const float32x4_t left = vtrn1q_f32(samples, samples);
+        const float32x4_t right = vtrn2q_f32(samples, samples);
+        // no multiply-add, it would round differently
+        float32x4_t result = vaddq_f32(vld1q_f32(dest + 2 * frame), vmulq_f32(left, left_volume));
+        result = vaddq_f32(result, vmulq_f32(right, right_volume));
+        vst1q_f32(dest + 2 * frame, vminq_f32(vmaxq_f32(result, min), max));
+    }
+
+    mix_stereo_basic(dest + 2 * frame, src + 2 * frame, nb_frames - frame, volume_matrix);
+}
+
+void convert_to_s16(int16_t *dest, const float *src, int nb_samples) {
+    const float32x4_t scale = vdupq_n_f32(32768.0f);
+    const float32x4_t min = vdupq_n_f32(-32768.0f);
+    const float32x4_t max = vdupq_n_f32(32767.0f);
+
+    int i = 0;
+    for (; i + 8 <= nb_samples; i += 8) {
+        const int32x4_t low = vcvtq_s32_f32(vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + i), scale), min), max));
+        const int32x4_t high = vcvtq_s32_f32(vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(src + i + 4), scale), min), max));
+        vst1q_s16(dest + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+
+    convert_to_s16_basic(dest + i, src + i, nb_samples - i);
+}
+#else
+static void mix_stereo_SSE2(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) {
+    // volumes applied to the left and to the right source channel
+    const __m128 left_volume = _mm_setr_ps(volume_matrix[0][0], volume_matrix[0][1], volume_matrix[0][0], volume_matrix[0][1]);
+    const __m128 right_volume = _mm_setr_ps(volume_matrix[1][0], volume_matrix[1][1], volume_matrix[1][0], volume_matrix[1][1]);
+    const __m128 min = _mm_set1_ps(-1.0f);
+    const __m128 max = _mm_set1_ps(1.0f);
+
+    // 2 frames per iteration
+    int frame = 0;
+    for (; frame + 2 <= nb_frames; frame += 2) {
+        const __m128 samples = _mm_loadu_ps(src + 2 * frame);
+        const __m128 left = _mm_shuffle_ps(samples, samples, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 right = _mm_shuffle_ps(samples, samples, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 result = _mm_add_ps(_mm_loadu_ps(dest + 2 * frame), _mm_mul_ps(left, left_volume));
+        result = _mm_add_ps(result, _mm_mul_ps(right, right_volume));
+        _mm_storeu_ps(dest + 2 * frame, _mm_min_ps(_mm_max_ps(result, min), max));
+    }
+
+    mix_stereo_basic(dest + 2 * frame, src + 2 * frame, nb_frames - frame, volume_matrix);
+}
+
+static void convert_to_s16_SSE2(int16_t *dest, const float *src, int nb_samples) {
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 min = _mm_set1_ps(-32768.0f);
+    const __m128 max = _mm_set1_ps(32767.0f);
+
+    int i = 0;
+    for (; i + 8 <= nb_samples; i += 8) {
+        // truncate like the cast of the basic implementation
+        const __m128i low = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), min), max));
+        const __m128i high = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), min), max));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_packs_epi32(low, high));
+    }
+
+    convert_to_s16_basic(dest + i, src + i, nb_samples - i);
+}
+
+static void TARGET_AVX2 mix_stereo_AVX2(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) {
+    const __m256 left_volume = _mm256_setr_ps(volume_matrix[0][0], volume_matrix[0][1], volume_matrix[0][0], volume_matrix[0][1],
+        volume_matrix[0][0], volume_matrix[0][1], volume_matrix[0][0], volume_matrix[0][1]);
+    const __m256 right_volume = _mm256_setr_ps(volume_matrix[1][0], volume_matrix[1][1], volume_matrix[1][0], volume_matrix[1][1],
+        volume_matrix[1][0], volume_matrix[1][1], volume_matrix[1][0], volume_matrix[1][1]);
+    const __m256 min = _mm256_set1_ps(-1.0f);
+    const __m256 max = _mm256_set1_ps(1.0f);
+
+    // 4 frames per iteration
+    int frame = 0;
+    for (; frame + 4 <= nb_frames; frame += 4) {
+        const __m256 samples = _mm256_loadu_ps(src + 2 * frame);
+        const __m256 left = _mm256_moveldup_ps(samples);
+        const __m256 right = _mm256_movehdup_ps(samples);
+        __m256 result = _mm256_add_ps(_mm256_loadu_ps(dest + 2 * frame), _mm256_mul_ps(left, left_volume));
+        result = _mm256_add_ps(result, _mm256_mul_ps(right, right_volume));
+        _mm256_storeu_ps(dest + 2 * frame, _mm256_min_ps(_mm256_max_ps(result, min), max));
+    }
+
+    mix_stereo_basic(dest + 2 * frame, src + 2 * frame, nb_frames - frame, volume_matrix);
+}
+
+static void TARGET_AVX2 convert_to_s16_AVX2(int16_t *dest, const float *src, int nb_samples) {
+    const __m256 scale = _mm256_set1_ps(32768.0f);
+    const __m256 min = _mm256_set1_ps(-32768.0f);
+    const __m256 max = _mm256_set1_ps(32767.0f);
+
+    int i = 0;
+    for (; i + 16 <= nb_samples; i += 16) {
+        const __m256i low = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), min), max));
+        const __m256i high = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), scale), min), max));
+        // the pack works on each 128-bit lane, put the 64-bit blocks back in order
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), packed);
+    }
+
+    convert_to_s16_basic(dest + i, src + i, nb_samples - i);
+}
+
+// use function variables as imitation of self-modifying code, the implementation is selected on first use
+static void mix_stereo_init(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]);
+static void convert_to_s16_init(int16_t *dest, const float *src, int nb_samples);
+
+static void (*mix_stereo_var)(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) = mix_stereo_init;
+static void (*convert_to_s16_var)(int16_t *dest, const float *src, int nb_samples) = convert_to_s16_init;
+
+static void select_dsp() {
+    if (util::instrset::instrset_detect() >= util::instrset::instrset_AVX2) {
+        mix_stereo_var = mix_stereo_AVX2;
+        convert_to_s16_var = convert_to_s16_AVX2;
+        LOG_INFO("AVX2 instruction set is supported. Using AVX2 NGS voice mixing");
+    } else {
+        mix_stereo_var = mix_stereo_SSE2;
+        convert_to_s16_var = convert_to_s16_SSE2;
+        LOG_INFO("AVX2 instruction set is not supported. Using SSE2 NGS voice mixing");
+    }
+}
+
+void mix_stereo_init(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) {
+    select_dsp();
+    (*mix_stereo_var)(dest, src, nb_frames, volume_matrix);
+}
+
+void convert_to_s16_init(int16_t *dest, const float *src, int nb_samples) {
+    select_dsp();
+    (*convert_to_s16_var)(dest, src, nb_samples);
+}
+
+void mix_stereo(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) {
+    (*mix_stereo_var)(dest, src, nb_frames, volume_matrix);
+}
+
+void convert_to_s16(int16_t *dest, const float *src, int nb_samples) {
+    (*convert_to_s16_var)(dest, src, nb_samples);
+}
+#endif
+} // namespace ngs::dsp
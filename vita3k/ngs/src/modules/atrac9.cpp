@@ -22,10 +22,24 @@ extern "C" {
 #include <libswresample/swresample.h>
 }
 
+#include <numbers>
+
 namespace ngs {
 
-SwrContext *Atrac9Module::swr_mono_to_stereo = nullptr;
-SwrContext *Atrac9Module::swr_stereo = nullptr;
+// same result as converting with swresample: the mono channel is put in both channels at -3dB
+static void convert_s16_to_stereo_flt(float *dest, const int16_t *src, uint32_t nb_samples, uint32_t nb_channels) {
+    constexpr float scale = 1.0f / 32768.0f;
+    if (nb_channels == 1) {
+        const float mono_scale = scale / std::numbers::sqrt2_v<float>;
+        for (uint32_t i = 0; i < nb_samples; i++) {
+            dest[2 * i] = src[i] * mono_scale;
+            dest[2 * i + 1] = src[i] * mono_scale;
+        }
+    } else {
+        for (uint32_t i = 0; i < 2 * nb_samples; i++)
+            dest[i] = src[i] * scale;
+    }
+}
 
 void Atrac9Module::on_state_change(const MemState &mem, ModuleData &data, const VoiceState previous) {
     SceNgsAT9States *state = data.get_state<SceNgsAT9States>();
@@ -36,9 +50,10 @@ void Atrac9Module::on_state_change(const MemState &mem, ModuleData &data, const
         state->current_loop_count = 0;
         state->current_buffer = 0;
 
-        memset(&state->saved_state, 0, sizeof(state->saved_state));
-        if (last_state == state)
-            last_state = nullptr;
+        Atrac9Scratch *scratch = data.get_scratch<Atrac9Scratch>();
+        if (scratch->decoder)
+            scratch->decoder->flush();
+        scratch->temp_buffer.clear();
     } else if (data.parent->is_keyed_off) {
         state->current_byte_position_in_buffer = 0;
         state->current_loop_count = 0;
@@ -59,28 +74,20 @@ void Atrac9Module::on_param_change(const MemState &mem, ModuleData &data) {
 
 bool Atrac9Module::decode_more_data(KernelState &kern, const MemState &mem, const SceUID thread_id, ModuleData &data, const SceNgsAT9Params *params, SceNgsAT9States *state, std::unique_lock<std::recursive_mutex> &scheduler_lock, std::unique_lock<std::mutex> &voice_lock) {
     const SceNgsAT9BufferParams &bufparam = params->buffer_params[state->current_buffer];
+    Atrac9Scratch *scratch = data.get_scratch<Atrac9Scratch>();
+    std::vector<uint8_t> &temp_buffer = scratch->temp_buffer;
 
     if (!data.extra_storage.empty()) {
         data.extra_storage.erase(data.extra_storage.begin(), data.extra_storage.begin() + state->decoded_passed * sizeof(float) * 2);
         state->decoded_passed = 0;
     }
 
-    if (decoder && last_state != nullptr && last_state != state) {
-        // we changed voices, need to export the previous data
-        decoder->export_state(&last_state->saved_state);
-    }
-
     // re-create the decoder if necessary
-    if (!decoder || params->config_data != last_config) {
-        decoder = std::make_unique<Atrac9DecoderState>(params->config_data);
-        last_config = params->config_data;
-    }
-
-    if (last_state != state) {
-        // we changed voices, need to import the new decoder state
-        decoder->load_state(&state->saved_state);
-        last_state = state;
+    if (!scratch->decoder || params->config_data != scratch->config) {
+        scratch->decoder = std::make_unique<Atrac9DecoderState>(params->config_data);
+        scratch->config = params->config_data;
     }
+    Atrac9DecoderState *decoder = scratch->decoder.get();
 
     if (state->current_byte_position_in_buffer >= bufparam.bytes_count) {
         const int32_t prev_index = state->current_buffer;
@@ -186,7 +193,8 @@ bool Atrac9Module::decode_more_data(KernelState &kern, const MemState &mem, cons
         }
     }
 
-    std::vector<uint8_t> decoded_superframe_samples(decoder->get(DecoderQuery::AT9_SAMPLE_PER_SUPERFRAME) * sizeof(float) * 2);
+    scratch->superframe_samples.resize(samples_per_superframe * 2);
+    float *decoded_superframe_samples = scratch->superframe_samples.data();
     uint32_t decoded_superframe_pos = 0;
     bool got_decode_error = false;
     // decode a whole superframe at a time
@@ -198,49 +206,18 @@ bool Atrac9Module::decode_more_data(KernelState &kern, const MemState &mem, cons
 
         // convert from int16 to float
         uint32_t const channel_count = decoder->get(DecoderQuery::CHANNELS);
-        std::vector<uint8_t> temporary_bytes(samples_per_frame * sizeof(int16_t) * channel_count);
+        scratch->frame_samples.resize(samples_per_frame * channel_count);
         DecoderSize decoder_size;
-        decoder->receive(temporary_bytes.data(), &decoder_size);
-
-        SwrContext *swr;
-        if (channel_count == 1) {
-            if (!swr_mono_to_stereo) {
-                AVChannelLayout layout_mono = AV_CHANNEL_LAYOUT_MONO;
-                AVChannelLayout layout_stereo = AV_CHANNEL_LAYOUT_STEREO;
-
-                int ret = swr_alloc_set_opts2(&swr_mono_to_stereo,
-                    &layout_stereo, AV_SAMPLE_FMT_FLT, 480000,
-                    &layout_mono, AV_SAMPLE_FMT_S16, 480000,
-                    0, nullptr);
-                assert(ret == 0);
-                ret = swr_init(swr_mono_to_stereo);
-                assert(ret == 0);
-            }
-
-            swr = swr_mono_to_stereo;
-        } else {
-            if (!swr_stereo) {
-                AVChannelLayout layout_stereo = AV_CHANNEL_LAYOUT_STEREO;
-                int ret = swr_alloc_set_opts2(&swr_stereo,
-                    &layout_stereo, AV_SAMPLE_FMT_FLT, 480000,
-                    &layout_stereo, AV_SAMPLE_FMT_S16, 480000,
-                    0, nullptr);
-                assert(ret == 0);
-                ret = swr_init(swr_stereo);
-                assert(ret == 0);
-            }
+        decoder->receive(reinterpret_cast<uint8_t *>(scratch->frame_samples.data()), &decoder_size);
 
-            swr = swr_stereo;
-        }
-
-        const uint8_t *swr_data_in = temporary_bytes.data();
-        uint8_t *swr_data_out = decoded_superframe_samples.data() + decoded_superframe_pos;
-        const int result = swr_convert(swr, &swr_data_out, decoder_size.samples, &swr_data_in, decoder_size.samples);
+        convert_s16_to_stereo_flt(decoded_superframe_samples + decoded_superframe_pos, scratch->frame_samples.data(), decoder_size.samples, channel_count);
 
-        decoded_superframe_pos += decoder_size.samples * sizeof(float) * 2;
+        decoded_superframe_pos += decoder_size.samples * 2;
         input += decoder->get_es_size();
         state->current_byte_position_in_buffer += decoder->get_es_size();
     }
+    if (got_decode_error)
+        std::fill(scratch->superframe_samples.begin() + decoded_superframe_pos, scratch->superframe_samples.end(), 0.0f);
 
     const int32_t sample_rate = data.parent->rack->system->sample_rate;
     if (params->playback_scalar != 1 || static_cast<int>(round(params->playback_frequency)) != sample_rate) {
@@ -264,24 +241,22 @@ bool Atrac9Module::decode_more_data(KernelState &kern, const MemState &mem, cons
         }
         // assume the skipped samples happen before the scaling
         int scaled_samples_amount = swr_get_out_samples(state->swr, decoded_size);
-        std::vector<uint8_t> scaled_data(scaled_samples_amount * sizeof(float) * 2, 0);
 
-        uint8_t *scaled_dest_data = scaled_data.data();
-        const uint8_t *scaled_src_data = decoded_superframe_samples.data() + decoded_start_offset * sizeof(float) * 2;
+        // Make room for the result of the scaling process in the queue for the final audio buffer and resample directly into it
+        data.extra_storage.resize(curr_pos + scaled_samples_amount * sizeof(float) * 2);
+        uint8_t *scaled_dest_data = data.extra_storage.data() + curr_pos;
+        const uint8_t *scaled_src_data = reinterpret_cast<const uint8_t *>(decoded_superframe_samples + decoded_start_offset * 2);
         scaled_samples_amount = swr_convert(state->swr, &scaled_dest_data, scaled_samples_amount, &scaled_src_data, decoded_size);
         assert(scaled_samples_amount > 0);
 
-        // Allocate memory to accommodate the result of the scaling process into the queue for the final audio buffer
+        scaled_samples_amount = std::max(scaled_samples_amount, 0);
         data.extra_storage.resize(curr_pos + scaled_samples_amount * sizeof(float) * 2);
-
-        // Pass scaled audio data into the queue for the final audio buffer
-        memcpy(data.extra_storage.data() + curr_pos, scaled_data.data(), scaled_samples_amount * sizeof(float) * 2);
         decoded_size = scaled_samples_amount;
 
     } else {
         data.extra_storage.resize(curr_pos + decoded_size * sizeof(float) * 2);
 
-        memcpy(data.extra_storage.data() + curr_pos, decoded_superframe_samples.data() + decoded_start_offset * sizeof(float) * 2, decoded_size * sizeof(float) * 2);
+        memcpy(data.extra_storage.data() + curr_pos, decoded_superframe_samples + decoded_start_offset * 2, decoded_size * sizeof(float) * 2);
     }
 
     if (got_decode_error) {
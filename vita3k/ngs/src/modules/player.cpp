@@ -93,11 +93,13 @@ bool PlayerModule::process(KernelState &kern, const MemState &mem, const SceUID
     if (params->channels == 0)
         params->channels = 2;
 
+    PlayerScratch *scratch = data.get_scratch<PlayerScratch>();
     // If decoder hasn't been initialized
-    if (!decoder) {
+    if (!scratch->decoder) {
         // Create decoder specifying the desired destination sample rate
-        decoder = std::make_unique<PCMDecoderState>(static_cast<float>(sample_rate));
+        scratch->decoder = std::make_unique<PCMDecoderState>(static_cast<float>(sample_rate));
     }
+    PCMDecoderState *decoder = scratch->decoder.get();
 
     // If the amount of samples already processed and pending to be passed is smaller than the amount of samples of the audio buffer
     if (static_cast<int>(state->decoded_samples_pending) < granularity) {
@@ -215,10 +217,10 @@ bool PlayerModule::process(KernelState &kern, const MemState &mem, const SceUID
                     LOG_INFO_ONCE("The currently running game requests playback rate scaling when decoding audio. Audio might crackle.");
 
                     // Received decoded samples from decoder
-                    std::vector<uint8_t> decoded_data(samples_count.samples * sizeof(float) * 2, 0);
+                    scratch->decoded.resize(samples_count.samples * sizeof(float) * 2);
 
                     // Receive the samples processed by the decoder
-                    decoder->receive(decoded_data.data(), nullptr);
+                    decoder->receive(scratch->decoded.data(), nullptr);
 
                     // resample the audio
                     if (params->playback_scalar != 1.0f)
@@ -240,21 +242,18 @@ bool PlayerModule::process(KernelState &kern, const MemState &mem, const SceUID
                         state->reset_swr = false;
                     }
                     int scaled_samples_amount = swr_get_out_samples(state->swr, samples_count.samples);
-                    std::vector<uint8_t> scaled_data(scaled_samples_amount * sizeof(float) * 2, 0);
-
-                    uint8_t *scaled_dest_data = scaled_data.data();
-                    const uint8_t *scaled_src_data = decoded_data.data();
-                    scaled_samples_amount = swr_convert(state->swr, &scaled_dest_data, scaled_samples_amount, &scaled_src_data, samples_count.samples);
-                    assert(scaled_samples_amount > 0);
 
                     // Get current size of audio queue for processed samples in memory
                     const uint32_t current_count = state->decoded_samples_pending * sizeof(float) * 2;
 
-                    // Allocate memory to accommodate the result of the scaling process into the queue for the final audio buffer
+                    // Make room for the result of the scaling process in the queue for the final audio buffer and resample directly into it
                     data.extra_storage.resize(current_count + scaled_samples_amount * sizeof(float) * 2);
+                    uint8_t *scaled_dest_data = data.extra_storage.data() + current_count;
+                    const uint8_t *scaled_src_data = scratch->decoded.data();
+                    scaled_samples_amount = swr_convert(state->swr, &scaled_dest_data, scaled_samples_amount, &scaled_src_data, samples_count.samples);
+                    assert(scaled_samples_amount > 0);
 
-                    // Pass scaled audio data into the queue for the final audio buffer
-                    memcpy(data.extra_storage.data() + current_count, scaled_data.data(), scaled_samples_amount * sizeof(float) * 2);
+                    data.extra_storage.resize(current_count + std::max(scaled_samples_amount, 0) * sizeof(float) * 2);
 
                 } else {
                     // Get current size of audio buffer for processed samples in memory
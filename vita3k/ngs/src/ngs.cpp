@@ -18,6 +18,7 @@
 #include <cpu/functions.h>
 #include <kernel/state.h>
 
+#include <ngs/dsp.h>
 #include <ngs/state.h>
 #include <ngs/system.h>
 #include <util/lock_and_find.h>
@@ -86,12 +87,7 @@ int32_t VoiceInputManager::receive(ngs::Patch *patch, const VoiceProduct &produc
 
     // Try mixing, also with the use of this volume matrix
     // Dest is our voice to receive this data.
-    for (int32_t k = 0; k < patch->dest->rack->system->granularity; k++) {
-        dest_buffer[k * 2] = std::clamp(dest_buffer[k * 2] + data_to_mix_in[k * 2] * volume_matrix[0][0]
-                + data_to_mix_in[k * 2 + 1] * volume_matrix[1][0],
-            -1.0f, 1.0f);
-        dest_buffer[k * 2 + 1] = std::clamp(dest_buffer[k * 2 + 1] + data_to_mix_in[k * 2] * volume_matrix[0][1] + data_to_mix_in[k * 2 + 1] * volume_matrix[1][1], -1.0f, 1.0f);
-    }
+    dsp::mix_stereo(dest_buffer, data_to_mix_in, patch->dest->rack->system->granularity, volume_matrix);
 
     return 0;
 }
@@ -321,20 +317,23 @@ void Voice::invoke_callback(KernelState &kernel, const MemState &mem, const SceU
         return;
     }
 
-    const ThreadStatePtr thread = kernel.get_thread(thread_id);
-    const Address callback_info_addr = stack_alloc(*thread->cpu, sizeof(SceNgsCallbackInfo));
-
-    SceNgsCallbackInfo *info = Ptr<SceNgsCallbackInfo>(callback_info_addr).get(mem);
-    info->rack_handle = Ptr<void>(rack, mem);
-    info->voice_handle = Ptr<void>(this, mem);
-    info->module_id = module_id;
-    info->callback_reason = reason1;
-    info->callback_reason_2 = reason2;
-    info->callback_ptr = Ptr<void>(reason_ptr);
-    info->userdata = user_data;
-
-    thread->run_callback(callback.address(), { callback_info_addr });
-    stack_free(*thread->cpu, sizeof(SceNgsCallbackInfo));
+    // guest code must be run by the thread updating the system
+    rack->system->voice_scheduler.run_callback([&]() {
+        const ThreadStatePtr thread = kernel.get_thread(thread_id);
+        const Address callback_info_addr = stack_alloc(*thread->cpu, sizeof(SceNgsCallbackInfo));
+
+        SceNgsCallbackInfo *info = Ptr<SceNgsCallbackInfo>(callback_info_addr).get(mem);
+        info->rack_handle = Ptr<void>(rack, mem);
+        info->voice_handle = Ptr<void>(this, mem);
+        info->module_id = module_id;
+        info->callback_reason = reason1;
+        info->callback_reason_2 = reason2;
+        info->callback_ptr = Ptr<void>(reason_ptr);
+        info->userdata = user_data;
+
+        thread->run_callback(callback.address(), { callback_info_addr });
+        stack_free(*thread->cpu, sizeof(SceNgsCallbackInfo));
+    });
 }
 
 uint32_t System::get_required_memspace_size(SceNgsSystemInitParams *parameters) {
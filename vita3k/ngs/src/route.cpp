@@ -20,7 +20,7 @@
 #include <util/vector_utils.h>
 
 namespace ngs {
-bool deliver_data(const MemState &mem, const std::vector<Voice *> &voice_queue, Voice *source, const uint8_t output_port,
+bool deliver_data(const MemState &mem, const std::span<Voice *const> voice_queue, Voice *source, const uint8_t output_port,
     const VoiceProduct &data_to_deliver) {
     if (!data_to_deliver.data) {
         return false;
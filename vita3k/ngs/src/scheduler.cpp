@@ -22,6 +22,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <functional>
+#include <span>
 #include <util/vector_utils.h>
 
 namespace ngs {
@@ -117,56 +119,260 @@ bool VoiceScheduler::off(const MemState &mem, Voice *voice) {
     return true;
 }
 
-void VoiceScheduler::update(KernelState &kern, const MemState &mem, const SceUID thread_id) {
-    std::unique_lock<std::recursive_mutex> scheduler_lock(mutex);
-    is_updating = true;
+// the voices of a system are short to process, a few workers are enough
+static constexpr uint32_t MAX_NGS_WORKERS = 3;
 
-    // make a copy of the queue, this way we have no issue if it is modified in a callback
-    std::vector<ngs::Voice *> queue_copy = queue;
+// scheduler whose voices the current thread is processing, if it is one of its workers
+static thread_local const VoiceScheduler *worker_scheduler = nullptr;
 
-    // Do a first routine to clear inputs from previous update session
-    for (ngs::Voice *voice : queue_copy) {
-        voice->inputs.reset_inputs();
+// return true if one of the modules is done with the voice
+static bool process_voice(KernelState &kern, const MemState &mem, const SceUID thread_id, Voice *voice, uint32_t &finished_module,
+    std::unique_lock<std::recursive_mutex> &scheduler_lock, std::unique_lock<std::mutex> &voice_lock) {
+    memset(voice->products, 0, sizeof(voice->products));
+
+    bool finished = false;
+    for (size_t i = 0; i < voice->rack->modules.size(); i++) {
+        if (voice->rack->modules[i]) {
+            if (voice->rack->modules[i]->process(kern, mem, thread_id, voice->datas[i], scheduler_lock, voice_lock)) {
+                finished = true;
+                finished_module = voice->rack->modules[i]->module_id();
+            }
+        }
     }
 
-    for (ngs::Voice *voice : queue_copy) {
+    return finished;
+}
+
+void VoiceScheduler::finish_voice(KernelState &kern, const MemState &mem, const SceUID thread_id, const std::vector<Voice *> &queue_copy, size_t position,
+    bool finished, uint32_t finished_module, std::unique_lock<std::recursive_mutex> &scheduler_lock, std::unique_lock<std::mutex> &voice_lock) {
+    Voice *voice = queue_copy[position];
+    if (finished) {
+        voice->is_keyed_off = true;
+        voice->transition(mem, VOICE_STATE_FINALIZING);
+        if (voice->finished_callback) {
+            voice_lock.unlock();
+            scheduler_lock.unlock();
+            voice->invoke_callback(kern, mem, thread_id, voice->finished_callback, voice->finished_callback_user_data, finished_module);
+            scheduler_lock.lock();
+            voice_lock.lock();
+        }
+        voice->is_keyed_off = false;
+
+        stop(mem, voice);
+    }
+
+    // the voices before this one in the queue are already processed, their inputs are reset before the next update anyway
+    const std::span<Voice *const> next_voices = std::span(queue_copy).subspan(position + 1);
+    for (size_t i = 0; i < voice->rack->vdef->output_count; i++) {
+        if (voice->products[i].data)
+            deliver_data(mem, next_voices, voice, static_cast<uint8_t>(i), voice->products[i]);
+    }
+
+    voice->frame_count++;
+}
+
+void VoiceScheduler::update_serial(KernelState &kern, const MemState &mem, const SceUID thread_id, const std::vector<Voice *> &queue_copy, std::unique_lock<std::recursive_mutex> &scheduler_lock) {
+    for (size_t position = 0; position < queue_copy.size(); position++) {
         // Modify the state, in peace....
-        std::unique_lock<std::mutex> voice_lock(*voice->voice_mutex);
-        memset(voice->products, 0, sizeof(voice->products));
+        std::unique_lock<std::mutex> voice_lock(*queue_copy[position]->voice_mutex);
 
-        bool finished = false;
         uint32_t finished_module = 0;
+        const bool finished = process_voice(kern, mem, thread_id, queue_copy[position], finished_module, scheduler_lock, voice_lock);
+        finish_voice(kern, mem, thread_id, queue_copy, position, finished, finished_module, scheduler_lock, voice_lock);
+    }
+}
 
-        for (size_t i = 0; i < voice->rack->modules.size(); i++) {
-            if (voice->rack->modules[i]) {
-                if (voice->rack->modules[i]->process(kern, mem, thread_id, voice->datas[i], scheduler_lock, voice_lock)) {
-                    finished = true;
-                    finished_module = voice->rack->modules[i]->module_id();
-                }
+void VoiceScheduler::update_parallel(KernelState &kern, const MemState &mem, const SceUID thread_id, const std::vector<Voice *> &queue_copy, std::unique_lock<std::recursive_mutex> &scheduler_lock) {
+    if (!thread_pool)
+        thread_pool = std::make_unique<ThreadPool>(std::min(std::max(std::thread::hardware_concurrency(), 2U) - 1, MAX_NGS_WORKERS));
+
+    // the queue is sorted so that a voice comes after the voices delivering data to it:
+    // a voice is in the level after the last level of these voices, and the voices of a level are independent
+    queue_positions.clear();
+    for (size_t i = 0; i < queue_copy.size(); i++)
+        queue_positions[queue_copy[i]] = i;
+
+    voice_levels.assign(queue_copy.size(), 0);
+    uint32_t nb_levels = queue_copy.empty() ? 0 : 1;
+    for (size_t i = 0; i < queue_copy.size(); i++) {
+        for (const auto &patches : queue_copy[i]->patches) {
+            for (const auto &patch_ptr : patches) {
+                const Patch *patch = patch_ptr.get(mem);
+                if (!patch || patch->output_sub_index == -1)
+                    continue;
+
+                // nothing is delivered to the voices before this one, see finish_voice
+                const auto dest = queue_positions.find(patch->dest);
+                if (dest == queue_positions.end() || dest->second <= i)
+                    continue;
+
+                voice_levels[dest->second] = std::max(voice_levels[dest->second], voice_levels[i] + 1);
+                nb_levels = std::max(nb_levels, voice_levels[dest->second] + 1);
             }
         }
-        if (finished) {
-            voice->is_keyed_off = true;
-            voice->transition(mem, VOICE_STATE_FINALIZING);
-            if (voice->finished_callback) {
-                voice_lock.unlock();
-                scheduler_lock.unlock();
-                voice->invoke_callback(kern, mem, thread_id, voice->finished_callback, voice->finished_callback_user_data, finished_module);
-                scheduler_lock.lock();
-                voice_lock.lock();
-            }
-            voice->is_keyed_off = false;
+    }
 
-            stop(mem, voice);
+    struct VoiceResult {
+        bool finished = false;
+        uint32_t finished_module = 0;
+    };
+
+    // positions in the queue of the voices of the level
+    std::vector<size_t> level_voices;
+    std::vector<VoiceResult> results;
+
+    update_thread = std::this_thread::get_id();
+    for (uint32_t level = 0; level < nb_levels; level++) {
+        level_voices.clear();
+        for (size_t i = 0; i < queue_copy.size(); i++) {
+            if (voice_levels[i] == level)
+                level_voices.push_back(i);
         }
 
-        for (size_t i = 0; i < voice->rack->vdef->output_count; i++) {
-            if (voice->products[i].data)
-                deliver_data(mem, queue_copy, voice, static_cast<uint8_t>(i), voice->products[i]);
+        results.assign(level_voices.size(), {});
+        const auto process_voice_task = [&](size_t i) {
+            // the scheduler lock belongs to the update thread, the modules processed by a worker
+            // get one of their own to release around the callbacks, which are run by the update thread
+            std::recursive_mutex worker_mutex;
+            std::unique_lock<std::recursive_mutex> worker_lock(worker_mutex);
+            const bool is_update_thread = std::this_thread::get_id() == update_thread;
+            std::unique_lock<std::recursive_mutex> &task_scheduler_lock = is_update_thread ? scheduler_lock : worker_lock;
+
+            begin_task();
+            worker_scheduler = this;
+
+            Voice *voice = queue_copy[level_voices[i]];
+            std::unique_lock<std::mutex> voice_lock(*voice->voice_mutex);
+            results[i].finished = process_voice(kern, mem, thread_id, voice, results[i].finished_module, task_scheduler_lock, voice_lock);
+            voice_lock.unlock();
+
+            worker_scheduler = nullptr;
+            end_task();
+        };
+        thread_pool->parallel_for(level_voices.size(), process_voice_task, [&]() { run_pending_callbacks(scheduler_lock); });
+
+        // finish the voices in the queue order, so the data is always delivered in the same order
+        for (size_t i = 0; i < level_voices.size(); i++) {
+            std::unique_lock<std::mutex> voice_lock(*queue_copy[level_voices[i]]->voice_mutex);
+            finish_voice(kern, mem, thread_id, queue_copy, level_voices[i], results[i].finished, results[i].finished_module, scheduler_lock, voice_lock);
         }
+    }
+}
+
+// The tasks count themselves as running while they process a voice, guest callbacks are only run once
+// none of them is, and no task may start or go on processing a voice until they are done.
+// callbacks_mutex must be locked for all the functions taking its lock.
+void VoiceScheduler::begin_task() {
+    std::unique_lock<std::mutex> lock(callbacks_mutex);
+    callbacks_cond.wait(lock, [&]() { return !running_callbacks; });
+    running_tasks++;
+}
 
-        voice->frame_count++;
+void VoiceScheduler::end_task() {
+    const std::lock_guard<std::mutex> guard(callbacks_mutex);
+    running_tasks--;
+    callbacks_cond.notify_all();
+}
+
+void VoiceScheduler::stop_tasks(std::unique_lock<std::mutex> &lock) {
+    running_callbacks = true;
+    callbacks_cond.wait(lock, [&]() { return running_tasks == 0; });
+}
+
+void VoiceScheduler::resume_tasks() {
+    running_callbacks = false;
+    callbacks_cond.notify_all();
+}
+
+void VoiceScheduler::run_requested_callbacks(std::unique_lock<std::mutex> &lock) {
+    while (!callbacks_pending.empty()) {
+        CallbackRequest *request = callbacks_pending.front();
+        callbacks_pending.erase(callbacks_pending.begin());
+        lock.unlock();
+
+        (*request->callback)();
+
+        lock.lock();
+        request->done = true;
+        callbacks_cond.notify_all();
     }
+}
+
+void VoiceScheduler::run_pending_callbacks(std::unique_lock<std::recursive_mutex> &scheduler_lock) {
+    std::unique_lock<std::mutex> lock(callbacks_mutex);
+    if (callbacks_pending.empty())
+        return;
+
+    // guest code can use the voices once the scheduler lock is released, no task must be processing one then
+    stop_tasks(lock);
+
+    // same as when the module runs the callback itself
+    scheduler_lock.unlock();
+    run_requested_callbacks(lock);
+    lock.unlock();
+    scheduler_lock.lock();
+
+    lock.lock();
+    resume_tasks();
+}
+
+void VoiceScheduler::run_callback(const std::function<void()> &callback) {
+    if (worker_scheduler != this) {
+        callback();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(callbacks_mutex);
+    if (std::this_thread::get_id() == update_thread) {
+        // the module released the scheduler lock, wait for the workers to be done with their voice
+        // or to wait for their own callback, which is run at the same time
+        running_tasks--;
+        stop_tasks(lock);
+        lock.unlock();
+
+        // the callback may update the system again, this is not done as part of this task
+        worker_scheduler = nullptr;
+        callback();
+        worker_scheduler = this;
+
+        lock.lock();
+        run_requested_callbacks(lock);
+        resume_tasks();
+        running_tasks++;
+        return;
+    }
+
+    CallbackRequest request{ &callback };
+    callbacks_pending.push_back(&request);
+    running_tasks--;
+    callbacks_cond.notify_all();
+    lock.unlock();
+    thread_pool->wake_caller();
+
+    // the voices of the other tasks may only be processed again once all the callbacks are done
+    lock.lock();
+    callbacks_cond.wait(lock, [&]() { return request.done && !running_callbacks; });
+    running_tasks++;
+}
+
+void VoiceScheduler::update(KernelState &kern, const MemState &mem, const SceUID thread_id) {
+    std::unique_lock<std::recursive_mutex> scheduler_lock(mutex);
+    // a guest callback can update the system again, keep it simple in this case
+    const bool is_nested_update = is_updating;
+    is_updating = true;
+
+    // make a copy of the queue, this way we have no issue if it is modified in a callback
+    std::vector<ngs::Voice *> queue_copy = queue;
+
+    // Do a first routine to clear inputs from previous update session
+    for (ngs::Voice *voice : queue_copy) {
+        voice->inputs.reset_inputs();
+    }
+
+    if (parallel_update && !is_nested_update)
+        update_parallel(kern, mem, thread_id, queue_copy, scheduler_lock);
+    else
+        update_serial(kern, mem, thread_id, queue_copy, scheduler_lock);
 
     while (!operations_pending.empty()) {
         OperationPending &op = operations_pending.front();
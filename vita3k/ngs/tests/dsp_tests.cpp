@@ -0,0 +1,92 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <ngs/dsp.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+// the sizes are not multiple of the vector sizes, so the remaining frames are tested too
+static constexpr int TEST_SIZES[] = { 0, 1, 3, 7, 8, 17, 512, 515 };
+
+// samples in [-1.5, 1.5], so the clamps are used
+static std::vector<float> make_samples(size_t count, uint32_t seed) {
+    std::vector<float> samples(count);
+    for (float &sample : samples) {
+        seed = seed * 1664525 + 1013904223;
+        sample = static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * 3.0f - 1.5f;
+    }
+
+    return samples;
+}
+
+static void mix_stereo_reference(float *dest, const float *src, int nb_frames, const float volume_matrix[2][2]) {
+    for (int k = 0; k < nb_frames; k++) {
+        const float left = dest[k * 2] + src[k * 2] * volume_matrix[0][0];
+        const float right = dest[k * 2 + 1] + src[k * 2] * volume_matrix[0][1];
+        dest[k * 2] = std::clamp(left + src[k * 2 + 1] * volume_matrix[1][0], -1.0f, 1.0f);
+        dest[k * 2 + 1] = std::clamp(right + src[k * 2 + 1] * volume_matrix[1][1], -1.0f, 1.0f);
+    }
+}
+
+TEST(ngs_dsp, mix_stereo_golden) {
+    const float volume_matrix[2][2] = { { 0.5f, 0.25f }, { -0.5f, 1.0f } };
+    const float src[] = { 1.0f, 0.5f, -1.0f, 1.0f, 0.25f, -0.25f, 1.0f, 1.0f };
+    float dest[] = { 0.0f, 0.0f, 0.0f, 0.5f, 0.5f, 0.5f, -1.0f, -1.0f };
+    ngs::dsp::mix_stereo(dest, src, 4, volume_matrix);
+
+    const float expected[] = { 0.25f, 0.75f, -1.0f, 1.0f, 0.75f, 0.3125f, -1.0f, 0.25f };
+    for (int i = 0; i < 8; i++)
+        EXPECT_EQ(dest[i], expected[i]) << "sample " << i;
+}
+
+TEST(ngs_dsp, mix_stereo_matches_reference) {
+    const float volume_matrix[2][2] = { { 0.8f, 0.3f }, { 0.1f, 0.7f } };
+    for (const int nb_frames : TEST_SIZES) {
+        const std::vector<float> src = make_samples(nb_frames * 2, 1);
+        std::vector<float> dest = make_samples(nb_frames * 2, 2);
+        std::vector<float> expected = dest;
+
+        ngs::dsp::mix_stereo(dest.data(), src.data(), nb_frames, volume_matrix);
+        mix_stereo_reference(expected.data(), src.data(), nb_frames, volume_matrix);
+        for (int i = 0; i < nb_frames * 2; i++)
+            ASSERT_NEAR(dest[i], expected[i], 1e-6f) << nb_frames << " frames, sample " << i;
+    }
+}
+
+TEST(ngs_dsp, convert_to_s16_golden) {
+    const float src[] = { 0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 2.0f, -2.0f, 0.99999f, 1.0f / 32768.0f, -1.5f / 32768.0f };
+    int16_t dest[10];
+    ngs::dsp::convert_to_s16(dest, src, 10);
+
+    const int16_t expected[] = { 0, 32767, -32768, 16384, -16384, 32767, -32768, 32767, 1, -1 };
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(dest[i], expected[i]) << "sample " << i;
+}
+
+TEST(ngs_dsp, convert_to_s16_matches_reference) {
+    for (const int nb_samples : TEST_SIZES) {
+        const std::vector<float> src = make_samples(nb_samples, 3);
+        std::vector<int16_t> dest(nb_samples);
+        ngs::dsp::convert_to_s16(dest.data(), src.data(), nb_samples);
+
+        for (int i = 0; i < nb_samples; i++)
+            ASSERT_EQ(dest[i], static_cast<int16_t>(std::clamp(src[i] * 32768.0f, -32768.0f, 32767.0f))) << nb_samples << " samples, sample " << i;
+    }
+}
@@ -0,0 +1,206 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <kernel/state.h>
+#include <mem/functions.h>
+#include <mem/state.h>
+#include <ngs/modules/player.h>
+#include <ngs/state.h>
+#include <ngs/system.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+static constexpr int32_t GRANULARITY = 512;
+static constexpr int32_t SAMPLE_RATE = 48000;
+static constexpr int32_t PCM_FRAMES = SAMPLE_RATE / 4;
+
+// N player voices -> N / PLAYERS_PER_MIXER mixer voices -> 1 master voice
+struct SyntheticGraph {
+    ngs::System *system = nullptr;
+    std::vector<ngs::Voice *> players;
+    std::vector<ngs::Voice *> mixers;
+    ngs::Voice *master = nullptr;
+};
+
+static constexpr int32_t PLAYERS_PER_MIXER = 8;
+
+static ngs::Rack *make_rack(ngs::State &ngs, MemState &mem, ngs::System *system, ngs::BussType type, int32_t voice_count) {
+    SceNgsRackDescription description{};
+    description.definition = ngs::get_voice_definition(ngs, mem, type);
+    description.voice_count = voice_count;
+    description.channels_per_voice = 2;
+    description.max_patches_per_input = PLAYERS_PER_MIXER;
+    description.patches_per_output = 1;
+
+    SceNgsBufferInfo info{};
+    info.size = ngs::Rack::get_required_memspace_size(mem, &description);
+    info.data = Ptr<void>(alloc(mem, info.size, "NGS test rack"));
+    if (!ngs::init_rack(ngs, mem, system, &info, &description))
+        return nullptr;
+
+    return info.data.cast<ngs::Rack>().get(mem);
+}
+
+static void connect(MemState &mem, ngs::System *system, ngs::Voice *source, ngs::Voice *dest, float volume) {
+    SceNgsPatchSetupInfo info{};
+    info.source = Ptr<ngs::Voice>(source, mem);
+    info.source_output_index = 0;
+    info.source_output_subindex = -1;
+    info.dest = Ptr<ngs::Voice>(dest, mem);
+    info.dest_input_index = 0;
+
+    ngs::Patch *patch = system->voice_scheduler.patch(mem, &info).get(mem);
+    ASSERT_NE(patch, nullptr);
+    patch->volume_matrix[0][0] = volume;
+    patch->volume_matrix[1][1] = volume;
+}
+
+static void make_graph(ngs::State &ngs, MemState &mem, SyntheticGraph &graph, int32_t nb_players, Ptr<int16_t> pcm, float playback_frequency = SAMPLE_RATE) {
+    SceNgsSystemInitParams params{};
+    params.max_racks = 3;
+    params.max_voices = nb_players + nb_players / PLAYERS_PER_MIXER + 1;
+    params.granularity = GRANULARITY;
+    params.sample_rate = SAMPLE_RATE;
+
+    const Ptr<void> memspace(alloc(mem, ngs::System::get_required_memspace_size(&params), "NGS test system"));
+    ASSERT_TRUE(ngs::init_system(ngs, mem, &params, memspace, ngs::System::get_required_memspace_size(&params)));
+    graph.system = memspace.cast<ngs::System>().get(mem);
+
+    ngs::Rack *player_rack = make_rack(ngs, mem, graph.system, ngs::BussType::BUSS_SIMPLE, nb_players);
+    ngs::Rack *mixer_rack = make_rack(ngs, mem, graph.system, ngs::BussType::BUSS_MIXER, nb_players / PLAYERS_PER_MIXER);
+    ngs::Rack *master_rack = make_rack(ngs, mem, graph.system, ngs::BussType::BUSS_MASTER, 1);
+    ASSERT_TRUE(player_rack && mixer_rack && master_rack);
+
+    for (const auto &voice : player_rack->voices)
+        graph.players.push_back(voice.get(mem));
+    for (const auto &voice : mixer_rack->voices)
+        graph.mixers.push_back(voice.get(mem));
+    graph.master = master_rack->voices[0].get(mem);
+
+    for (size_t i = 0; i < graph.players.size(); i++) {
+        ngs::Voice *player = graph.players[i];
+        auto *player_params = player->datas[0].get_parameters<SceNgsPlayerParams>(mem);
+        memset(player_params, 0, sizeof(SceNgsPlayerParams));
+        player_params->descriptor.id = SCE_NGS_PLAYER_PARAMS_STRUCT_ID;
+        player_params->descriptor.size = sizeof(SceNgsPlayerParams);
+        // each player starts somewhere else in the same looping buffer
+        new (&player_params->buffer_params[0]) SceNgsPlayerBufferParams{ pcm.cast<void>(), PCM_FRAMES * 2 * sizeof(int16_t), -1, -1 };
+        player_params->playback_frequency = playback_frequency;
+        player_params->playback_scalar = 1.0f;
+        player_params->start_bytes = static_cast<int32_t>((i * 997) % PCM_FRAMES) * 2 * sizeof(int16_t);
+        player_params->channels = 2;
+
+        connect(mem, graph.system, player, graph.mixers[i / PLAYERS_PER_MIXER], 1.0f / PLAYERS_PER_MIXER);
+    }
+    for (ngs::Voice *mixer : graph.mixers)
+        connect(mem, graph.system, mixer, graph.master, 1.0f / graph.mixers.size());
+
+    graph.system->voice_scheduler.play(mem, graph.master);
+    for (ngs::Voice *mixer : graph.mixers)
+        graph.system->voice_scheduler.play(mem, mixer);
+    for (ngs::Voice *player : graph.players)
+        graph.system->voice_scheduler.play(mem, player);
+}
+
+static Ptr<int16_t> make_pcm(MemState &mem) {
+    const Ptr<int16_t> pcm(alloc(mem, PCM_FRAMES * 2 * sizeof(int16_t), "NGS test pcm"));
+    int16_t *samples = pcm.get(mem);
+    for (int32_t i = 0; i < PCM_FRAMES; i++) {
+        samples[2 * i] = static_cast<int16_t>(std::sin(i * 0.031) * 20000);
+        samples[2 * i + 1] = static_cast<int16_t>(std::sin(i * 0.017) * 20000);
+    }
+
+    return pcm;
+}
+
+TEST(ngs_scheduler, parallel_update_matches_serial) {
+    constexpr int32_t NB_PLAYERS = 64;
+    constexpr int NB_UPDATES = 200;
+
+    MemState mem;
+    ASSERT_TRUE(init(mem, false));
+    ngs::State ngs;
+    ASSERT_TRUE(ngs::init(ngs, mem));
+    KernelState kern;
+
+    const Ptr<int16_t> pcm = make_pcm(mem);
+
+    SyntheticGraph serial, parallel;
+    make_graph(ngs, mem, serial, NB_PLAYERS, pcm);
+    make_graph(ngs, mem, parallel, NB_PLAYERS, pcm);
+    serial.system->voice_scheduler.parallel_update = false;
+    parallel.system->voice_scheduler.parallel_update = true;
+
+    using clock = std::chrono::steady_clock;
+    clock::duration serial_time{}, parallel_time{};
+    for (int update = 0; update < NB_UPDATES; update++) {
+        auto start = clock::now();
+        serial.system->voice_scheduler.update(kern, mem, 0);
+        serial_time += clock::now() - start;
+
+        start = clock::now();
+        parallel.system->voice_scheduler.update(kern, mem, 0);
+        parallel_time += clock::now() - start;
+
+        // the output of the master voice must not depend on the way the voices are processed
+        ASSERT_EQ(serial.master->datas[1].voice_state_data, parallel.master->datas[1].voice_state_data) << "update " << update;
+    }
+
+    const auto to_us = [](clock::duration time) { return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / NB_UPDATES; };
+    std::cout << NB_PLAYERS << " player voices, " << serial.mixers.size() << " mixer voices: serial " << to_us(serial_time)
+              << " us per update, parallel " << to_us(parallel_time) << " us per update" << std::endl;
+}
+
+// streaming decode of looping buffers, at the system rate and with the resampler
+TEST(ngs_player, streaming_decode) {
+    constexpr int32_t NB_PLAYERS = 128;
+    constexpr int NB_UPDATES = 200;
+
+    MemState mem;
+    ASSERT_TRUE(init(mem, false));
+    ngs::State ngs;
+    ASSERT_TRUE(ngs::init(ngs, mem));
+    KernelState kern;
+
+    const Ptr<int16_t> pcm = make_pcm(mem);
+
+    for (const float frequency : { 48000.0f, 44100.0f }) {
+        for (const bool parallel_update : { false, true }) {
+            SyntheticGraph graph;
+            make_graph(ngs, mem, graph, NB_PLAYERS, pcm, frequency);
+            graph.system->voice_scheduler.parallel_update = parallel_update;
+
+            // the first update creates the decoders and sizes the buffers
+            graph.system->voice_scheduler.update(kern, mem, 0);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int update = 0; update < NB_UPDATES; update++)
+                graph.system->voice_scheduler.update(kern, mem, 0);
+            const double time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            // each update decodes GRANULARITY samples of every player
+            for (ngs::Voice *player : graph.players)
+                ASSERT_EQ(player->state, ngs::VOICE_STATE_ACTIVE);
+            std::cout << "player at " << frequency << " Hz, " << (parallel_update ? "parallel" : "serial") << " update: "
+                      << NB_PLAYERS * NB_UPDATES / time_ms << " voices decoded per ms" << std::endl;
+        }
+    }
+}
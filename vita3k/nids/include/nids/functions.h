@@ -20,3 +20,12 @@
 #include <cstdint>
 
 const char *import_name(uint32_t nid);
+
+constexpr uint32_t INVALID_IMPORT_INDEX = UINT32_MAX;
+
+// Dense index of a function NID in nids.inc (variable NIDs are skipped), so that HLE calls can be
+// dispatched through a table resolved once at relocation time
+uint32_t import_index(uint32_t nid);
+// index must be less than import_count()
+uint32_t import_nid(uint32_t index);
+uint32_t import_count();
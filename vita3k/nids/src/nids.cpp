@@ -15,7 +15,12 @@
 // with this program; if not, write to the Free Software Foundation, Inc.,
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
+#include <nids/functions.h>
+
+#include <array>
+#include <cassert>
 #include <cstdint>
+#include <unordered_map>
 
 #define VAR_NID(name, nid) extern const char name_##name[] = #name;
 #define NID(name, nid) extern const char name_##name[] = #name;
@@ -38,3 +43,33 @@ const char *import_name(uint32_t nid) {
         return "UNRECOGNISED";
     }
 }
+
+static constexpr auto function_nids = std::to_array<uint32_t>({
+#define VAR_NID(name, nid)
+#define NID(name, nid) nid,
+#include <nids/nids.inc>
+#undef NID
+#undef VAR_NID
+});
+
+uint32_t import_index(uint32_t nid) {
+    static const std::unordered_map<uint32_t, uint32_t> indices = [] {
+        std::unordered_map<uint32_t, uint32_t> result;
+        result.reserve(function_nids.size());
+        for (uint32_t index = 0; index < function_nids.size(); index++)
+            result.emplace(function_nids[index], index);
+        return result;
+    }();
+
+    const auto it = indices.find(nid);
+    return it == indices.end() ? INVALID_IMPORT_INDEX : it->second;
+}
+
+uint32_t import_nid(uint32_t index) {
+    assert(index < function_nids.size());
+    return function_nids[index];
+}
+
+uint32_t import_count() {
+    return static_cast<uint32_t>(function_nids.size());
+}
@@ -25,6 +25,8 @@
 #include <emuenv/state.h>
 #include <string>
 
+class ThreadPool;
+
 // Credits to mmozeiko https://github.com/mmozeiko/pkg2zip
 
 const uint8_t pkg_vita_2[] = { 0xe3, 0x1a, 0x70, 0xc9, 0xce, 0x1d, 0xd7, 0x2b, 0xf3, 0xc0, 0x62, 0x29, 0x63, 0xf2, 0xec, 0xcb };
@@ -84,3 +86,7 @@ struct PkgEntry {
 bool install_pkg(const fs::path &pkg_path, EmuEnvState &emuenv, std::string &p_zRIF, const std::function<void(float)> &progress_callback = nullptr);
 
 bool decrypt_install_nonpdrm(EmuEnvState &emuenv, const fs::path &drmlicpath, const fs::path &title_path);
+
+// Decrypt in place the AES-128-CTR data starting at the AES block block of the pkg data.
+// Every block of CTR mode is independent, so the data is split in slices decrypted in parallel.
+void decrypt_aes_ctr_parallel(ThreadPool &pool, const uint8_t *key, uint8_t *iv, uint64_t block, uint8_t *data, size_t size);
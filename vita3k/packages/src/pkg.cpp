@@ -36,9 +36,13 @@
 #include <packages/sce_types.h>
 #include <packages/sfo.h>
 
+#include <threads/queue.h>
+#include <threads/thread_pool.h>
 #include <util/bytes.h>
 #include <util/log.h>
 
+#include <thread>
+
 // Credits to mmozeiko https://github.com/mmozeiko/pkg2zip
 
 static void ctr_init(uint8_t *counter, uint8_t *iv, uint64_t n) {
@@ -49,6 +53,28 @@ static void ctr_init(uint8_t *counter, uint8_t *iv, uint64_t n) {
     }
 }
 
+void decrypt_aes_ctr_parallel(ThreadPool &pool, const uint8_t *key, uint8_t *iv, uint64_t block, uint8_t *data, size_t size) {
+    constexpr size_t MIN_SLICE_SIZE = 64 * 1024;
+    const size_t nb_slices = std::clamp<size_t>(size / MIN_SLICE_SIZE, 1, pool.size() + 1);
+    const size_t slice_size = (size / nb_slices + 15) & ~size_t(15);
+
+    pool.parallel_for(nb_slices, [&](size_t i) {
+        const size_t begin = i * slice_size;
+        if (begin >= size)
+            return;
+        const size_t end = std::min(size, begin + slice_size);
+
+        uint8_t counter[0x10];
+        ctr_init(counter, iv, block + begin / 16);
+        EVP_CIPHER_CTX *cipher_ctx = EVP_CIPHER_CTX_new();
+        int dec_len = 0;
+        EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_ctr(), nullptr, key, counter);
+        EVP_CIPHER_CTX_set_padding(cipher_ctx, 0);
+        EVP_DecryptUpdate(cipher_ctx, data + begin, &dec_len, data + begin, static_cast<int>(end - begin));
+        EVP_CIPHER_CTX_free(cipher_ctx);
+    });
+}
+
 static int execute(std::string &zrif, fs::path &title_src, fs::path &title_dst, F00DEncryptorTypes type, std::string &f00d_arg) {
     std::string title_src_str = title_src.string();
     std::string title_dst_str = title_dst.string();
@@ -90,12 +116,13 @@ bool install_pkg(const fs::path &pkg_path, EmuEnvState &emuenv, std::string &p_z
         return false;
     }
 
-    if (fs::file_size(pkg_path) < byte_swap(pkg_header.total_size)) {
+    const uint64_t pkg_size = fs::file_size(pkg_path);
+    if (pkg_size < byte_swap(pkg_header.total_size)) {
         LOG_ERROR("The pkg file is too small");
         return false;
     }
 
-    if (fs::file_size(pkg_path) < byte_swap(pkg_header.data_offset) + byte_swap(pkg_header.file_count) * 32) {
+    if (pkg_size < byte_swap(pkg_header.data_offset) + byte_swap(pkg_header.file_count) * 32) {
         LOG_ERROR("The pkg file is too small");
         return false;
     }
@@ -234,64 +261,112 @@ bool install_pkg(const fs::path &pkg_path, EmuEnvState &emuenv, std::string &p_z
         EVP_DecryptFinal_ex(cipher_ctx, data + dec_len, &dec_len);
     };
 
-    for (uint32_t i = 0; i < byte_swap(pkg_header.file_count); i++) {
-        PkgEntry entry;
-        uint64_t file_offset = items_offset + i * 32;
-        infile.seekg(byte_swap(pkg_header.data_offset) + file_offset, std::ios_base::beg);
-        infile.read(reinterpret_cast<char *>(&entry), sizeof(PkgEntry));
-
-        decrypt_aes_ctr(file_offset / 16, reinterpret_cast<unsigned char *>(&entry), sizeof(PkgEntry));
+    const uint64_t data_offset = byte_swap(pkg_header.data_offset);
+    const uint32_t file_count = byte_swap(pkg_header.file_count);
 
-        if (fs::file_size(pkg_path) < byte_swap(pkg_header.data_offset) + byte_swap(entry.name_offset) + byte_swap(entry.name_size) || fs::file_size(pkg_path) < byte_swap(pkg_header.data_offset) + byte_swap(entry.data_offset) + byte_swap(entry.data_size)) {
+    // the table of the entries is read and checked before anything is extracted
+    std::vector<PkgEntry> entries(file_count);
+    infile.seekg(data_offset + items_offset);
+    infile.read(reinterpret_cast<char *>(entries.data()), file_count * sizeof(PkgEntry));
+    if (!infile) {
+        LOG_ERROR("The pkg file size is too small, possibly corrupted");
+        evp_cleanup();
+        return false;
+    }
+    decrypt_aes_ctr(items_offset / 16, reinterpret_cast<unsigned char *>(entries.data()), file_count * sizeof(PkgEntry));
+    for (const PkgEntry &entry : entries) {
+        if (pkg_size < data_offset + byte_swap(entry.name_offset) + byte_swap(entry.name_size) || pkg_size < data_offset + byte_swap(entry.data_offset) + byte_swap(entry.data_size)) {
             LOG_ERROR("The pkg file size is too small, possibly corrupted");
             evp_cleanup();
             return false;
         }
-        const auto file_count = (float)byte_swap(pkg_header.file_count);
-        progress_callback(i / file_count * 100.f * 0.6f);
-        std::vector<unsigned char> name(byte_swap(entry.name_size));
-        infile.seekg(byte_swap(pkg_header.data_offset) + byte_swap(entry.name_offset));
-        infile.read((char *)&name[0], byte_swap(entry.name_size));
+    }
 
-        decrypt_aes_ctr(byte_swap(entry.name_offset) / 16, name.data(), byte_swap(entry.name_size));
+    // Files are read in large chunks, each chunk is decrypted by all the cores
+    // while a writer thread writes the previous ones to the disk.
+    constexpr size_t CHUNK_SIZE = 8 * 1024 * 1024;
+    constexpr size_t NB_CHUNK_BUFFERS = 3;
 
-        auto string_name = std::string(name.begin(), name.end());
-        LOG_INFO(string_name);
+    struct WriteJob {
+        // the file is closed once its last chunk is written
+        std::shared_ptr<fs::ofstream> file;
+        std::vector<uint8_t> buffer;
+        size_t size;
+    };
+
+    Queue<WriteJob> write_queue;
+    Queue<std::vector<uint8_t>> free_buffers;
+    for (size_t i = 0; i < NB_CHUNK_BUFFERS; i++)
+        free_buffers.push(std::vector<uint8_t>(CHUNK_SIZE));
+
+    bool write_failed = false;
+    std::thread writer([&]() {
+        // a job without a file marks the end of the extraction
+        while (auto job = write_queue.pop()) {
+            if (!job->file)
+                break;
+
+            job->file->write(reinterpret_cast<const char *>(job->buffer.data()), job->size);
+            write_failed |= job->file->fail();
+            free_buffers.push(std::move(job->buffer));
+        }
+    });
 
-        if ((byte_swap(entry.type) & 0xFF) == 4 || (byte_swap(entry.type) & 0xFF) == 18) { // Directory
-            fs::create_directories(path / string_name);
-        } else { // File
-            fs::ofstream outfile(path / string_name, std::ios::binary);
+    const auto stop_writer = [&]() {
+        write_queue.push(WriteJob{});
+        writer.join();
+    };
 
-            auto offset = byte_swap(entry.data_offset);
-            auto data_size = byte_swap(entry.data_size);
+    // the writer must be joined before leaving, even when creating a file or a directory throws
+    try {
+        for (uint32_t i = 0; i < file_count; i++) {
+            const PkgEntry &entry = entries[i];
+            progress_callback(i / (float)file_count * 100.f * 0.6f);
+            std::vector<unsigned char> name(byte_swap(entry.name_size));
+            infile.seekg(data_offset + byte_swap(entry.name_offset));
+            infile.read((char *)&name[0], byte_swap(entry.name_size));
 
-            uint8_t counter[0x10];
-            ctr_init(counter, pkg_header.pkg_data_iv, offset / 16);
-            EVP_DecryptInit_ex(cipher_ctx, cipher_CTR, nullptr, main_key, counter);
-            EVP_CIPHER_CTX_set_padding(cipher_ctx, 0);
+            decrypt_aes_ctr(byte_swap(entry.name_offset) / 16, name.data(), byte_swap(entry.name_size));
 
-            std::vector<uint8_t> buffer(0x10000);
-            while (data_size != 0) {
-                int size = data_size < buffer.size() ? data_size : buffer.size();
-                infile.seekg(byte_swap(pkg_header.data_offset) + offset);
-                infile.read(reinterpret_cast<char *>(buffer.data()), size);
+            auto string_name = std::string(name.begin(), name.end());
+            LOG_INFO(string_name);
 
-                EVP_DecryptUpdate(cipher_ctx, buffer.data(), &dec_len, buffer.data(), size);
+            if ((byte_swap(entry.type) & 0xFF) == 4 || (byte_swap(entry.type) & 0xFF) == 18) { // Directory
+                fs::create_directories(path / string_name);
+            } else { // File
+                const auto outfile = std::make_shared<fs::ofstream>(path / string_name, std::ios::binary);
 
-                outfile.write(reinterpret_cast<char *>(buffer.data()), dec_len);
-                offset += size;
-                data_size -= size;
-            }
+                uint64_t offset = byte_swap(entry.data_offset);
+                uint64_t data_size = byte_swap(entry.data_size);
+
+                infile.seekg(data_offset + offset);
+                while (data_size != 0) {
+                    std::vector<uint8_t> buffer = std::move(*free_buffers.pop());
+                    const size_t size = std::min<uint64_t>(data_size, buffer.size());
+                    infile.read(reinterpret_cast<char *>(buffer.data()), size);
 
-            EVP_DecryptFinal_ex(cipher_ctx, buffer.data(), &dec_len);
-            outfile.write(reinterpret_cast<char *>(buffer.data()), dec_len);
-            outfile.close();
+                    decrypt_aes_ctr_parallel(get_shared_thread_pool(), main_key, pkg_header.pkg_data_iv, offset / 16, buffer.data(), size);
+
+                    write_queue.push(WriteJob{ outfile, std::move(buffer), size });
+                    offset += size;
+                    data_size -= size;
+                }
+            }
         }
+    } catch (...) {
+        stop_writer();
+        evp_cleanup();
+        throw;
     }
+    stop_writer();
     infile.close();
 
     evp_cleanup();
+    if (write_failed) {
+        LOG_ERROR("Failed to write the files of the pkg to {}", path);
+        return false;
+    }
+
     fs::path title_id_src = path;
     fs::path title_id_dst = fs_utils::path_concat(path, "_dec");
     std::string zRIF = p_zRIF;
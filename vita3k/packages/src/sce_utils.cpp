@@ -24,6 +24,7 @@
 #include <miniz.h>
 #include <openssl/evp.h>
 #include <packages/sce_types.h>
+#include <threads/thread_pool.h>
 #include <util/string_utils.h>
 
 #include <self.h>
@@ -685,9 +686,8 @@ std::string decompress_segments(const std::vector<uint8_t> &decrypted_data, cons
         return "";
     }
 
-    const std::string compressed_data(reinterpret_cast<const char *>(decrypted_data.data()), size);
-    stream.next_in = reinterpret_cast<const Bytef *>(compressed_data.data());
-    stream.avail_in = compressed_data.size();
+    stream.next_in = reinterpret_cast<const Bytef *>(decrypted_data.data());
+    stream.avail_in = size;
 
     int ret = 0;
     char outbuffer[4096];
@@ -854,7 +854,7 @@ std::vector<uint8_t> decrypt_fself(const std::vector<uint8_t> &fself, const uint
     register_keys(SCE_KEYS, 1);
     uint64_t authid = 0x2F00000000000001ULL;
 
-    // Extract the elf from the self
+    // Extract the elf header and program headers from the self, the segments are written straight to the new self
     std::vector<uint8_t> elf;
     int npdrmtype = 0;
 
@@ -908,9 +908,14 @@ std::vector<uint8_t> decrypt_fself(const std::vector<uint8_t> &fself, const uint
     if (encrypted)
         scesegs = get_segments(fself.data(), sce_hdr, SCE_KEYS, app_info_hdr.sys_version, app_info_hdr.self_type, npdrmtype, klic);
 
-    EVP_CIPHER_CTX *cipher_ctx = EVP_CIPHER_CTX_new();
-    EVP_CIPHER *cipher = EVP_CIPHER_fetch(nullptr, "AES-128-CTR", nullptr);
-    int dec_len = 0;
+    // Place the segments in the elf first, so that they can then be decrypted and inflated in parallel straight into the new self
+    struct SegmentLocation {
+        uint16_t index;
+        uint16_t sce_index;
+        uint64_t elf_offset;
+        uint64_t size;
+    };
+    std::vector<SegmentLocation> segment_locations;
 
     for (uint16_t i = 0; i < elf_hdr.e_phnum; i++) {
         int idx = 0;
@@ -926,36 +931,59 @@ std::vector<uint8_t> decrypt_fself(const std::vector<uint8_t> &fself, const uint
         if (pad_len < 0)
             LOG_ERROR("ELF p_offset Invalid");
 
-        elf.resize(elf.size() + pad_len);
-
         at += pad_len;
 
-        std::vector<unsigned char> decrypted_data(segment_infos[idx].size);
-        if (segment_infos[idx].plaintext == SecureBool::NO) {
-            EVP_DecryptInit_ex(cipher_ctx, cipher, nullptr, reinterpret_cast<const unsigned char *>(scesegs[i].key.c_str()), reinterpret_cast<const unsigned char *>(scesegs[i].iv.c_str()));
+        const uint64_t size = (segment_infos[idx].compressed == SecureBool::YES) ? elf_phdrs[idx].p_filesz : segment_infos[idx].size;
+        segment_locations.push_back({ static_cast<uint16_t>(idx), i, at, size });
+        at += size;
+    }
+
+    const uint64_t elf_size = at;
+    std::vector<uint8_t> decrypted_self(HEADER_LEN + elf_size);
+
+    EVP_CIPHER *cipher = EVP_CIPHER_fetch(nullptr, "AES-128-CTR", nullptr);
+
+    get_shared_thread_pool().parallel_for(segment_locations.size(), [&](size_t location_index) {
+        const SegmentLocation &location = segment_locations[location_index];
+        const SegmentInfo &segment_info = segment_infos[location.index];
+        uint8_t *const output = &decrypted_self[HEADER_LEN + location.elf_offset];
+        const uint8_t *input = &fself[segment_info.offset];
+
+        // compressed segments are decrypted in a temporary buffer, the others directly into the new self
+        std::vector<uint8_t> decrypted_data;
+        if (segment_info.plaintext == SecureBool::NO) {
+            uint8_t *decrypted = output;
+            if (segment_info.compressed == SecureBool::YES) {
+                decrypted_data.resize(segment_info.size);
+                decrypted = decrypted_data.data();
+            }
+
+            const SceSegment &sceseg = scesegs[location.sce_index];
+            EVP_CIPHER_CTX *cipher_ctx = EVP_CIPHER_CTX_new();
+            int dec_len = 0;
+            EVP_DecryptInit_ex(cipher_ctx, cipher, nullptr, reinterpret_cast<const unsigned char *>(sceseg.key.c_str()), reinterpret_cast<const unsigned char *>(sceseg.iv.c_str()));
             EVP_CIPHER_CTX_set_padding(cipher_ctx, 0);
-            EVP_DecryptUpdate(cipher_ctx, decrypted_data.data(), &dec_len, &fself[segment_infos[idx].offset], segment_infos[idx].size);
-            EVP_DecryptFinal_ex(cipher_ctx, decrypted_data.data() + dec_len, &dec_len);
+            EVP_DecryptUpdate(cipher_ctx, decrypted, &dec_len, input, segment_info.size);
+            EVP_DecryptFinal_ex(cipher_ctx, decrypted + dec_len, &dec_len);
+            EVP_CIPHER_CTX_free(cipher_ctx);
+            input = decrypted;
         }
 
-        if (segment_infos[idx].compressed == SecureBool::YES) {
-            const std::string decompressed_data = decompress_segments(decrypted_data, segment_infos[idx].size);
-            segment_infos[idx].compressed = SecureBool::NO;
-            elf.insert(elf.end(), decompressed_data.begin(), decompressed_data.end());
-            at += decompressed_data.length();
-        } else {
-            elf.insert(elf.end(), decrypted_data.data(), &decrypted_data[segment_infos[idx].size]);
-            at += segment_infos[idx].size;
+        if (segment_info.compressed == SecureBool::YES) {
+            mz_ulong dest_len = location.size;
+            const int res = mz_uncompress(output, &dest_len, input, static_cast<mz_ulong>(segment_info.size));
+            if (res != MZ_OK || dest_len != location.size)
+                LOG_ERROR("Failed to decompress segment {}: ({}) {} bytes out of {}", location.index, res, dest_len, location.size);
+        } else if (input != output) {
+            memcpy(output, input, location.size);
         }
-    }
+    });
 
-    EVP_CIPHER_CTX_free(cipher_ctx);
     EVP_CIPHER_free(cipher);
 
     // Credits to the vitasdk team/contributors for vita-make-fself https://github.com/vitasdk/vita-toolchain/blob/master/src/vita-make-fself.c
 
     // Create a new self with the extracted elf
-    std::vector<uint8_t> decrypted_self(HEADER_LEN + elf.size());
     ElfHeader ehdr = ElfHeader((char *)elf.data());
 
     // Create a new header
@@ -966,8 +994,8 @@ std::vector<uint8_t> decrypt_fself(const std::vector<uint8_t> &fself, const uint
         .header_type = 1,
         .metadata_offset = 0x600,
         .header_len = HEADER_LENGTH,
-        .elf_filesize = elf.size(),
-        .self_filesize = HEADER_LEN + elf.size(),
+        .elf_filesize = elf_size,
+        .self_filesize = HEADER_LEN + elf_size,
         .self_offset = 4,
         .appinfo_offset = 0x80,
         .elf_offset = sizeof(SCE_header) + sizeof(SCE_appinfo),
@@ -1069,7 +1097,7 @@ std::vector<uint8_t> decrypt_fself(const std::vector<uint8_t> &fself, const uint
     copy_data(&control_6, sizeof(control_6));
     copy_data(&control_7, sizeof(control_7));
 
-    // Copy the elf to the decrypted self
+    // Copy the elf and program headers to the decrypted self, the segments are already there
     memcpy(&decrypted_self[HEADER_LEN], elf.data(), elf.size());
 
     // Return the decrypted self
@@ -0,0 +1,108 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <gtest/gtest.h>
+
+#include <packages/pkg.h>
+#include <threads/thread_pool.h>
+
+#include <openssl/evp.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+struct PkgKeys {
+    uint8_t main_key[0x10];
+    uint8_t iv[0x10];
+};
+
+// Same derivation as install_pkg, with a fixed pkg data iv
+PkgKeys make_keys(const uint8_t *pkg_vita_key) {
+    PkgKeys keys;
+    for (int i = 0; i < 0x10; i++)
+        keys.iv[i] = static_cast<uint8_t>(0xF0 + i);
+
+    EVP_CIPHER_CTX *cipher_ctx = EVP_CIPHER_CTX_new();
+    int len = 0;
+    EVP_EncryptInit_ex(cipher_ctx, EVP_aes_128_ecb(), nullptr, pkg_vita_key, nullptr);
+    EVP_CIPHER_CTX_set_padding(cipher_ctx, 0);
+    EVP_EncryptUpdate(cipher_ctx, keys.main_key, &len, keys.iv, 0x10);
+    EVP_EncryptFinal_ex(cipher_ctx, keys.main_key + len, &len);
+    EVP_CIPHER_CTX_free(cipher_ctx);
+    return keys;
+}
+
+// Serial AES-128-CTR over the data starting at the AES block block, with the counter incremented by OpenSSL
+std::vector<uint8_t> crypt_serial(const PkgKeys &keys, uint64_t block, const std::vector<uint8_t> &data) {
+    uint8_t counter[0x10];
+    uint64_t n = block;
+    for (int i = 15; i >= 0; i--) {
+        n = n + keys.iv[i];
+        counter[i] = static_cast<uint8_t>(n);
+        n >>= 8;
+    }
+
+    std::vector<uint8_t> result(data.size());
+    EVP_CIPHER_CTX *cipher_ctx = EVP_CIPHER_CTX_new();
+    int len = 0;
+    EVP_EncryptInit_ex(cipher_ctx, EVP_aes_128_ctr(), nullptr, keys.main_key, counter);
+    EVP_EncryptUpdate(cipher_ctx, result.data(), &len, data.data(), static_cast<int>(data.size()));
+    EVP_CIPHER_CTX_free(cipher_ctx);
+    return result;
+}
+
+std::vector<uint8_t> random_data(size_t size) {
+    std::mt19937 rng(static_cast<uint32_t>(size));
+    std::vector<uint8_t> data(size);
+    for (auto &byte : data)
+        byte = static_cast<uint8_t>(rng());
+    return data;
+}
+
+void check_decrypt(ThreadPool &pool, const uint8_t *pkg_vita_key, uint64_t block, size_t size) {
+    PkgKeys keys = make_keys(pkg_vita_key);
+    const std::vector<uint8_t> plain = random_data(size);
+    std::vector<uint8_t> data = crypt_serial(keys, block, plain);
+
+    decrypt_aes_ctr_parallel(pool, keys.main_key, keys.iv, block, data.data(), data.size());
+
+    EXPECT_EQ(data, plain) << "block " << block << ", size " << size;
+}
+
+} // namespace
+
+TEST(pkg, decrypt_matches_serial_decrypt) {
+    ThreadPool pool(3);
+    for (const size_t size : { 16, 1000, 64 * 1024, 64 * 1024 + 16, 3 * 64 * 1024 + 5, 1024 * 1024 - 1, 8 * 1024 * 1024 }) {
+        check_decrypt(pool, pkg_vita_2, 0, size);
+        check_decrypt(pool, pkg_vita_2, 0x1234, size);
+    }
+}
+
+TEST(pkg, decrypt_carries_into_the_iv) {
+    // the counter of a block far in the data carries over the low bytes of the iv
+    ThreadPool pool(3);
+    check_decrypt(pool, pkg_vita_3, 0xFFFFFFFFFFFFull, 512 * 1024);
+    check_decrypt(pool, pkg_vita_4, 0x00FFFFFFFFFFFF00ull, 512 * 1024);
+}
+
+TEST(pkg, decrypt_without_workers) {
+    ThreadPool pool(0);
+    check_decrypt(pool, pkg_vita_2, 7, 1024 * 1024 + 32);
+}
@@ -82,7 +82,9 @@ enum class CommandOpcode : std::uint8_t {
     NewFrame,
 
     DestroyRenderTarget,
-    DestroyContext
+    DestroyContext,
+
+    TotalCommands
 };
 
 enum CommandErrorCode {
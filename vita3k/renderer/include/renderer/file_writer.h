@@ -0,0 +1,64 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <util/fs.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace renderer {
+
+// Writes files on a background thread so that generating a shader never has to wait for the disk.
+// The writes are done in the order they were queued.
+class FileWriter {
+public:
+    FileWriter();
+    ~FileWriter();
+
+    // Replace the content of the file at this path
+    void write(const fs::path &path, std::vector<uint8_t> data);
+    // Add data at the end of the file at this path
+    void append(const fs::path &path, std::vector<uint8_t> data);
+    // Wait until all the queued writes are done
+    void flush();
+
+private:
+    struct Job {
+        fs::path path;
+        std::vector<uint8_t> data;
+        bool append;
+    };
+
+    void push(Job &&job);
+    void run();
+
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::condition_variable job_done;
+    std::deque<Job> jobs;
+    bool writing = false;
+    bool exit = false;
+    std::thread thread;
+};
+
+} // namespace renderer
@@ -80,7 +80,7 @@ void set_visibility_buffer(State &state, Context *ctx, Ptr<uint32_t> visibility_
 void set_visibility_index(State &state, Context *ctx, bool enable, uint32_t index, bool is_increment);
 
 void set_context(State &state, Context *ctx, RenderTarget *target, SceGxmColorSurface *color_surface, SceGxmDepthStencilSurface *depth_stencil_surface);
-void set_vertex_stream(State &state, Context *ctx, const std::size_t index, const std::size_t data_len, const Ptr<const void> stream);
+void set_vertex_stream(State &state, Context *ctx, const std::size_t index, const std::size_t data_len, const std::size_t data_start, const Ptr<const void> stream);
 void draw(State &state, Context *ctx, SceGxmPrimitiveType prim_type, SceGxmIndexFormat index_type, Ptr<const void> index_data, const std::uint32_t index_count, const std::uint32_t instance_count);
 void transfer_copy(State &state, uint32_t colorKeyValue, uint32_t colorKeyMask, SceGxmTransferColorKeyMode colorKeyMode, const SceGxmTransferImage *images, SceGxmTransferType srcType, SceGxmTransferType destType);
 void transfer_downscale(State &state, const SceGxmTransferImage *src, const SceGxmTransferImage *dest);
@@ -224,7 +224,12 @@ void convert_x8u24_to_f32(void *dest, const void *data, const uint32_t width, co
 void convert_U8U3U3U2_to_U8U8U8U8(void *dest, const void *data, const uint32_t width, const uint32_t height);
 void convert_x8u24_to_u24x8(void *dest, const void *data, const uint32_t width, const uint32_t height);
 void convert_f32m_to_f32(void *dest, const void *data, const uint32_t width, const uint32_t height);
+// Add an opaque alpha channel to u8u8u8 (or s8s8s8) pixels
+void convert_u8u8u8_to_u8u8u8u8(void *dest, const void *data, const uint32_t width, const uint32_t height);
 void convert_u2f10f10f10_to_f16f16f16f16(void *dest, const void *data, const uint32_t width, const uint32_t height, const SceGxmTextureFormat format);
+// Only use the conversion kernels of an instruction set up to max_instrset (see util::instrset), so each of them can be tested
+// Must not be called while textures are being converted
+void set_conversion_max_instrset(int max_instrset);
 
 void swizzled_texture_to_linear_texture(uint8_t *dest, const uint8_t *src, uint16_t width, uint16_t height, uint8_t bits_per_pixel);
 void tiled_texture_to_linear_texture(uint8_t *dest, const uint8_t *src, uint16_t width, uint16_t height, uint8_t bits_per_pixel);
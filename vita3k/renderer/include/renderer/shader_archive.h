@@ -0,0 +1,93 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <features/state.h>
+#include <renderer/file_writer.h>
+
+#include <util/containers.h>
+#include <util/fs.h>
+#include <util/hash.h>
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace renderer {
+
+// All the shaders generated for an app, packed in a single append-only file.
+// The whole archive is read once when it is opened so looking up a shader afterwards does not touch the disk,
+// new shaders are appended to the file by the file writer.
+class ShaderArchive {
+public:
+    explicit ShaderArchive(FileWriter &writer)
+        : writer(writer) {}
+    ~ShaderArchive();
+
+    // Load the archive at this path, the file itself is only created on the first write.
+    // The shaders cached as separate files by older versions in the same folder are moved into it.
+    void open(const fs::path &path);
+    void close();
+
+    void write(const std::string &name, const void *data, size_t size);
+
+    template <typename R>
+    R read(const std::string &name) {
+        R result;
+
+        std::lock_guard<std::mutex> guard(mutex);
+        const auto it = entries.find(get_key(name));
+        if (it == entries.end())
+            return result;
+
+        const Entry &entry = it->second;
+        result.resize((entry.size + sizeof(typename R::value_type) - 1) / sizeof(typename R::value_type));
+        memcpy(result.data(), content.data() + entry.offset, entry.size);
+        return result;
+    }
+
+private:
+    struct Entry {
+        size_t offset;
+        uint32_t size;
+    };
+
+    static uint64_t get_key(const std::string &name);
+    void load(const fs::path &path);
+    void import_legacy_files();
+    void compact();
+
+    FileWriter &writer;
+    std::mutex mutex;
+    fs::path path;
+    std::vector<uint8_t> content;
+    unordered_map_fast<uint64_t, Entry> entries;
+    // size of the entries which have been overwritten by a more recent one
+    size_t stale_size = 0;
+};
+
+// name of the shader in the shader archive
+std::string get_shader_cache_name(const std::string &shader_version, const Sha256Hash &hash, const char *ext);
+
+// Features the shaders generated by each backend depend on, the shader cache is dropped when they change
+uint32_t get_gl_features_mask(const FeatureState &features);
+uint32_t get_vk_features_mask(const FeatureState &features);
+
+} // namespace renderer
@@ -18,8 +18,10 @@
 #pragma once
 
 #include <util/fs.h>
+#include <util/hash.h>
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -37,10 +39,10 @@ struct State;
 
 // Shaders.
 bool get_shaders_cache_hashs(State &renderer);
+// compile all the programs of shaders_cache_hashs, draw_progress is called regularly from the calling thread
+void precompile_shaders(State &renderer, const std::function<void()> &draw_progress);
 void save_shaders_cache_hashs(State &renderer, std::vector<ShadersHash> &shaders_cache_hashs);
-std::string load_glsl_shader(const SceGxmProgram &program, const FeatureState &features, const shader::Hints &hints, bool maskupdate, const fs::path &shader_cache_path, const fs::path &shader_log_path, const std::string &shader_version, bool shader_cache);
-std::vector<uint32_t> load_spirv_shader(const SceGxmProgram &program, const FeatureState &features, bool is_vulkan, const shader::Hints &hints, bool maskupdate, const fs::path &shader_cache_path, const fs::path &shader_log_path, const std::string &shader_version, bool shader_cache);
-std::string pre_load_shader_glsl(const fs::path &shader_path);
-std::vector<uint32_t> pre_load_shader_spirv(const fs::path &shader_path);
+std::string load_glsl_shader(const SceGxmProgram &program, const Sha256Hash &hash, const FeatureState &features, const shader::Hints &hints, bool maskupdate, State &renderer, const std::string &shader_version, bool shader_cache);
+std::vector<uint32_t> load_spirv_shader(const SceGxmProgram &program, const Sha256Hash &hash, const FeatureState &features, bool is_vulkan, const shader::Hints &hints, bool maskupdate, State &renderer, const std::string &shader_version, bool shader_cache);
 
 } // namespace renderer
@@ -17,11 +17,15 @@
 
 #pragma once
 
+#include <config/config.h>
 #include <features/state.h>
 #include <renderer/commands.h>
+#include <renderer/file_writer.h>
+#include <renderer/shader_archive.h>
 #include <renderer/types.h>
 #include <threads/queue.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <string_view>
@@ -66,17 +70,25 @@ struct State {
     std::condition_variable command_finish_one;
     std::mutex command_finish_one_mutex;
 
+    // number of commands processed since it was last reset, used to show the command rate
+    std::atomic<uint64_t> processed_command_count = 0;
+
     std::condition_variable notification_ready;
     std::mutex notification_mutex;
 
     std::vector<ShadersHash> shaders_cache_hashs;
     std::string shader_version;
+    // must be declared before the archive so that it outlives it
+    FileWriter file_writer;
+    ShaderArchive shader_archive{ file_writer };
+    // changed from the GUI while shaders are generated on other threads
+    std::atomic<ShaderLogMode> shader_log_mode = SHADER_LOG_GXP;
 
     int last_scene_id = 0;
 
     // on Vulkan, this is actually the number of pipelines compiled
     uint32_t shaders_count_compiled = 0;
-    uint32_t programs_count_pre_compiled = 0;
+    std::atomic<uint32_t> programs_count_pre_compiled = 0;
 
     bool should_display;
 
@@ -145,6 +157,7 @@ struct State {
     void set_app(const char *title_id, const char *self_name) {
         shaders_path = cache_path / "shaders" / title_id / self_name;
         shaders_log_path = log_path / "shaderlog" / title_id / self_name;
+        shader_archive.open(shaders_path / "shaders.pack");
     }
 };
 } // namespace renderer
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <gxm/types.h>
+#include <threads/thread_pool.h>
 #include <util/containers.h>
 #include <util/fs.h>
 
@@ -46,6 +47,8 @@ struct TextureCacheInfo {
     uint32_t texture_size = 0;
     bool use_hash = false;
     bool dirty = false;
+    // sum of the write generations of the pages of the texture when it was last uploaded
+    uint64_t write_generation = 0;
     // used for texture importation
     bool is_imported = false;
     bool is_srgb = false;
@@ -76,6 +79,9 @@ protected:
     // are we in the process of importing a texture
     bool importing_texture = false;
 
+    // used to decode the mips and faces of a texture in parallel
+    ThreadPool decode_pool;
+
     // dds/png raw file
     std::vector<uint8_t> imported_texture_raw_data;
     // pointer to the decoded content
@@ -97,6 +103,8 @@ protected:
 public:
     Backend backend;
     bool use_protect = false;
+    // detect changes with the write generation of the memory pages instead of hashing the texture
+    bool use_page_tracking = false;
     // use a separate sampler cache
     bool use_sampler_cache = false;
     int anisotropic_filtering = 1;
@@ -78,6 +78,8 @@ struct RenderTarget;
 struct GXMStreamInfo {
     Ptr<const uint8_t> data = Ptr<const uint8_t>(0);
     size_t size = 0;
+    // offset of the first byte of the stream used by the draw, what comes before doesn't need to be copied
+    size_t start = 0;
 };
 
 // We separate the following two parts of the stencil state because the first is part of the pipeline creation
@@ -24,9 +24,11 @@
 #include <renderer/vulkan/types.h>
 
 #include <config/state.h>
-#include <functional>
 #include <util/log.h>
 
+#include <array>
+#include <functional>
+
 struct FeatureState;
 
 namespace renderer {
@@ -68,29 +70,33 @@ static bool wait_cmd(MemState &mem, CommandList &command_list) {
 static void process_batch(renderer::State &state, const FeatureState &features, MemState &mem, Config &config, CommandList &command_list) {
     using CommandHandlerFunc = decltype(cmd_handle_set_context);
 
-    const static std::map<CommandOpcode, CommandHandlerFunc *> handlers = {
-        { CommandOpcode::SetContext, cmd_handle_set_context },
-        { CommandOpcode::SyncSurfaceData, cmd_handle_sync_surface_data },
-        { CommandOpcode::MidSceneFlush, cmd_handle_mid_scene_flush },
-        { CommandOpcode::CreateContext, cmd_handle_create_context },
-        { CommandOpcode::CreateRenderTarget, cmd_handle_create_render_target },
-        { CommandOpcode::MemoryMap, cmd_handle_memory_map },
-        { CommandOpcode::MemoryUnmap, cmd_handle_memory_unmap },
-        { CommandOpcode::Draw, cmd_handle_draw },
-        { CommandOpcode::TransferCopy, cmd_handle_transfer_copy },
-        { CommandOpcode::TransferDownscale, cmd_handle_transfer_downscale },
-        { CommandOpcode::TransferFill, cmd_handle_transfer_fill },
-        { CommandOpcode::Nop, cmd_handle_nop },
-        { CommandOpcode::SetState, cmd_handle_set_state },
-        { CommandOpcode::SignalSyncObject, cmd_handle_signal_sync_object },
-        { CommandOpcode::WaitSyncObject, cmd_handle_wait_sync_object },
-        { CommandOpcode::SignalNotification, cmd_handle_notification },
-        { CommandOpcode::NewFrame, cmd_new_frame },
-        { CommandOpcode::DestroyRenderTarget, cmd_handle_destroy_render_target },
-        { CommandOpcode::DestroyContext, cmd_handle_destroy_context }
-    };
+    // Indexed by opcode
+    static constexpr auto handlers = [] {
+        std::array<CommandHandlerFunc *, static_cast<size_t>(CommandOpcode::TotalCommands)> table{};
+        table[static_cast<size_t>(CommandOpcode::SetContext)] = cmd_handle_set_context;
+        table[static_cast<size_t>(CommandOpcode::SyncSurfaceData)] = cmd_handle_sync_surface_data;
+        table[static_cast<size_t>(CommandOpcode::MidSceneFlush)] = cmd_handle_mid_scene_flush;
+        table[static_cast<size_t>(CommandOpcode::CreateContext)] = cmd_handle_create_context;
+        table[static_cast<size_t>(CommandOpcode::CreateRenderTarget)] = cmd_handle_create_render_target;
+        table[static_cast<size_t>(CommandOpcode::MemoryMap)] = cmd_handle_memory_map;
+        table[static_cast<size_t>(CommandOpcode::MemoryUnmap)] = cmd_handle_memory_unmap;
+        table[static_cast<size_t>(CommandOpcode::Draw)] = cmd_handle_draw;
+        table[static_cast<size_t>(CommandOpcode::TransferCopy)] = cmd_handle_transfer_copy;
+        table[static_cast<size_t>(CommandOpcode::TransferDownscale)] = cmd_handle_transfer_downscale;
+        table[static_cast<size_t>(CommandOpcode::TransferFill)] = cmd_handle_transfer_fill;
+        table[static_cast<size_t>(CommandOpcode::Nop)] = cmd_handle_nop;
+        table[static_cast<size_t>(CommandOpcode::SetState)] = cmd_handle_set_state;
+        table[static_cast<size_t>(CommandOpcode::SignalSyncObject)] = cmd_handle_signal_sync_object;
+        table[static_cast<size_t>(CommandOpcode::WaitSyncObject)] = cmd_handle_wait_sync_object;
+        table[static_cast<size_t>(CommandOpcode::SignalNotification)] = cmd_handle_notification;
+        table[static_cast<size_t>(CommandOpcode::NewFrame)] = cmd_new_frame;
+        table[static_cast<size_t>(CommandOpcode::DestroyRenderTarget)] = cmd_handle_destroy_render_target;
+        table[static_cast<size_t>(CommandOpcode::DestroyContext)] = cmd_handle_destroy_context;
+        return table;
+    }();
 
     Command *cmd = command_list.first;
+    uint32_t command_count = 0;
 
     // Take a batch, and execute it. Hope it's not too large
     do {
@@ -98,13 +104,15 @@ static void process_batch(renderer::State &state, const FeatureState &features,
             break;
         }
 
-        auto handler = handlers.find(cmd->opcode);
-        if (handler == handlers.end()) {
-            LOG_ERROR("Unimplemented command opcode {}", static_cast<int>(cmd->opcode));
+        const auto opcode = static_cast<size_t>(cmd->opcode);
+        CommandHandlerFunc *handler = opcode < handlers.size() ? handlers[opcode] : nullptr;
+        if (!handler) {
+            LOG_ERROR("Unimplemented command opcode {}", opcode);
         } else {
             CommandHelper helper(cmd);
-            handler->second(state, mem, config, helper, features, command_list.context);
+            handler(state, mem, config, helper, features, command_list.context);
         }
+        command_count++;
 
         Command *last_cmd = cmd;
         cmd = cmd->next;
@@ -115,6 +123,8 @@ static void process_batch(renderer::State &state, const FeatureState &features,
             generic_command_free(last_cmd);
         }
     } while (true);
+
+    state.processed_command_count += command_count;
 }
 
 void process_batches(renderer::State &state, const FeatureState &features, MemState &mem, Config &config) {
@@ -272,6 +272,7 @@ bool init(SDL_Window *window, std::unique_ptr<State> &state, Backend backend, co
     }
 
     state->current_backend = backend;
+    state->shader_log_mode = static_cast<ShaderLogMode>(config.shader_log_mode);
 
     // Can change this
     state->command_buffer_queue.maxPendingCount_ = 30;
@@ -0,0 +1,86 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <renderer/file_writer.h>
+
+#include <util/log.h>
+
+namespace renderer {
+
+FileWriter::FileWriter() {
+    thread = std::thread(&FileWriter::run, this);
+}
+
+FileWriter::~FileWriter() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        exit = true;
+    }
+    job_ready.notify_one();
+    thread.join();
+}
+
+void FileWriter::write(const fs::path &path, std::vector<uint8_t> data) {
+    push({ path, std::move(data), false });
+}
+
+void FileWriter::append(const fs::path &path, std::vector<uint8_t> data) {
+    push({ path, std::move(data), true });
+}
+
+void FileWriter::push(Job &&job) {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        jobs.push_back(std::move(job));
+    }
+    job_ready.notify_one();
+}
+
+void FileWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    job_done.wait(lock, [&]() { return jobs.empty() && !writing; });
+}
+
+void FileWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        job_ready.wait(lock, [&]() { return exit || !jobs.empty(); });
+        // pending writes are still done when exiting
+        if (jobs.empty())
+            return;
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        writing = true;
+        lock.unlock();
+
+        boost::system::error_code err;
+        fs::create_directories(job.path.parent_path(), err);
+        fs::ofstream file(job.path, std::ios::out | std::ios::binary | (job.append ? std::ios::app : std::ios::trunc));
+        if (file.is_open())
+            file.write(reinterpret_cast<const char *>(job.data.data()), job.data.size());
+        else
+            LOG_ERROR("Could not open {} for writing", job.path);
+        file.close();
+
+        lock.lock();
+        writing = false;
+        job_done.notify_all();
+    }
+}
+
+} // namespace renderer
@@ -271,6 +271,7 @@ bool GLState::init() {
 
 void GLState::late_init(const Config &cfg, const std::string_view game_id, MemState &mem) {
     texture_cache.init(cfg.hashless_texture_cache, texture_folder(), game_id);
+    texture_cache.use_page_tracking = cfg.page_tracked_texture_cache;
 }
 
 bool create(std::unique_ptr<Context> &context) {
@@ -727,6 +728,10 @@ std::vector<uint32_t> GLState::dump_frame(DisplayState &display, uint32_t &width
     return surface_cache.dump_frame(frame.base, width, height, frame.pitch, res_multiplier, features.support_get_texture_sub_image);
 }
 
+uint32_t GLState::get_features_mask() {
+    return get_gl_features_mask(features);
+}
+
 int GLState::get_supported_filters() {
     // actually it's not even bilinear, it's either bilinear or nearest depending on the last use of the texture..
     // TODO: add bicubic filter and allow disabling bilinear.
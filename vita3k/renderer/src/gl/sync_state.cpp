@@ -432,16 +432,26 @@ void sync_vertex_streams_and_attributes(GLContext &context, GxmRecordState &stat
     std::array<std::size_t, SCE_GXM_MAX_VERTEX_STREAMS> offset_in_buffer;
     for (std::size_t i = 0; i < SCE_GXM_MAX_VERTEX_STREAMS; i++) {
         if (state.vertex_streams[i].data) {
-            std::pair<std::uint8_t *, std::size_t> result = context.vertex_stream_ring_buffer.allocate(state.vertex_streams[i].size);
+            // only copy the part of the stream used by the draw, then bind the buffer as if the whole stream was there
+            // if there is not enough space before the allocation for this, reserve the unused part too
+            const std::size_t start = state.vertex_streams[i].start;
+            const std::size_t used_size = state.vertex_streams[i].size - start;
+            std::pair<std::uint8_t *, std::size_t> result = context.vertex_stream_ring_buffer.allocate(used_size);
+            if (result.first && result.second < start)
+                result = context.vertex_stream_ring_buffer.allocate(state.vertex_streams[i].size);
+            else if (result.first)
+                result = { result.first - start, result.second - start };
+
             if (!result.first) {
                 LOG_ERROR("Failed to allocate vertex stream data from GPU!");
             } else {
-                std::memcpy(result.first, state.vertex_streams[i].data.get(mem), state.vertex_streams[i].size);
+                std::memcpy(result.first + start, state.vertex_streams[i].data.get(mem) + start, used_size);
                 offset_in_buffer[i] = result.second;
             }
 
             state.vertex_streams[i].data = nullptr;
             state.vertex_streams[i].size = 0;
+            state.vertex_streams[i].start = 0;
         } else {
             offset_in_buffer[i] = 0;
         }
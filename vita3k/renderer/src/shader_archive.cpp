@@ -0,0 +1,260 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <renderer/shader_archive.h>
+
+#include <util/log.h>
+
+#include <xxhash.h>
+
+namespace renderer {
+
+// magic number put at the beginning of the archive
+constexpr uint32_t shader_archive_magic = 0x43533356;
+constexpr uint32_t shader_archive_version = 1;
+
+struct ShaderArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+};
+
+struct ShaderArchiveRecord {
+    uint64_t key;
+    uint32_t size;
+    uint32_t padding;
+};
+
+ShaderArchive::~ShaderArchive() {
+    close();
+}
+
+uint64_t ShaderArchive::get_key(const std::string &name) {
+    return XXH3_64bits(name.data(), name.size());
+}
+
+void ShaderArchive::open(const fs::path &path) {
+    close();
+    load(path);
+    import_legacy_files();
+}
+
+void ShaderArchive::load(const fs::path &path) {
+    std::lock_guard<std::mutex> guard(mutex);
+    this->path = path;
+
+    fs::ifstream archive(path, std::ios::in | std::ios::binary);
+    if (!archive.is_open())
+        return;
+
+    archive.seekg(0, fs::ifstream::end);
+    const size_t archive_size = archive.tellg();
+    archive.seekg(0);
+
+    ShaderArchiveHeader header{};
+    if (archive_size >= sizeof(header))
+        archive.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (header.magic != shader_archive_magic || header.version != shader_archive_version) {
+        LOG_WARN("Shader archive {} is corrupted or outdated, ignoring it.", path);
+        archive.close();
+        fs::remove(path);
+        return;
+    }
+
+    content.resize(archive_size);
+    memcpy(content.data(), &header, sizeof(header));
+    archive.read(reinterpret_cast<char *>(content.data() + sizeof(header)), archive_size - sizeof(header));
+    archive.close();
+
+    // Build the index, the last record written with a given key is the valid one
+    size_t offset = sizeof(header);
+    while (offset + sizeof(ShaderArchiveRecord) <= archive_size) {
+        ShaderArchiveRecord record;
+        memcpy(&record, content.data() + offset, sizeof(record));
+        const size_t data_offset = offset + sizeof(record);
+        if (data_offset + record.size > archive_size)
+            break;
+
+        const auto [it, inserted] = entries.insert({ record.key, { data_offset, record.size } });
+        if (!inserted) {
+            stale_size += sizeof(record) + it->second.size;
+            it->second = { data_offset, record.size };
+        }
+        offset = data_offset + record.size;
+    }
+
+    if (offset != archive_size) {
+        // the last write was interrupted
+        LOG_WARN("Shader archive {} is truncated, dropping its last record.", path);
+        stale_size += archive_size - offset;
+    }
+
+    // Rewrite the archive once more than half of it is not used anymore
+    if (stale_size > 0 && (offset != archive_size || stale_size * 2 > archive_size))
+        compact();
+
+    LOG_INFO("Loaded {} shaders from shader archive", entries.size());
+}
+
+// Before the archive, each shader was a file of the cache folder named like its entry in the archive
+void ShaderArchive::import_legacy_files() {
+    const fs::path folder = path.parent_path();
+    if (folder.empty() || !fs::is_directory(folder))
+        return;
+
+    std::vector<fs::path> legacy_files;
+    for (const auto &entry : fs::directory_iterator(folder)) {
+        const auto extension = entry.path().extension();
+        if (fs::is_regular_file(entry.path()) && (extension == ".frag" || extension == ".vert" || extension == ".spv"))
+            legacy_files.push_back(entry.path());
+    }
+
+    if (legacy_files.empty())
+        return;
+
+    for (const auto &file_path : legacy_files) {
+        std::vector<uint8_t> data;
+        if (fs_utils::read_data(file_path, data) && !data.empty())
+            write(file_path.filename().string(), data.data(), data.size());
+        fs::remove(file_path);
+    }
+
+    LOG_INFO("Imported {} shaders into the shader archive", legacy_files.size());
+}
+
+void ShaderArchive::close() {
+    {
+        // once the path is cleared, write does nothing, so no append can be queued after the flush
+        std::lock_guard<std::mutex> guard(mutex);
+        path.clear();
+        content.clear();
+        content.shrink_to_fit();
+        entries.clear();
+        stale_size = 0;
+    }
+
+    // the archive may be removed or rewritten once it is closed
+    writer.flush();
+}
+
+void ShaderArchive::write(const std::string &name, const void *data, size_t size) {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (path.empty())
+        return;
+
+    const size_t write_offset = content.size();
+    if (content.empty()) {
+        const ShaderArchiveHeader header{ shader_archive_magic, shader_archive_version };
+        content.resize(sizeof(header));
+        memcpy(content.data(), &header, sizeof(header));
+    }
+
+    const ShaderArchiveRecord record{ get_key(name), static_cast<uint32_t>(size), 0 };
+    const size_t offset = content.size();
+    content.resize(offset + sizeof(record) + size);
+    memcpy(content.data() + offset, &record, sizeof(record));
+    memcpy(content.data() + offset + sizeof(record), data, size);
+
+    writer.append(path, std::vector<uint8_t>(content.begin() + write_offset, content.end()));
+
+    const auto [it, inserted] = entries.insert({ record.key, { offset + sizeof(record), record.size } });
+    if (!inserted) {
+        stale_size += sizeof(record) + it->second.size;
+        it->second = { offset + sizeof(record), record.size };
+    }
+}
+
+void ShaderArchive::compact() {
+    std::vector<uint8_t> compacted;
+    compacted.reserve(content.size() - stale_size);
+    compacted.insert(compacted.end(), content.begin(), content.begin() + sizeof(ShaderArchiveHeader));
+
+    unordered_map_fast<uint64_t, Entry> compacted_entries;
+    for (const auto &[key, entry] : entries) {
+        const ShaderArchiveRecord record{ key, entry.size, 0 };
+        const uint8_t *record_bytes = reinterpret_cast<const uint8_t *>(&record);
+        compacted.insert(compacted.end(), record_bytes, record_bytes + sizeof(record));
+        compacted_entries[key] = { compacted.size(), entry.size };
+        compacted.insert(compacted.end(), content.begin() + entry.offset, content.begin() + entry.offset + entry.size);
+    }
+
+    // write to a temporary file first so that the archive is never left half written
+    const fs::path compacted_path = fs_utils::path_concat(path, ".tmp");
+    fs::ofstream compacted_file(compacted_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!compacted_file.is_open()) {
+        LOG_ERROR("Could not compact shader archive {}", path);
+        return;
+    }
+    compacted_file.write(reinterpret_cast<const char *>(compacted.data()), compacted.size());
+    compacted_file.close();
+    fs::rename(compacted_path, path);
+
+    LOG_INFO("Compacted shader archive from {} to {} bytes", content.size(), compacted.size());
+    content = std::move(compacted);
+    entries = std::move(compacted_entries);
+    stale_size = 0;
+}
+
+std::string get_shader_cache_name(const std::string &shader_version, const Sha256Hash &hash, const char *ext) {
+    return fmt::format("{}-{}.{}", shader_version, hex_string(hash), ext);
+}
+
+uint32_t get_gl_features_mask(const FeatureState &features) {
+    union {
+        struct {
+            bool use_shader_interlock : 1;
+            bool use_texture_barrier : 1;
+            bool use_direct_fragcolor : 1;
+            bool use_unknown_format : 1;
+        };
+        uint32_t value;
+    } features_mask;
+    static_assert(sizeof(features_mask) == sizeof(uint32_t));
+
+    features_mask.value = 0;
+    features_mask.use_shader_interlock = features.support_shader_interlock;
+    features_mask.use_texture_barrier = features.support_texture_barrier;
+    features_mask.use_direct_fragcolor = features.direct_fragcolor;
+    features_mask.use_unknown_format = features.support_unknown_format;
+
+    return features_mask.value;
+}
+
+uint32_t get_vk_features_mask(const FeatureState &features) {
+    union {
+        struct {
+            bool use_shader_interlock : 1;
+            bool use_texture_viewport : 1;
+            bool use_memory_mapping : 1;
+            bool use_direct_fragcolor : 1;
+            // inverted so that the mask of the GPUs supporting them does not change
+            bool no_rgb_attributes : 1;
+        };
+        uint32_t value;
+    } features_mask;
+    static_assert(sizeof(features_mask) == sizeof(uint32_t));
+
+    features_mask.value = 0;
+    features_mask.use_shader_interlock = features.support_shader_interlock;
+    features_mask.use_texture_viewport = features.use_texture_viewport;
+    features_mask.use_memory_mapping = features.support_memory_mapping;
+    features_mask.use_direct_fragcolor = features.direct_fragcolor;
+    features_mask.no_rgb_attributes = !features.support_rgb_attributes;
+
+    return features_mask.value;
+}
+
+} // namespace renderer
@@ -26,7 +26,11 @@
 #include <util/fs.h>
 #include <util/log.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace renderer {
@@ -50,8 +54,10 @@ bool get_shaders_cache_hashs(State &renderer) {
     shaders_hashs.read((char *)&features_mask, sizeof(uint32_t));
     if (versionInFile != shader::CURRENT_VERSION || features_mask != renderer.get_features_mask()) {
         shaders_hashs.close();
+        renderer.shader_archive.close();
         fs::remove_all(renderer.shaders_path);
         fs::remove_all(renderer.shaders_log_path);
+        renderer.shader_archive.open(renderer.shaders_path / "shaders.pack");
         if (versionInFile != shader::CURRENT_VERSION)
             LOG_WARN("Current version of cache: {}, is outdated, recreate it.", versionInFile);
         else
@@ -86,98 +92,88 @@ bool get_shaders_cache_hashs(State &renderer) {
     return !renderer.shaders_cache_hashs.empty();
 }
 
-void save_shaders_cache_hashs(State &renderer, std::vector<ShadersHash> &shaders_cache_hashs) {
-    fs::create_directories(renderer.shaders_path);
-    std::string hash_file_name = fmt::format("hashs-{}.dat", (renderer.current_backend == Backend::OpenGL) ? "gl" : "vk");
-    fs::ofstream shaders_hashs(renderer.shaders_path / hash_file_name, std::ios::out | std::ios::binary);
-
-    if (shaders_hashs.is_open()) {
-        // Write Size of shaders cache hashes list
-        const auto size = shaders_cache_hashs.size();
-        shaders_hashs.write((const char *)&size, sizeof(size));
-
-        // Write version of cache
-        const uint32_t versionInFile = shader::CURRENT_VERSION;
-        shaders_hashs.write((const char *)&versionInFile, sizeof(uint32_t));
-        const uint32_t features_mask = renderer.get_features_mask();
-        shaders_hashs.write((const char *)&features_mask, sizeof(uint32_t));
-
-        // Write shader hash list
-        for (const auto &hash : shaders_cache_hashs) {
-            auto write = [&shaders_hashs](const Sha256Hash &hash) {
-                shaders_hashs.write(reinterpret_cast<const char *>(hash.data()), sizeof(Sha256Hash));
-            };
-
-            write(hash.frag);
-            write(hash.vert);
-        }
-        shaders_hashs.close();
-    }
-}
+void precompile_shaders(State &renderer, const std::function<void()> &draw_progress) {
+    const size_t total = renderer.shaders_cache_hashs.size();
 
-static bool load_shader(const fs::path &shader_name, char **destination, std::size_t &size_read) {
-    fs::ifstream is(shader_name, fs::ifstream::binary);
-    if (!is) {
-        return false;
+    if (renderer.current_backend == Backend::OpenGL) {
+        // GL programs can only be compiled on the thread owning the context
+        for (const auto &hash : renderer.shaders_cache_hashs) {
+            draw_progress();
+            renderer.precompile_shader(hash);
+        }
+        return;
     }
 
-    is.seekg(0, fs::ifstream::end);
-    size_read = is.tellg();
-    is.seekg(0);
-
-    if (size_read == 0) {
-        return false;
+    // shader modules can be created from any thread, spread the work on all the cores
+    // while the calling thread keeps the window responsive
+    const size_t nb_threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, total);
+    LOG_INFO("Pre-compiling {} programs using {} threads", total, nb_threads);
+
+    std::atomic<size_t> next_hash = 0;
+    std::atomic<size_t> nb_threads_done = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(nb_threads);
+    for (size_t i = 0; i < nb_threads; i++) {
+        workers.emplace_back([&]() {
+            for (size_t idx = next_hash++; idx < total; idx = next_hash++)
+                renderer.precompile_shader(renderer.shaders_cache_hashs[idx]);
+            nb_threads_done++;
+        });
     }
 
-    if (destination == nullptr) {
-        return true;
+    while (nb_threads_done < nb_threads) {
+        draw_progress();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
-    is.read(*destination, size_read);
-    return true;
+    for (auto &worker : workers)
+        worker.join();
 }
 
-static Sha256Hash get_shader_hash(const SceGxmProgram &program) {
-    const Sha256Hash hash_bytes = sha256(&program, program.size);
-    return hash_bytes;
-}
+void save_shaders_cache_hashs(State &renderer, std::vector<ShadersHash> &shaders_cache_hashs) {
+    const std::string hash_file_name = fmt::format("hashs-{}.dat", (renderer.current_backend == Backend::OpenGL) ? "gl" : "vk");
+    std::vector<uint8_t> data;
+    const auto write = [&data](const void *value, size_t size) {
+        const uint8_t *bytes = static_cast<const uint8_t *>(value);
+        data.insert(data.end(), bytes, bytes + size);
+    };
 
-template <typename R>
-static R load_shader_generic(const fs::path &shader_path) {
-    std::size_t read_size = 0;
-    R source;
+    // Write Size of shaders cache hashes list
+    const auto size = shaders_cache_hashs.size();
+    write(&size, sizeof(size));
 
-    if (load_shader(shader_path, nullptr, read_size)) {
-        source.resize((read_size + sizeof(typename R::value_type) - 1) / sizeof(typename R::value_type));
+    // Write version of cache
+    const uint32_t versionInFile = shader::CURRENT_VERSION;
+    write(&versionInFile, sizeof(uint32_t));
+    const uint32_t features_mask = renderer.get_features_mask();
+    write(&features_mask, sizeof(uint32_t));
 
-        char *dest_pointer = reinterpret_cast<char *>(source.data());
-        load_shader(shader_path, &dest_pointer, read_size);
+    // Write shader hash list
+    for (const auto &hash : shaders_cache_hashs) {
+        write(hash.frag.data(), sizeof(Sha256Hash));
+        write(hash.vert.data(), sizeof(Sha256Hash));
     }
 
-    return source;
+    renderer.file_writer.write(renderer.shaders_path / hash_file_name, std::move(data));
 }
 
-static shader::GeneratedShader load_shader_generic(shader::Target target, const SceGxmProgram &program, const FeatureState &features, const shader::Hints &hints, bool maskupdate, const fs::path &shader_cache_path, const fs::path &shaderlog_path, const char *shader_type_str, const std::string &shader_version, bool shader_cache) {
-    // TODO: no need to recompute the hash here
-    const std::string hash_text = hex_string(get_shader_hash(program));
+static shader::GeneratedShader load_shader_generic(shader::Target target, const SceGxmProgram &program, const Sha256Hash &hash, const FeatureState &features, const shader::Hints &hints, bool maskupdate, State &renderer, const char *shader_type_str, const std::string &shader_version, bool shader_cache) {
+    const std::string hash_text = hex_string(hash);
     // Set Shader Hash with Version
     const std::string hash_hex_ver = fmt::format("{}-{}", shader_version, hash_text);
-    const auto get_shader_path = [&](const char *ext) {
-        return shader_cache_path / fmt::format("{}.{}", hash_hex_ver, ext);
-    };
-    const auto get_shaderlog_path = [&](const char *ext) {
-        return shaderlog_path / fmt::format("{}.{}", hash_hex_ver, ext);
+    const auto get_shaderlog_path = [&](const std::string &ext) {
+        return renderer.shaders_log_path / fmt::format("{}.{}", hash_hex_ver, ext);
     };
 
-    const auto shader_path = get_shader_path(shader_type_str);
+    const std::string shader_name = get_shader_cache_name(shader_version, hash, (target == shader::Target::GLSLOpenGL) ? shader_type_str : "spv");
     if (shader_cache) {
         if (target == shader::Target::GLSLOpenGL) {
-            std::string source = load_shader_generic<std::string>(shader_path);
+            std::string source = renderer.shader_archive.read<std::string>(shader_name);
             if (!source.empty()) {
                 return { source, std::vector<uint32_t>() };
             }
         } else {
-            std::vector<uint32_t> source = load_shader_generic<std::vector<uint32_t>>(get_shader_path("spv"));
+            std::vector<uint32_t> source = renderer.shader_archive.read<std::vector<uint32_t>>(shader_name);
             if (!source.empty())
                 return { "", source };
         }
@@ -185,39 +181,31 @@ static shader::GeneratedShader load_shader_generic(shader::Target target, const
 
     LOG_INFO("Generating {} shader {}", shader_type_str, hash_text);
 
-    fs::create_directories(shaderlog_path);
-
-    auto shader_log_path = get_shaderlog_path("gxp");
-
-    // Dump gxp binary
-    fs_utils::dump_data(shader_log_path, &program, program.size);
+    // All the files are written in the background, this can happen in the middle of a frame
+    const ShaderLogMode shader_log_mode = renderer.shader_log_mode;
+    if (shader_log_mode != SHADER_LOG_OFF) {
+        // Dump gxp binary
+        const uint8_t *program_data = reinterpret_cast<const uint8_t *>(&program);
+        renderer.file_writer.write(get_shaderlog_path("gxp"), std::vector<uint8_t>(program_data, program_data + program.size));
+    }
     const auto write_data_with_ext = [&](const std::string &ext, const std::string &data) {
-        fs::path out_path;
-        if (ext == shader_type_str) {
-            out_path = shader_path;
-        } else {
-            out_path = shader_log_path;
-            out_path.replace_extension(ext);
-        }
-        fs_utils::dump_data(out_path, data.c_str(), data.size());
+        if (target == shader::Target::GLSLOpenGL && ext == shader_type_str)
+            renderer.shader_archive.write(shader_name, data.c_str(), data.size());
+        else if (shader_log_mode == SHADER_LOG_FULL)
+            renderer.file_writer.write(get_shaderlog_path(ext), std::vector<uint8_t>(data.begin(), data.end()));
         return true;
     };
 
     shader::GeneratedShader source = shader::convert_gxp(program, hash_text, features, target, hints, maskupdate, false, write_data_with_ext);
 
     // Copy shader generate to shaders cache
-    const auto shaders_cache_path = fs::path(shader_cache_path);
-    fs::create_directories(shaders_cache_path);
-
-    if (target != shader::Target::GLSLOpenGL) {
-        const auto shader_dst_path = get_shader_path("spv");
-        fs_utils::dump_data(shader_dst_path, source.spirv.data(), sizeof(uint32_t) * source.spirv.size());
-    }
+    if (target != shader::Target::GLSLOpenGL)
+        renderer.shader_archive.write(shader_name, source.spirv.data(), sizeof(uint32_t) * source.spirv.size());
 
     return source;
 }
 
-std::string load_glsl_shader(const SceGxmProgram &program, const FeatureState &features, const shader::Hints &hints, bool maskupdate, const fs::path &shader_cache_path, const fs::path &shader_log_path, const std::string &shader_version, bool shader_cache) {
+std::string load_glsl_shader(const SceGxmProgram &program, const Sha256Hash &hash, const FeatureState &features, const shader::Hints &hints, bool maskupdate, State &renderer, const std::string &shader_version, bool shader_cache) {
     SceGxmProgramType program_type = program.get_type();
 
     auto shader_type_to_str = [](SceGxmProgramType type) {
@@ -226,25 +214,17 @@ std::string load_glsl_shader(const SceGxmProgram &program, const FeatureState &f
 
     const char *shader_type_str = shader_type_to_str(program_type);
 
-    return load_shader_generic(shader::Target::GLSLOpenGL, program, features, hints, maskupdate, shader_cache_path, shader_log_path, shader_type_str, shader_version, shader_cache).glsl;
+    return load_shader_generic(shader::Target::GLSLOpenGL, program, hash, features, hints, maskupdate, renderer, shader_type_str, shader_version, shader_cache).glsl;
 }
 
-std::vector<uint32_t> load_spirv_shader(const SceGxmProgram &program, const FeatureState &features, bool is_vulkan, const shader::Hints &hints, bool maskupdate, const fs::path &shader_cache_path, const fs::path &shader_log_path, const std::string &shader_version, bool shader_cache) {
+std::vector<uint32_t> load_spirv_shader(const SceGxmProgram &program, const Sha256Hash &hash, const FeatureState &features, bool is_vulkan, const shader::Hints &hints, bool maskupdate, State &renderer, const std::string &shader_version, bool shader_cache) {
     const shader::Target target = is_vulkan ? shader::Target::SpirVVulkan : shader::Target::SpirVOpenGL;
     auto shader_type_to_str = [](SceGxmProgramType type) {
         return (type == SceGxmProgramType::Vertex) ? "vert.spv.txt" : ((type == SceGxmProgramType::Fragment) ? "frag.spv.txt" : "unknown.spv.txt");
     };
     const char *shader_type_str = shader_type_to_str(program.get_type());
 
-    return load_shader_generic(target, program, features, hints, maskupdate, shader_cache_path, shader_log_path, shader_type_str, shader_version, shader_cache).spirv;
-}
-
-std::string pre_load_shader_glsl(const fs::path &shader_path) {
-    return load_shader_generic<std::string>(shader_path);
-}
-
-std::vector<uint32_t> pre_load_shader_spirv(const fs::path &shader_path) {
-    return load_shader_generic<std::vector<uint32_t>>(shader_path);
+    return load_shader_generic(target, program, hash, features, hints, maskupdate, renderer, shader_type_str, shader_version, shader_cache).spirv;
 }
 
 } // namespace renderer
@@ -321,6 +321,27 @@ bool TextureCache::init(const bool hashless_texture_cache, const fs::path &textu
     return true;
 }
 
+// a mip of a face, decoded independently from the others
+struct TextureLevel {
+    const uint8_t *data;
+    uint32_t width;
+    uint32_t height;
+    uint32_t layout_width;
+    uint32_t layout_height;
+    uint32_t mip_index;
+    int upload_type;
+
+    // set once the level is decoded
+    SceGxmTextureBaseFormat upload_format;
+    uint32_t pixels_per_stride;
+    const void *pixels;
+    std::vector<uint8_t> texture_data_decompressed;
+    std::vector<uint8_t> texture_pixels_lineared;
+};
+
+// below this size, waking up the decoding threads costs more than what it saves
+static constexpr uint32_t PARALLEL_DECODE_MIN_SIZE = KiB(64);
+
 void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &mem) {
     R_PROFILE(__func__);
 
@@ -338,20 +359,14 @@ void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &me
     uint32_t height = gxm::get_height(gxm_texture);
 
     const Ptr<uint8_t> data(gxm_texture.data_addr << 2);
-    uint8_t *texture_data = data.get(mem);
+    const uint8_t *texture_data = data.get(mem);
 
     if (!texture_data) {
         return;
     }
 
-    std::vector<uint8_t> texture_data_decompressed;
-    std::vector<uint8_t> texture_pixels_lineared;
-
-    const void *pixels = nullptr;
-
-    uint32_t pixels_per_stride = 0;
-    uint32_t bpp = gxm::bits_per_pixel(base_format);
-    uint32_t bytes_per_pixel = (bpp + 7) >> 3;
+    const uint32_t base_bpp = gxm::bits_per_pixel(base_format);
+    const uint32_t base_bytes_per_pixel = (base_bpp + 7) >> 3;
 
     const auto texture_type = gxm_texture.texture_type();
     const bool is_swizzled = (texture_type == SCE_GXM_TEXTURE_SWIZZLED) || (texture_type == SCE_GXM_TEXTURE_CUBE) || (texture_type == SCE_GXM_TEXTURE_SWIZZLED_ARBITRARY) || (texture_type == SCE_GXM_TEXTURE_CUBE_ARBITRARY);
@@ -377,9 +392,9 @@ void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &me
         face_total_count = 6;
 
         if (gxm_texture.mip_count != 0xF) {
-            const bool twok_align_cond1 = width >= 32 && height >= 32 && (bpp <= 8 || gxm::is_block_compressed_format(base_format));
-            const bool twok_align_cond2 = width >= 16 && height >= 16 && (bpp == 16 || bpp == 32);
-            const bool twok_align_cond3 = width >= 8 && height >= 8 && bpp == 64;
+            const bool twok_align_cond1 = width >= 32 && height >= 32 && (base_bpp <= 8 || gxm::is_block_compressed_format(base_format));
+            const bool twok_align_cond2 = width >= 16 && height >= 16 && (base_bpp == 16 || base_bpp == 32);
+            const bool twok_align_cond3 = width >= 8 && height >= 8 && base_bpp == 64;
 
             if (twok_align_cond1 || twok_align_cond2 || twok_align_cond3) {
                 face_align_bytes = 2048;
@@ -399,7 +414,7 @@ void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &me
     }
     auto [block_width, block_height] = gxm::get_block_size(base_format);
     // block size in bytes
-    const uint32_t block_size = (block_width * block_height * bpp) / 8;
+    const uint32_t block_size = (block_width * block_height * base_bpp) / 8;
     // from the number of pixels in a mipmap, we can get the number of blocks by shifting to the right by block_shift
     const uint32_t block_shift = std::bit_width(block_width * block_height) - 1;
 
@@ -415,19 +430,82 @@ void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &me
     const uint32_t org_layout_width = layout_width;
     const uint32_t org_layout_height = layout_height;
 
+    // First find where each mip of each face is located
+    std::vector<TextureLevel> levels;
     while (face_uploaded_count < face_total_count && org_width > 0 && org_height > 0) {
-        pixels = texture_data;
+        TextureLevel &level = levels.emplace_back();
+        level.data = texture_data;
+        level.width = width;
+        level.height = height;
+        level.layout_width = layout_width;
+        level.layout_height = layout_height;
+        level.mip_index = mip_index;
+        level.upload_type = upload_type;
+
+        const uint32_t nb_pixels = align(layout_width, align_width) * align(layout_height, align_height);
+        const uint32_t mip_size = (nb_pixels >> block_shift) * block_size;
+        texture_data += mip_size;
+        total_source_so_far += mip_size;
+
+        mip_index++;
+        width /= 2;
+        height /= 2;
+        layout_width /= 2;
+        layout_height /= 2;
+
+        if (mip_index == total_mip) {
+            if ((texture_type == SCE_GXM_TEXTURE_CUBE || texture_type == SCE_GXM_TEXTURE_CUBE_ARBITRARY) && gxm_texture.mip_count != 0xF) {
+                // we must do as if all possible mips are here
+                while (layout_width > 0 && layout_height > 0) {
+                    const uint32_t nb_pixels = align(layout_width, align_width) * align(layout_height, align_height);
+                    const uint32_t mip_size = (nb_pixels >> block_shift) * block_size;
+                    texture_data += mip_size;
+                    total_source_so_far += mip_size;
+                    layout_width /= 2;
+                    layout_height /= 2;
+                }
+            }
+
+            mip_index = 0;
+            face_uploaded_count++;
+
+            layout_width = org_layout_width;
+            layout_height = org_layout_height;
+            width = org_width;
+            height = org_height;
+
+            upload_type++;
+
+            uint32_t source_unaligned_size = total_source_so_far;
+            total_source_so_far = align(total_source_so_far, face_align_bytes);
+
+            texture_data += total_source_so_far - source_unaligned_size;
+        }
+    }
+
+    // Then perform all needed conversions (formats not supported by modern GPUs) and convert the data to a linear layout
+    const auto decode_level = [&](size_t level_index) {
+        TextureLevel &level = levels[level_index];
+        const uint32_t width = level.width;
+        const uint32_t layout_width = level.layout_width;
+        const uint32_t layout_height = level.layout_height;
+        std::vector<uint8_t> &texture_data_decompressed = level.texture_data_decompressed;
+        std::vector<uint8_t> &texture_pixels_lineared = level.texture_pixels_lineared;
+
+        const void *pixels = level.data;
+        uint32_t bpp = base_bpp;
+        uint32_t bytes_per_pixel = base_bytes_per_pixel;
 
         SceGxmTextureBaseFormat upload_format = base_format;
-        uint32_t memory_height = height;
+        uint32_t memory_height = level.height;
 
         // Get pixels per stride
-        pixels_per_stride = width;
+        uint32_t pixels_per_stride = width;
         switch (texture_type) {
         case SCE_GXM_TEXTURE_SWIZZLED_ARBITRARY:
         case SCE_GXM_TEXTURE_CUBE_ARBITRARY:
             pixels_per_stride = next_power_of_two(width);
-            memory_height = next_power_of_two(height);
+            memory_height = next_power_of_two(level.height);
             break;
         case SCE_GXM_TEXTURE_LINEAR_STRIDED:
             pixels_per_stride = gxm::get_stride_in_bytes(gxm_texture) / bytes_per_pixel;
@@ -440,7 +518,6 @@ void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &me
         pixels_per_stride = align(pixels_per_stride, align_width);
         memory_height = align(memory_height, align_height);
 
-        // perform all needed conversions (formats not supported by modern GPUs)
         switch (base_format) {
         case SCE_GXM_TEXTURE_BASE_FORMAT_P4:
         case SCE_GXM_TEXTURE_BASE_FORMAT_P8:
@@ -478,6 +555,7 @@ void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &me
             convert_U8U3U3U2_to_U8U8U8U8(texture_data_decompressed.data(), pixels, pixels_per_stride, memory_height);
             pixels = texture_data_decompressed.data();
             upload_format = SCE_GXM_TEXTURE_BASE_FORMAT_U8U8U8U8;
+            bytes_per_pixel = 4;
             bpp = 32;
             break;
         case SCE_GXM_TEXTURE_BASE_FORMAT_SE5M9M9M9:
@@ -549,49 +627,25 @@ void TextureCache::upload_texture(const SceGxmTexture &gxm_texture, MemState &me
             pixels = texture_pixels_lineared.data();
         }
 
-        upload_texture_impl(upload_format, width, height, mip_index, pixels, upload_type, pixels_per_stride);
+        level.upload_format = upload_format;
+        level.pixels_per_stride = pixels_per_stride;
+        level.pixels = pixels;
+    };
+
+    // the mips and faces are independent, decode them in parallel when this is worth it
+    // (the yuv conversion uses a global context and can't be run on multiple threads)
+    const bool is_yuv = base_format == SCE_GXM_TEXTURE_BASE_FORMAT_YUV420P2 || base_format == SCE_GXM_TEXTURE_BASE_FORMAT_YUV420P3;
+    if (!is_yuv && total_source_so_far >= PARALLEL_DECODE_MIN_SIZE)
+        decode_pool.parallel_for(levels.size(), decode_level);
+    else
+        for (size_t i = 0; i < levels.size(); i++)
+            decode_level(i);
+
+    // Finally give the decoded levels to the backend, in order
+    for (const TextureLevel &level : levels) {
+        upload_texture_impl(level.upload_format, level.width, level.height, level.mip_index, level.pixels, level.upload_type, level.pixels_per_stride);
         if (export_textures)
-            export_texture_impl(upload_format, width, height, mip_index, pixels, upload_type, pixels_per_stride);
-
-        const uint32_t nb_pixels = align(layout_width, align_width) * align(layout_height, align_height);
-        const uint32_t mip_size = (nb_pixels >> block_shift) * block_size;
-        texture_data += mip_size;
-        total_source_so_far += mip_size;
-
-        mip_index++;
-        width /= 2;
-        height /= 2;
-        layout_width /= 2;
-        layout_height /= 2;
-
-        if (mip_index == total_mip) {
-            if ((texture_type == SCE_GXM_TEXTURE_CUBE || texture_type == SCE_GXM_TEXTURE_CUBE_ARBITRARY) && gxm_texture.mip_count != 0xF) {
-                // we must do as if all possible mips are here
-                while (layout_width > 0 && layout_height > 0) {
-                    const uint32_t nb_pixels = align(layout_width, align_width) * align(layout_height, align_height);
-                    const uint32_t mip_size = (nb_pixels >> block_shift) * block_size;
-                    texture_data += mip_size;
-                    total_source_so_far += mip_size;
-                    layout_width /= 2;
-                    layout_height /= 2;
-                }
-            }
-
-            mip_index = 0;
-            face_uploaded_count++;
-
-            layout_width = org_layout_width;
-            layout_height = org_layout_height;
-            width = org_width;
-            height = org_height;
-
-            upload_type++;
-
-            uint32_t source_unaligned_size = total_source_so_far;
-            total_source_so_far = align(total_source_so_far, face_align_bytes);
-
-            texture_data += total_source_so_far - source_unaligned_size;
-        }
+            export_texture_impl(level.upload_format, level.width, level.height, level.mip_index, level.pixels, level.upload_type, level.pixels_per_stride);
     }
 }
 
@@ -659,7 +713,10 @@ void TextureCache::cache_and_bind_texture(const SceGxmTexture &gxm_texture, MemS
         // This works under the assumption that once this big enough texture decided to modify. It will have to modify either all of its data,
         // or replace with an entire new texture.
         bool should_use_hash = true;
-        if (use_protect && info->texture_size >= mem.page_size * 4) {
+        if (use_page_tracking) {
+            // a texture smaller than a page is faster to hash than to track
+            should_use_hash = info->texture_size < mem.page_size;
+        } else if (use_protect && info->texture_size >= mem.page_size * 4) {
             range_protect_begin = align(gxm_texture.data_addr << 2, mem.page_size);
             range_protect_end = align_down((gxm_texture.data_addr << 2) + info->texture_size, mem.page_size);
 
@@ -689,6 +746,8 @@ void TextureCache::cache_and_bind_texture(const SceGxmTexture &gxm_texture, MemS
                 info->hash = hash_texture_data(gxm_texture, info->texture_size, mem) ^ 1;
 
             upload = previous_hash != info->hash;
+        } else if (use_page_tracking) {
+            upload = get_page_write_generation(mem, gxm_texture.data_addr << 2, info->texture_size) != info->write_generation;
         } else {
             upload = info->dirty;
         }
@@ -735,6 +794,12 @@ void TextureCache::cache_and_bind_texture(const SceGxmTexture &gxm_texture, MemS
         }
     }
     if (upload) {
+        if (!info->use_hash && use_page_tracking) {
+            // track the pages before reading them so that a write happening during the upload is seen on the next bind
+            track_page_writes(mem, gxm_texture.data_addr << 2, info->texture_size);
+            info->write_generation = get_page_write_generation(mem, gxm_texture.data_addr << 2, info->texture_size);
+        }
+
         if (export_textures && !importing_texture)
             export_select(gxm_texture);
 
@@ -743,7 +808,7 @@ void TextureCache::cache_and_bind_texture(const SceGxmTexture &gxm_texture, MemS
         else
             upload_texture(gxm_texture, mem);
 
-        if (!info->use_hash) {
+        if (!info->use_hash && !use_page_tracking) {
             info->dirty = false;
             add_protect(mem, range_protect_begin, range_protect_end - range_protect_begin, MemPerm::ReadOnly, [info, gxm_texture](Address, bool) {
                 if (memcmp(&info->texture, &gxm_texture, sizeof(SceGxmTexture)) == 0) {
@@ -16,15 +16,35 @@
 // with this program; if not, write to the Free Software Foundation, Inc.,
 // 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 
+#include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 
 #include <gxm/types.h>
 #include <renderer/functions.h>
 #include <renderer/pvrt-dec.h>
 #include <util/log.h>
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#else
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSSE3 __attribute__((__target__("ssse3")))
+#define TARGET_AVX2 __attribute__((__target__("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#include <intrin.h>
+#else
+#error "Compiler is not supported"
+#endif
+#include <util/instrset_detect.h>
+#endif
+
 namespace renderer::texture {
 
 bool convert_base_texture_format_to_base_color_format(SceGxmTextureBaseFormat format, SceGxmColorBaseFormat &color_format) {
@@ -163,16 +183,245 @@ void decompress_packed_float_e5m9m9m9(SceGxmTextureBaseFormat fmt, void *dest, c
     }
 }
 
-void convert_x8u24_to_u24x8(void *dest, const void *data, const uint32_t width, const uint32_t height) {
-    auto dst = static_cast<uint32_t *>(dest);
-    auto src = static_cast<const uint32_t *>(data);
+static void convert_U8U3U3U2_to_U8U8U8U8_basic(uint32_t *dst, const uint16_t *src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t src_value = src[i];
 
-    for (uint32_t row = 0; row < height; ++row) {
-        for (uint32_t col = 0; col < width; ++col) {
-            uint32_t src_value = src[row * width + col];
-            dst[row * width + col] = (src_value << 8) | (src_value >> 24);
-        }
+        const uint8_t alpha = (src_value & 0xFF00) >> 8;
+        const uint8_t red = (src_value & 0x00E0) >> 5;
+        const uint8_t green = (src_value & 0x001C) >> 2;
+        const uint8_t blue = (src_value & 0x0003);
+
+        const uint32_t value = (alpha << 24) | (blue << 22) | (blue << 20) | (blue << 18) | (blue << 16) | (green << 13) | (green << 10) | ((green & 0b110) << 7) | (red << 5) | (red << 2) | (red >> 1);
+
+        dst[i] = value;
+    }
+}
+
+static void convert_x8u24_to_u24x8_basic(uint32_t *dst, const uint32_t *src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t src_value = src[i];
+        dst[i] = (src_value << 8) | (src_value >> 24);
+    }
+}
+
+static void convert_u8u8u8_to_u8u8u8u8_basic(uint8_t *dst, const uint8_t *src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        // set 1.0 as the alpha channel
+        dst[3] = 255;
+
+        src += 3;
+        dst += 4;
+    }
+}
+
+// SIMD kernels used by the format conversions and the texture unswizzling
+// on x86 the SSE2 kernels are always available, faster ones are selected at runtime
+#if defined(__aarch64__)
+
+static void convert_U8U3U3U2_to_U8U8U8U8_NEON(uint32_t *dst, const uint16_t *src, size_t count) {
+    const uint32x4_t mask_3bits = vdupq_n_u32(0b111);
+    const uint32x4_t mask_2bits = vdupq_n_u32(0b11);
+    const uint32x4_t mask_alpha = vdupq_n_u32(0xFF00);
+
+    const auto expand = [&](uint32x4_t v) {
+        const uint32x4_t red = vandq_u32(vshrq_n_u32(v, 5), mask_3bits);
+        const uint32x4_t green = vandq_u32(vshrq_n_u32(v, 2), mask_3bits);
+        uint32x4_t blue = vandq_u32(v, mask_2bits);
+        blue = vorrq_u32(blue, vshlq_n_u32(blue, 2));
+        blue = vorrq_u32(blue, vshlq_n_u32(blue, 4));
+
+        uint32x4_t res = vshlq_n_u32(vandq_u32(v, mask_alpha), 16);
+        res = vorrq_u32(res, vshlq_n_u32(blue, 16));
+        res = vorrq_u32(res, vorrq_u32(vshlq_n_u32(green, 13), vshlq_n_u32(green, 10)));
+        res = vorrq_u32(res, vshlq_n_u32(vshrq_n_u32(green, 1), 8));
+        res = vorrq_u32(res, vorrq_u32(vshlq_n_u32(red, 5), vshlq_n_u32(red, 2)));
+        return vorrq_u32(res, vshrq_n_u32(red, 1));
+    };
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint16x8_t v = vld1q_u16(src + i);
+        vst1q_u32(dst + i, expand(vmovl_u16(vget_low_u16(v))));
+        vst1q_u32(dst + i + 4, expand(vmovl_u16(vget_high_u16(v))));
+    }
+    convert_U8U3U3U2_to_U8U8U8U8_basic(dst + i, src + i, count - i);
+}
+
+static void convert_x8u24_to_u24x8_NEON(uint32_t *dst, const uint32_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const uint32x4_t v = vld1q_u32(src + i);
+        vst1q_u32(dst + i, vsliq_n_u32(vshrq_n_u32(v, 24), v, 8));
+    }
+    convert_x8u24_to_u24x8_basic(dst + i, src + i, count - i);
+}
+
+static void convert_u8u8u8_to_u8u8u8u8_NEON(uint8_t *dst, const uint8_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+        const uint8x16x4_t rgba = { { rgb.val[0], rgb.val[1], rgb.val[2], vdupq_n_u8(255) } };
+        vst4q_u8(dst + i * 4, rgba);
+    }
+    convert_u8u8u8_to_u8u8u8u8_basic(dst + i * 4, src + i * 3, count - i);
+}
+
+#else
+
+static __m128i expand_U8U3U3U2_SSE2(__m128i v) {
+    const __m128i mask_3bits = _mm_set1_epi32(0b111);
+    const __m128i red = _mm_and_si128(_mm_srli_epi32(v, 5), mask_3bits);
+    const __m128i green = _mm_and_si128(_mm_srli_epi32(v, 2), mask_3bits);
+    __m128i blue = _mm_and_si128(v, _mm_set1_epi32(0b11));
+    blue = _mm_or_si128(blue, _mm_slli_epi32(blue, 2));
+    blue = _mm_or_si128(blue, _mm_slli_epi32(blue, 4));
+
+    __m128i res = _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xFF00)), 16);
+    res = _mm_or_si128(res, _mm_slli_epi32(blue, 16));
+    res = _mm_or_si128(res, _mm_or_si128(_mm_slli_epi32(green, 13), _mm_slli_epi32(green, 10)));
+    res = _mm_or_si128(res, _mm_slli_epi32(_mm_srli_epi32(green, 1), 8));
+    res = _mm_or_si128(res, _mm_or_si128(_mm_slli_epi32(red, 5), _mm_slli_epi32(red, 2)));
+    return _mm_or_si128(res, _mm_srli_epi32(red, 1));
+}
+
+static void convert_U8U3U3U2_to_U8U8U8U8_SSE2(uint32_t *dst, const uint16_t *src, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), expand_U8U3U3U2_SSE2(_mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4), expand_U8U3U3U2_SSE2(_mm_unpackhi_epi16(v, zero)));
+    }
+    convert_U8U3U3U2_to_U8U8U8U8_basic(dst + i, src + i, count - i);
+}
+
+static void TARGET_AVX2 convert_U8U3U3U2_to_U8U8U8U8_AVX2(uint32_t *dst, const uint16_t *src, size_t count) {
+    const __m256i mask_3bits = _mm256_set1_epi32(0b111);
+    const __m256i mask_2bits = _mm256_set1_epi32(0b11);
+    const __m256i mask_alpha = _mm256_set1_epi32(0xFF00);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+
+        const __m256i red = _mm256_and_si256(_mm256_srli_epi32(v, 5), mask_3bits);
+        const __m256i green = _mm256_and_si256(_mm256_srli_epi32(v, 2), mask_3bits);
+        __m256i blue = _mm256_and_si256(v, mask_2bits);
+        blue = _mm256_or_si256(blue, _mm256_slli_epi32(blue, 2));
+        blue = _mm256_or_si256(blue, _mm256_slli_epi32(blue, 4));
+
+        __m256i res = _mm256_slli_epi32(_mm256_and_si256(v, mask_alpha), 16);
+        res = _mm256_or_si256(res, _mm256_slli_epi32(blue, 16));
+        res = _mm256_or_si256(res, _mm256_or_si256(_mm256_slli_epi32(green, 13), _mm256_slli_epi32(green, 10)));
+        res = _mm256_or_si256(res, _mm256_slli_epi32(_mm256_srli_epi32(green, 1), 8));
+        res = _mm256_or_si256(res, _mm256_or_si256(_mm256_slli_epi32(red, 5), _mm256_slli_epi32(red, 2)));
+        res = _mm256_or_si256(res, _mm256_srli_epi32(red, 1));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), res);
     }
+    convert_U8U3U3U2_to_U8U8U8U8_basic(dst + i, src + i, count - i);
+}
+
+static void convert_x8u24_to_u24x8_SSE2(uint32_t *dst, const uint32_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_or_si128(_mm_slli_epi32(v, 8), _mm_srli_epi32(v, 24)));
+    }
+    convert_x8u24_to_u24x8_basic(dst + i, src + i, count - i);
+}
+
+static void TARGET_AVX2 convert_x8u24_to_u24x8_AVX2(uint32_t *dst, const uint32_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_or_si256(_mm256_slli_epi32(v, 8), _mm256_srli_epi32(v, 24)));
+    }
+    convert_x8u24_to_u24x8_basic(dst + i, src + i, count - i);
+}
+
+static void TARGET_SSSE3 convert_u8u8u8_to_u8u8u8u8_SSSE3(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    // each iteration reads 16 bytes but only uses the first 12 of them (4 pixels)
+    size_t i = 0;
+    for (; i + 6 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha));
+    }
+    convert_u8u8u8_to_u8u8u8u8_basic(dst + i * 4, src + i * 3, count - i);
+}
+
+static void TARGET_AVX2 convert_u8u8u8_to_u8u8u8u8_AVX2(uint8_t *dst, const uint8_t *src, size_t count) {
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+        0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+    // each lane gets 4 pixels, the upper lane reads up to byte 28 of the source
+    size_t i = 0;
+    for (; i + 10 <= count; i += 8) {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3 + 12));
+        const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha));
+    }
+    convert_u8u8u8_to_u8u8u8u8_basic(dst + i * 4, src + i * 3, count - i);
+}
+
+#endif
+
+struct ConversionFunctions {
+    void (*U8U3U3U2_to_U8U8U8U8)(uint32_t *dst, const uint16_t *src, size_t count);
+    void (*x8u24_to_u24x8)(uint32_t *dst, const uint32_t *src, size_t count);
+    void (*u8u8u8_to_u8u8u8u8)(uint8_t *dst, const uint8_t *src, size_t count);
+};
+
+static ConversionFunctions select_conversion_functions(int max_instrset) {
+#if defined(__aarch64__)
+    return { convert_U8U3U3U2_to_U8U8U8U8_NEON, convert_x8u24_to_u24x8_NEON, convert_u8u8u8_to_u8u8u8u8_NEON };
+#else
+    const int instrset = std::min(util::instrset::instrset_detect(), max_instrset);
+    if (instrset >= util::instrset::instrset_AVX2)
+        return { convert_U8U3U3U2_to_U8U8U8U8_AVX2, convert_x8u24_to_u24x8_AVX2, convert_u8u8u8_to_u8u8u8u8_AVX2 };
+    if (instrset >= util::instrset::instrset_SSSE3)
+        return { convert_U8U3U3U2_to_U8U8U8U8_SSE2, convert_x8u24_to_u24x8_SSE2, convert_u8u8u8_to_u8u8u8u8_SSSE3 };
+    return { convert_U8U3U3U2_to_U8U8U8U8_SSE2, convert_x8u24_to_u24x8_SSE2, convert_u8u8u8_to_u8u8u8u8_basic };
+#endif
+}
+
+// textures are decoded on multiple threads, so the selection is done once in a thread-safe static
+static ConversionFunctions &get_conversion_functions() {
+    static ConversionFunctions functions = []() -> ConversionFunctions {
+#if !defined(__aarch64__)
+        if (util::instrset::instrset_detect() >= util::instrset::instrset_AVX2)
+            LOG_INFO("AVX2 instruction set is supported. Using AVX2 texture conversions");
+        else
+            LOG_INFO("AVX2 instruction set is not supported. Using SSE texture conversions");
+#endif
+        return select_conversion_functions(std::numeric_limits<int>::max());
+    }();
+    return functions;
+}
+
+void set_conversion_max_instrset(int max_instrset) {
+    get_conversion_functions() = select_conversion_functions(max_instrset);
+}
+
+void convert_x8u24_to_u24x8(void *dest, const void *data, const uint32_t width, const uint32_t height) {
+    get_conversion_functions().x8u24_to_u24x8(static_cast<uint32_t *>(dest), static_cast<const uint32_t *>(data), static_cast<size_t>(width) * height);
+}
+
+void convert_U8U3U3U2_to_U8U8U8U8(void *dest, const void *data, const uint32_t width, const uint32_t height) {
+    get_conversion_functions().U8U3U3U2_to_U8U8U8U8(static_cast<uint32_t *>(dest), static_cast<const uint16_t *>(data), static_cast<size_t>(width) * height);
+}
+
+void convert_u8u8u8_to_u8u8u8u8(void *dest, const void *data, const uint32_t width, const uint32_t height) {
+    get_conversion_functions().u8u8u8_to_u8u8u8u8(static_cast<uint8_t *>(dest), static_cast<const uint8_t *>(data), static_cast<size_t>(width) * height);
 }
 
 void convert_x8u24_to_f32(void *dest, const void *data, const uint32_t width, const uint32_t height, const SceGxmTextureFormat format) {
@@ -191,26 +440,6 @@ void convert_x8u24_to_f32(void *dest, const void *data, const uint32_t width, co
     }
 }
 
-void convert_U8U3U3U2_to_U8U8U8U8(void *dest, const void *data, const uint32_t width, const uint32_t height) {
-    auto dst = static_cast<uint32_t *>(dest);
-    auto src = static_cast<const uint16_t *>(data);
-
-    for (uint32_t row = 0; row < height; ++row) {
-        for (uint32_t col = 0; col < width; ++col) {
-            const uint32_t src_value = src[row * width + col];
-
-            const uint8_t alpha = (src_value & 0xFF00) >> 8;
-            const uint8_t red = (src_value & 0x00E0) >> 5;
-            const uint8_t green = (src_value & 0x001C) >> 2;
-            const uint8_t blue = (src_value & 0x0003);
-
-            const uint32_t value = (alpha << 24) | (blue << 22) | (blue << 20) | (blue << 18) | (blue << 16) | (green << 13) | (green << 10) | ((green & 0b110) << 7) | (red << 5) | (red << 2) | (red >> 1);
-
-            dst[row * width + col] = value;
-        }
-    }
-}
-
 void convert_f32m_to_f32(void *dest, const void *data, const uint32_t width, const uint32_t height) {
     auto dst = static_cast<uint32_t *>(dest);
     auto src = static_cast<const uint32_t *>(data);
@@ -321,6 +550,90 @@ uint32_t encode_morton(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
     return result;
 }
 
+// Copy a 4x4 block of swizzled pixels (16 consecutive pixels in the source) to its linear location
+// In the source, the bits of the pixel index are y0 x0 y1 x1 (from lowest to highest)
+template <uint32_t bytes_per_pixel>
+static void unswizzle_block(uint8_t *dest, const size_t row_pitch, const uint8_t *src) {
+#if defined(__aarch64__)
+    if constexpr (bytes_per_pixel == 4) {
+        // each vector is a 2x2 quad ((0,0) (0,1) (1,0) (1,1)), rows are made of the even and odd elements
+        const uint32_t *src32 = reinterpret_cast<const uint32_t *>(src);
+        const uint32x4_t v0 = vld1q_u32(src32);
+        const uint32x4_t v1 = vld1q_u32(src32 + 4);
+        const uint32x4_t v2 = vld1q_u32(src32 + 8);
+        const uint32x4_t v3 = vld1q_u32(src32 + 12);
+        vst1q_u32(reinterpret_cast<uint32_t *>(dest), vuzp1q_u32(v0, v2));
+        vst1q_u32(reinterpret_cast<uint32_t *>(dest + row_pitch), vuzp2q_u32(v0, v2));
+        vst1q_u32(reinterpret_cast<uint32_t *>(dest + 2 * row_pitch), vuzp1q_u32(v1, v3));
+        vst1q_u32(reinterpret_cast<uint32_t *>(dest + 3 * row_pitch), vuzp2q_u32(v1, v3));
+        return;
+    } else if constexpr (bytes_per_pixel == 8) {
+        // each vector is a vertical pair of pixels
+        const uint64_t *src64 = reinterpret_cast<const uint64_t *>(src);
+        uint64x2_t v[8];
+        for (int i = 0; i < 8; i++)
+            v[i] = vld1q_u64(src64 + 2 * i);
+        for (int row = 0; row < 4; row += 2) {
+            uint64_t *line = reinterpret_cast<uint64_t *>(dest + row * row_pitch);
+            uint64_t *next_line = reinterpret_cast<uint64_t *>(dest + (row + 1) * row_pitch);
+            vst1q_u64(line, vzip1q_u64(v[row], v[row + 1]));
+            vst1q_u64(line + 2, vzip1q_u64(v[row + 4], v[row + 5]));
+            vst1q_u64(next_line, vzip2q_u64(v[row], v[row + 1]));
+            vst1q_u64(next_line + 2, vzip2q_u64(v[row + 4], v[row + 5]));
+        }
+        return;
+    }
+#else
+    if constexpr (bytes_per_pixel == 4) {
+        // each vector is a 2x2 quad ((0,0) (0,1) (1,0) (1,1)), rows are made of the even and odd elements
+        const __m128 v0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+        const __m128 v1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16)));
+        const __m128 v2 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32)));
+        const __m128 v3 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48)));
+        _mm_storeu_ps(reinterpret_cast<float *>(dest), _mm_shuffle_ps(v0, v2, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(reinterpret_cast<float *>(dest + row_pitch), _mm_shuffle_ps(v0, v2, _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm_storeu_ps(reinterpret_cast<float *>(dest + 2 * row_pitch), _mm_shuffle_ps(v1, v3, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(reinterpret_cast<float *>(dest + 3 * row_pitch), _mm_shuffle_ps(v1, v3, _MM_SHUFFLE(3, 1, 3, 1)));
+        return;
+    } else if constexpr (bytes_per_pixel == 8) {
+        // each vector is a vertical pair of pixels
+        __m128i v[8];
+        for (int i = 0; i < 8; i++)
+            v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16 * i));
+        for (int row = 0; row < 4; row += 2) {
+            __m128i *line = reinterpret_cast<__m128i *>(dest + row * row_pitch);
+            __m128i *next_line = reinterpret_cast<__m128i *>(dest + (row + 1) * row_pitch);
+            _mm_storeu_si128(line, _mm_unpacklo_epi64(v[row], v[row + 1]));
+            _mm_storeu_si128(line + 1, _mm_unpacklo_epi64(v[row + 4], v[row + 5]));
+            _mm_storeu_si128(next_line, _mm_unpackhi_epi64(v[row], v[row + 1]));
+            _mm_storeu_si128(next_line + 1, _mm_unpackhi_epi64(v[row + 4], v[row + 5]));
+        }
+        return;
+    }
+#endif
+
+    for (uint32_t i = 0; i < 16; i++) {
+        const uint32_t x = ((i >> 1) & 1) | ((i >> 2) & 2);
+        const uint32_t y = (i & 1) | ((i >> 1) & 2);
+        memcpy(dest + y * row_pitch + x * bytes_per_pixel, src + i * bytes_per_pixel, bytes_per_pixel);
+    }
+}
+
+template <uint32_t bytes_per_pixel>
+static void swizzled_texture_to_linear_texture_blocks(uint8_t *dest, const uint8_t *src, uint16_t width, uint16_t height) {
+    const size_t row_pitch = static_cast<size_t>(width) * bytes_per_pixel;
+
+    // go through the destination in order, this is a lot more cache friendly than following the source
+    // min(width, height) is at least 4, so a 4x4 block is always contiguous in the source
+    for (uint16_t y = 0; y < height; y += 4) {
+        uint8_t *dest_row = dest + y * row_pitch;
+        for (uint16_t x = 0; x < width; x += 4) {
+            const uint32_t src_index = encode_morton(x, y, width, height);
+            unswizzle_block<bytes_per_pixel>(dest_row + x * bytes_per_pixel, row_pitch, src + src_index * bytes_per_pixel);
+        }
+    }
+}
+
 void swizzled_texture_to_linear_texture(uint8_t *dest, const uint8_t *src, uint16_t width, uint16_t height, uint8_t bits_per_pixel) {
     if (bits_per_pixel % 8 != 0) {
         // Don't support yet
@@ -331,6 +644,26 @@ void swizzled_texture_to_linear_texture(uint8_t *dest, const uint8_t *src, uint1
     uint32_t min = std::min(width, height);
     uint32_t k = std::bit_width(min) - 1;
 
+    // fast path, copy whole 4x4 blocks at once
+    if (min >= 4 && std::has_single_bit(width) && std::has_single_bit(height)) {
+        switch (bytes_per_pixel) {
+        case 1:
+            return swizzled_texture_to_linear_texture_blocks<1>(dest, src, width, height);
+        case 2:
+            return swizzled_texture_to_linear_texture_blocks<2>(dest, src, width, height);
+        case 3:
+            return swizzled_texture_to_linear_texture_blocks<3>(dest, src, width, height);
+        case 4:
+            return swizzled_texture_to_linear_texture_blocks<4>(dest, src, width, height);
+        case 8:
+            return swizzled_texture_to_linear_texture_blocks<8>(dest, src, width, height);
+        case 16:
+            return swizzled_texture_to_linear_texture_blocks<16>(dest, src, width, height);
+        default:
+            break;
+        }
+    }
+
     for (uint32_t i = 0; i < width * static_cast<uint32_t>(height); i++) {
         uint32_t x = decode_morton2_x(i) & (min - 1);
         uint32_t y = decode_morton2_y(i) & (min - 1);
@@ -356,15 +689,17 @@ void tiled_texture_to_linear_texture(uint8_t *dest, const uint8_t *src, uint16_t
     const uint32_t width_in_tiles = (width + 31) >> 5;
 
     for (uint16_t y = 0; y < height; y++) {
-        for (uint16_t x = 0; x < width; x++) {
-            // Calculate texel address in tile
-            const uint32_t texel_offset_in_tile = (x & 0b11111) | ((y & 0b11111) << 5);
-            const uint32_t tile_address = (x >> 5) + width_in_tiles * (y >> 5);
+        // a row of a tile is contiguous in memory, copy it at once
+        for (uint32_t tile_x = 0; tile_x < width_in_tiles; tile_x++) {
+            const uint32_t x = tile_x << 5;
+            const uint32_t texel_offset_in_tile = (y & 0b11111) << 5;
+            const uint32_t tile_address = tile_x + width_in_tiles * (y >> 5);
 
             const uint32_t offset = ((tile_address << 10) | (texel_offset_in_tile)) * bpp;
+            const uint32_t row_length = std::min<uint32_t>(32, width - x);
 
             // Make scanline
-            memcpy(dest + ((y * width) + x) * bpp, src + offset, bpp);
+            memcpy(dest + ((y * width) + x) * bpp, src + offset, row_length * bpp);
         }
     }
 }
@@ -393,13 +393,7 @@ void TextureCache::export_texture_impl(SceGxmTextureBaseFormat base_format, uint
     if (base_format == SCE_GXM_TEXTURE_BASE_FORMAT_U8U8U8 || base_format == SCE_GXM_TEXTURE_BASE_FORMAT_S8S8S8) {
         // 24bpp textures are not supported nby dds files, convert them to rgba8
         expanded_data.resize(width * height * 4);
-        const uint8_t *data = static_cast<const uint8_t *>(pixels);
-        for (uint32_t i = 0; i < width * height; i++) {
-            expanded_data[4 * i + 0] = data[3 * i + 0];
-            expanded_data[4 * i + 1] = data[3 * i + 1];
-            expanded_data[4 * i + 2] = data[3 * i + 2];
-            expanded_data[4 * i + 3] = 255;
-        }
+        texture::convert_u8u8u8_to_u8u8u8u8(expanded_data.data(), pixels, width, height);
         pixels = expanded_data.data();
         base_format = (base_format == SCE_GXM_TEXTURE_BASE_FORMAT_U8U8U8) ? SCE_GXM_TEXTURE_BASE_FORMAT_U8U8U8U8 : SCE_GXM_TEXTURE_BASE_FORMAT_S8S8S8S8;
     }
@@ -648,6 +648,8 @@ void VKState::late_init(const Config &cfg, const std::string_view game_id, MemSt
     pipeline_cache.init();
 
     texture_cache.init(false, texture_folder(), game_id);
+    // the GPU writes directly to the guest memory when it is mapped, these writes can't be tracked
+    texture_cache.use_page_tracking = cfg.page_tracked_texture_cache && !features.support_memory_mapping;
 }
 
 void VKState::cleanup() {
@@ -758,22 +760,7 @@ std::vector<uint32_t> VKState::dump_frame(DisplayState &display, uint32_t &width
 }
 
 uint32_t VKState::get_features_mask() {
-    union {
-        struct {
-            bool use_shader_interlock : 1;
-            bool use_texture_viewport : 1;
-            bool use_memory_mapping : 1;
-        };
-        uint32_t value;
-    } features_mask;
-    static_assert(sizeof(features_mask) == sizeof(uint32_t));
-
-    features_mask.value = 0;
-    features_mask.use_shader_interlock = features.support_shader_interlock;
-    features_mask.use_texture_viewport = features.use_texture_viewport;
-    features_mask.use_memory_mapping = features.support_memory_mapping;
-
-    return features_mask.value;
+    return get_vk_features_mask(features);
 }
 
 int VKState::get_supported_filters() {
@@ -970,8 +957,8 @@ void VKState::precompile_shader(const ShadersHash &hash) {
         pipeline_cache.precompile_shader(hash.frag);
     }
 
-    programs_count_pre_compiled++;
-    LOG_INFO("Program Compiled {}/{}", programs_count_pre_compiled, shaders_cache_hashs.size());
+    const uint32_t nb_compiled = ++programs_count_pre_compiled;
+    LOG_INFO("Program Compiled {}/{}", nb_compiled, shaders_cache_hashs.size());
 }
 
 void VKState::preclose_action() {
@@ -271,14 +271,25 @@ static void bind_vertex_streams(VKContext &context, MemState &mem) {
             } else {
                 const uint8_t *stream = state.vertex_streams[i].data.get(mem);
                 uint32_t stream_size = state.vertex_streams[i].size;
+                uint32_t stream_start = state.vertex_streams[i].start;
 #ifdef __APPLE__
                 // Vulkan allows any stride, but Metal only allows multiples of 4.
                 const bool restride = vertex_program.streams[i].stride % 4 != 0;
                 if (restride) {
                     restride_stream(stream, stream_size, vertex_program.streams[i].stride);
+                    stream_start = 0;
                 }
 #endif
-                context.vertex_stream_ring_buffer.allocate(context.prerender_cmd, stream_size, stream);
+                // only copy the part of the stream used by the draw, then bind the buffer as if the whole stream was there
+                // if there is not enough space before the allocation for this, reserve the unused part too
+                const uint32_t used_size = stream_size - stream_start;
+                context.vertex_stream_ring_buffer.allocate(used_size);
+                if (context.vertex_stream_ring_buffer.data_offset >= stream_start) {
+                    context.vertex_stream_ring_buffer.data_offset -= stream_start;
+                } else {
+                    context.vertex_stream_ring_buffer.allocate(stream_size);
+                }
+                context.vertex_stream_ring_buffer.copy(context.prerender_cmd, used_size, stream + stream_start, stream_start);
                 context.vertex_stream_offsets[i] = context.vertex_stream_ring_buffer.data_offset;
 
 #ifdef __APPLE__
@@ -290,6 +301,7 @@ static void bind_vertex_streams(VKContext &context, MemState &mem) {
 
             state.vertex_streams[i].data = nullptr;
             state.vertex_streams[i].size = 0;
+            state.vertex_streams[i].start = 0;
         }
     }
 
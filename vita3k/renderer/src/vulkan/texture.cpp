@@ -385,21 +385,7 @@ void VKTextureCache::configure_texture(const SceGxmTexture &gxm_texture) {
 // add an alpha channel to u8u8u8 textures
 static void *add_alpha_channel(const void *pixels, const uint32_t width, const uint32_t height, std::vector<uint8_t> &data) {
     data.resize(width * height * 4);
-
-    const uint8_t *src = static_cast<const uint8_t *>(pixels);
-    uint8_t *dst = data.data();
-    for (uint32_t y = 0; y < height; y++) {
-        for (uint32_t x = 0; x < width; x++) {
-            dst[0] = src[0];
-            dst[1] = src[1];
-            dst[2] = src[2];
-            // set 1.0 as the alpha channel
-            dst[3] = 255;
-
-            src += 3;
-            dst += 4;
-        }
-    }
+    renderer::texture::convert_u8u8u8_to_u8u8u8u8(data.data(), pixels, width, height);
 
     return data.data();
 }
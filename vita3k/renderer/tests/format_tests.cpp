@@ -0,0 +1,190 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <renderer/functions.h>
+#include <util/instrset_detect.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// the widths are not multiple of the vector sizes, so the remaining pixels are tested too
+static constexpr uint32_t TEST_WIDTHS[] = { 1, 3, 4, 5, 7, 8, 9, 10, 11, 15, 16, 17, 33, 67 };
+
+// each kernel which can be selected at runtime, from the most to the least recent instruction set
+static constexpr int TEST_INSTRSETS[] = {
+    std::numeric_limits<int>::max(),
+    util::instrset::instrset_SSSE3,
+    util::instrset::instrset_SSE2,
+};
+
+static std::vector<uint8_t> make_bytes(size_t count, uint32_t seed) {
+    std::vector<uint8_t> bytes(count);
+    for (uint8_t &byte : bytes) {
+        seed = seed * 1664525 + 1013904223;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+
+    return bytes;
+}
+
+// run a test with each conversion kernel, then go back to the default ones
+template <typename F>
+static void for_each_instrset(F &&test) {
+    for (const int instrset : TEST_INSTRSETS) {
+        SCOPED_TRACE(testing::Message() << "instrset " << instrset);
+        renderer::texture::set_conversion_max_instrset(instrset);
+        test();
+    }
+    renderer::texture::set_conversion_max_instrset(std::numeric_limits<int>::max());
+}
+
+TEST(texture_format, U8U3U3U2_to_U8U8U8U8_golden) {
+    // alpha 0x80, red 0b101, green 0b010, blue 0b11
+    const uint16_t src[] = { 0x80AB, 0x0000, 0xFFFF };
+    uint32_t dest[3];
+    renderer::texture::convert_U8U3U3U2_to_U8U8U8U8(dest, src, 3, 1);
+
+    EXPECT_EQ(dest[0], 0x80FF49B6);
+    EXPECT_EQ(dest[1], 0x00000000);
+    EXPECT_EQ(dest[2], 0xFFFFFFFF);
+}
+
+TEST(texture_format, U8U3U3U2_to_U8U8U8U8_matches_reference) {
+    for_each_instrset([] {
+        for (const uint32_t width : TEST_WIDTHS) {
+            const std::vector<uint8_t> bytes = make_bytes(width * 2, width);
+            std::vector<uint16_t> src(width);
+            memcpy(src.data(), bytes.data(), bytes.size());
+
+            std::vector<uint32_t> dest(width);
+            renderer::texture::convert_U8U3U3U2_to_U8U8U8U8(dest.data(), src.data(), width, 1);
+            for (uint32_t i = 0; i < width; i++) {
+                const uint32_t alpha = src[i] >> 8;
+                const uint32_t red = (src[i] >> 5) & 0b111;
+                const uint32_t green = (src[i] >> 2) & 0b111;
+                const uint32_t blue = src[i] & 0b11;
+                // each channel is expanded by repeating its bits
+                const uint32_t expected = (alpha << 24) | ((blue * 0x55) << 16) | (((green << 5) | (green << 2) | (green >> 1)) << 8) | ((red << 5) | (red << 2) | (red >> 1));
+                ASSERT_EQ(dest[i], expected) << width << " pixels, pixel " << i;
+            }
+        }
+    });
+}
+
+TEST(texture_format, x8u24_to_u24x8_matches_reference) {
+    for_each_instrset([] {
+        for (const uint32_t width : TEST_WIDTHS) {
+            const std::vector<uint8_t> bytes = make_bytes(width * 4, width);
+            std::vector<uint32_t> src(width);
+            memcpy(src.data(), bytes.data(), bytes.size());
+
+            std::vector<uint32_t> dest(width);
+            renderer::texture::convert_x8u24_to_u24x8(dest.data(), src.data(), width, 1);
+            for (uint32_t i = 0; i < width; i++)
+                ASSERT_EQ(dest[i], (src[i] << 8) | (src[i] >> 24)) << width << " pixels, pixel " << i;
+        }
+    });
+}
+
+TEST(texture_format, u8u8u8_to_u8u8u8u8_matches_reference) {
+    for_each_instrset([] {
+        for (const uint32_t width : TEST_WIDTHS) {
+            const std::vector<uint8_t> src = make_bytes(width * 3, width);
+            // the destination is bigger than needed to catch writes past the end
+            std::vector<uint8_t> dest(width * 4 + 16, 0xCD);
+            renderer::texture::convert_u8u8u8_to_u8u8u8u8(dest.data(), src.data(), width, 1);
+            for (uint32_t i = 0; i < width; i++) {
+                ASSERT_EQ(dest[i * 4], src[i * 3]) << width << " pixels, pixel " << i;
+                ASSERT_EQ(dest[i * 4 + 1], src[i * 3 + 1]) << width << " pixels, pixel " << i;
+                ASSERT_EQ(dest[i * 4 + 2], src[i * 3 + 2]) << width << " pixels, pixel " << i;
+                ASSERT_EQ(dest[i * 4 + 3], 255) << width << " pixels, pixel " << i;
+            }
+            for (size_t i = width * 4; i < dest.size(); i++)
+                ASSERT_EQ(dest[i], 0xCD) << width << " pixels, byte " << i;
+        }
+    });
+}
+
+// the pixel index bits alternate between y and x (starting with y) on the smallest side,
+// the remaining upper bits belong to the biggest side
+static void swizzled_texture_to_linear_texture_reference(uint8_t *dest, const uint8_t *src, uint32_t width, uint32_t height, uint32_t bytes_per_pixel) {
+    const uint32_t min = std::min(width, height);
+    const uint32_t k = std::bit_width(min) - 1;
+    for (uint32_t i = 0; i < width * height; i++) {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        for (uint32_t bit = 0; bit < k; bit++) {
+            y |= ((i >> (2 * bit)) & 1) << bit;
+            x |= ((i >> (2 * bit + 1)) & 1) << bit;
+        }
+        if (width >= height)
+            x |= (i >> (2 * k)) << k;
+        else
+            y |= (i >> (2 * k)) << k;
+
+        memcpy(dest + (y * width + x) * bytes_per_pixel, src + i * bytes_per_pixel, bytes_per_pixel);
+    }
+}
+
+TEST(texture_format, swizzled_texture_matches_reference) {
+    static constexpr uint32_t SIZES[] = { 1, 2, 4, 8, 16, 64 };
+    static constexpr uint32_t BYTES_PER_PIXEL[] = { 1, 2, 3, 4, 8, 16 };
+    for (const uint32_t bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (const uint32_t width : SIZES) {
+            for (const uint32_t height : SIZES) {
+                const std::vector<uint8_t> src = make_bytes(width * height * bytes_per_pixel, width * 131 + height);
+                std::vector<uint8_t> dest(src.size());
+                std::vector<uint8_t> expected(src.size());
+
+                renderer::texture::swizzled_texture_to_linear_texture(dest.data(), src.data(), width, height, bytes_per_pixel * 8);
+                swizzled_texture_to_linear_texture_reference(expected.data(), src.data(), width, height, bytes_per_pixel);
+                ASSERT_EQ(dest, expected) << width << "x" << height << ", " << bytes_per_pixel << " bytes per pixel";
+            }
+        }
+    }
+}
+
+TEST(texture_format, tiled_texture_matches_reference) {
+    static constexpr uint32_t HEIGHTS[] = { 1, 3, 32, 33 };
+    static constexpr uint32_t BYTES_PER_PIXEL[] = { 1, 2, 4, 8 };
+    for (const uint32_t bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (const uint32_t width : TEST_WIDTHS) {
+            for (const uint32_t height : HEIGHTS) {
+                // the texture is made of 32x32 tiles, each of them stored in row order
+                const uint32_t width_in_tiles = (width + 31) / 32;
+                const uint32_t height_in_tiles = (height + 31) / 32;
+                const std::vector<uint8_t> src = make_bytes(width_in_tiles * height_in_tiles * 1024 * bytes_per_pixel, width * 131 + height);
+                std::vector<uint8_t> dest(width * height * bytes_per_pixel);
+                renderer::texture::tiled_texture_to_linear_texture(dest.data(), src.data(), width, height, bytes_per_pixel * 8);
+
+                for (uint32_t y = 0; y < height; y++) {
+                    for (uint32_t x = 0; x < width; x++) {
+                        const uint32_t tile = (y / 32) * width_in_tiles + x / 32;
+                        const uint32_t src_index = tile * 1024 + (y % 32) * 32 + x % 32;
+                        ASSERT_EQ(memcmp(dest.data() + (y * width + x) * bytes_per_pixel, src.data() + src_index * bytes_per_pixel, bytes_per_pixel), 0)
+                            << width << "x" << height << ", " << bytes_per_pixel << " bytes per pixel, pixel (" << x << ", " << y << ")";
+                    }
+                }
+            }
+        }
+    }
+}
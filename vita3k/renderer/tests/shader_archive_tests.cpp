@@ -0,0 +1,80 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <renderer/file_writer.h>
+#include <renderer/shader_archive.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+class shader_archive : public testing::Test {
+protected:
+    void SetUp() override {
+        folder = fs::temp_directory_path() / fs::unique_path("vita3k-shader-archive-%%%%-%%%%");
+        fs::create_directories(folder);
+        path = folder / "shaders.pack";
+    }
+
+    void TearDown() override {
+        writer.flush();
+        fs::remove_all(folder);
+    }
+
+    static void write(renderer::ShaderArchive &archive, const std::string &name, const std::string &data) {
+        archive.write(name, data.data(), data.size());
+    }
+
+    static std::string read(renderer::ShaderArchive &archive, const std::string &name) {
+        return archive.read<std::string>(name);
+    }
+
+    renderer::FileWriter writer;
+    fs::path folder;
+    fs::path path;
+};
+
+TEST_F(shader_archive, write_and_reopen) {
+    renderer::ShaderArchive archive(writer);
+    archive.open(path);
+    EXPECT_FALSE(fs::exists(path));
+
+    write(archive, "a.vert", "first");
+    write(archive, "b.frag", "second");
+    write(archive, "a.vert", "third");
+    EXPECT_EQ(read(archive, "a.vert"), "third");
+
+    archive.open(path);
+    EXPECT_EQ(read(archive, "a.vert"), "third");
+    EXPECT_EQ(read(archive, "b.frag"), "second");
+    EXPECT_EQ(read(archive, "c.frag"), "");
+}
+
+TEST_F(shader_archive, write_after_close) {
+    renderer::ShaderArchive archive(writer);
+    archive.open(path);
+    write(archive, "a.vert", "first");
+    archive.close();
+
+    // the closed archive can be removed, writing to it must not create it again
+    fs::remove(path);
+    write(archive, "b.frag", "second");
+    writer.flush();
+    EXPECT_FALSE(fs::exists(path));
+    EXPECT_EQ(read(archive, "b.frag"), "");
+}
@@ -23,6 +23,7 @@
 
 #include <features/state.h>
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -65,12 +66,22 @@ struct GeneratedShader {
     usse::SpirvCode spirv;
 };
 
+// Time spent in each phase of convert_gxp
+struct ConversionTimings {
+    // parameters of the program and control flow analysis of the USSE code
+    std::chrono::nanoseconds analysis{};
+    // the rest of the SPIR-V generation, mostly decoding and recompiling the USSE instructions
+    std::chrono::nanoseconds translation{};
+    // SPIR-V to GLSL with SPIRV-Cross, only for the GLSLOpenGL target
+    std::chrono::nanoseconds glsl{};
+};
+
 // Dump generated SPIR-V disassembly up to this point
 void spirv_disasm_print(const usse::SpirvCode &spirv_binary, std::string *spirv_dump = nullptr);
 
 // the returned object will only have its glsl or spirv field non-empty depending on the target
 GeneratedShader convert_gxp(const SceGxmProgram &program, const std::string &shader_hash, const FeatureState &features, const Target target, const Hints &hints, bool maskupdate = false,
-    bool force_shader_debug = false, const std::function<bool(const std::string &ext, const std::string &dump)> &dumper = nullptr);
+    bool force_shader_debug = false, const std::function<bool(const std::string &ext, const std::string &dump)> &dumper = nullptr, ConversionTimings *timings = nullptr);
 
 void convert_gxp_to_glsl_from_filepath(const std::string &shader_filepath_utf8);
 
@@ -32,6 +32,10 @@ class Builder;
 class Function;
 } // namespace spv
 
+namespace shader {
+struct ConversionTimings;
+}
+
 namespace shader::usse {
 struct SpirvShaderParameters;
 struct NonDependentTextureQueryCallInfo;
@@ -43,6 +47,9 @@ struct SpirvUtilFunctions;
 using NonDependentTextureQueryCallInfos = std::vector<NonDependentTextureQueryCallInfo>;
 
 void convert_gxp_usse_to_spirv(spv::Builder &b, const SceGxmProgram &program, const FeatureState &features, const SpirvShaderParameters &parameters, utils::SpirvUtilFunctions &utils,
-    spv::Function *begin_hook_func, spv::Function *end_hook_func, const NonDependentTextureQueryCallInfos &queries, const uint32_t render_info_id, spv::Function *spv_func_main, std::vector<uint32_t> &interfaces);
+    spv::Function *begin_hook_func, spv::Function *end_hook_func, const NonDependentTextureQueryCallInfos &queries, const uint32_t render_info_id, spv::Function *spv_func_main, std::vector<uint32_t> &interfaces, ConversionTimings *timings = nullptr);
+
+// Name of the matcher decoding this instruction, nullptr if none matches.
+const char *get_usse_instruction_name(uint64_t instruction);
 
 } // namespace shader::usse
@@ -1367,9 +1367,9 @@ static SpirvShaderParameters create_parameters(spv::Builder &b, const SceGxmProg
 
 static void generate_shader_body(spv::Builder &b, const SpirvShaderParameters &parameters, const SceGxmProgram &program,
     const FeatureState &features, utils::SpirvUtilFunctions &utils, spv::Function *begin_hook_func, spv::Function *end_hook_func,
-    const NonDependentTextureQueryCallInfos &texture_queries, const spv::Id render_info_id, spv::Function *spv_func_main, std::vector<spv::Id> &interfaces) {
+    const NonDependentTextureQueryCallInfos &texture_queries, const spv::Id render_info_id, spv::Function *spv_func_main, std::vector<spv::Id> &interfaces, ConversionTimings *timings) {
     // Do texture queries
-    usse::convert_gxp_usse_to_spirv(b, program, features, parameters, utils, begin_hook_func, end_hook_func, texture_queries, render_info_id, spv_func_main, interfaces);
+    usse::convert_gxp_usse_to_spirv(b, program, features, parameters, utils, begin_hook_func, end_hook_func, texture_queries, render_info_id, spv_func_main, interfaces, timings);
 }
 
 static spv::Function *make_frag_finalize_function(spv::Builder &b, const SpirvShaderParameters &parameters,
@@ -1753,7 +1753,7 @@ static void generate_update_mask_body(spv::Builder &b, TranslationState &transla
     b.createStore(mask_v, out);
 }
 
-static SpirvCode convert_gxp_to_spirv_impl(const SceGxmProgram &program, const std::string &shader_hash, const FeatureState &features, TranslationState &translation_state, bool force_shader_debug, const std::function<bool(const std::string &ext, const std::string &dump)> &dumper) {
+static SpirvCode convert_gxp_to_spirv_impl(const SceGxmProgram &program, const std::string &shader_hash, const FeatureState &features, TranslationState &translation_state, bool force_shader_debug, const std::function<bool(const std::string &ext, const std::string &dump)> &dumper, ConversionTimings *timings) {
     SpirvCode spirv;
 
     SceGxmProgramType program_type = program.get_type();
@@ -1842,7 +1842,10 @@ static SpirvCode convert_gxp_to_spirv_impl(const SceGxmProgram &program, const s
     }
 
     // Generate parameters
+    const auto parameters_start = std::chrono::steady_clock::now();
     SpirvShaderParameters parameters = create_parameters(b, program, utils, features, translation_state, program_type, texture_queries);
+    if (timings)
+        timings->analysis += std::chrono::steady_clock::now() - parameters_start;
 
     if (!translation_state.is_maskupdate) {
         if (program.is_fragment()) {
@@ -1872,7 +1875,7 @@ static SpirvCode convert_gxp_to_spirv_impl(const SceGxmProgram &program, const s
             });
         }
 
-        generate_shader_body(b, parameters, program, features, utils, begin_hook_func, end_hook_func, texture_queries, translation_state.render_info_id, spv_func_main, translation_state.interfaces);
+        generate_shader_body(b, parameters, program, features, utils, begin_hook_func, end_hook_func, texture_queries, translation_state.render_info_id, spv_func_main, translation_state.interfaces, timings);
     } else {
         generate_update_mask_body(b, translation_state);
     }
@@ -1989,7 +1992,7 @@ static spv::ImageFormat translate_color_format(const SceGxmColorBaseFormat forma
 // ***************************
 
 GeneratedShader convert_gxp(const SceGxmProgram &program, const std::string &shader_hash, const FeatureState &features, const Target target, const Hints &hints, bool maskupdate,
-    bool force_shader_debug, const std::function<bool(const std::string &ext, const std::string &dump)> &dumper) {
+    bool force_shader_debug, const std::function<bool(const std::string &ext, const std::string &dump)> &dumper, ConversionTimings *timings) {
     TranslationState translation_state;
     translation_state.is_fragment = program.is_fragment();
     translation_state.is_maskupdate = maskupdate;
@@ -2003,12 +2006,21 @@ GeneratedShader convert_gxp(const SceGxmProgram &program, const std::string &sha
     }
 
     GeneratedShader shader{};
-    shader.spirv = convert_gxp_to_spirv_impl(program, shader_hash, features, translation_state, force_shader_debug, dumper);
+    ConversionTimings spirv_timings{};
+    const auto spirv_start = std::chrono::steady_clock::now();
+    shader.spirv = convert_gxp_to_spirv_impl(program, shader_hash, features, translation_state, force_shader_debug, dumper, &spirv_timings);
+    const auto spirv_end = std::chrono::steady_clock::now();
+    if (timings) {
+        timings->analysis = spirv_timings.analysis;
+        timings->translation = spirv_end - spirv_start - spirv_timings.analysis;
+    }
 
     if (translation_state.is_target_glsl) {
         // also generate the glsl file
         // this destroys shader.spirv
         shader.glsl = convert_spirv_to_glsl(shader_hash, shader.spirv, features, translation_state);
+        if (timings)
+            timings->glsl = std::chrono::steady_clock::now() - spirv_end;
 
         if (LOG_SHADER_CODE || force_shader_debug) {
             LOG_INFO("Generated GLSL:\n{}", shader.glsl);
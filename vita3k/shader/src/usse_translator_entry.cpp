@@ -20,20 +20,46 @@
 #include <gxm/types.h>
 #include <shader/decoder_detail.h>
 #include <shader/matcher.h>
+#include <shader/spirv_recompiler.h>
 #include <shader/usse_disasm.h>
+#include <shader/usse_matcher_table.h>
 #include <shader/usse_translator.h>
 #include <shader/usse_translator_types.h>
 #include <util/log.h>
 
-#include <optional>
+#include <algorithm>
+#include <vector>
 
 namespace shader::usse {
 
 template <typename Visitor>
 using USSEMatcher = shader::decoder::Matcher<Visitor, uint64_t>;
 
+// The matchers are put in buckets indexed by the top bits of the instruction, which hold opcode1 and
+// the sub-opcodes of the 11111 group. A bucket only holds the matchers that can match an instruction
+// starting with its bits, in the table order so the first match stays the same as with the full table.
+constexpr int USSE_BUCKET_BITS = 12;
+constexpr int USSE_BUCKET_SHIFT = 64 - USSE_BUCKET_BITS;
+
+template <typename V>
+using USSEBuckets = std::array<std::vector<const USSEMatcher<V> *>, 1 << USSE_BUCKET_BITS>;
+
+template <typename V, size_t N>
+static USSEBuckets<V> make_buckets(const std::array<USSEMatcher<V>, N> &table) {
+    USSEBuckets<V> buckets;
+    for (size_t bucket = 0; bucket < buckets.size(); bucket++) {
+        const uint64_t bits = static_cast<uint64_t>(bucket) << USSE_BUCKET_SHIFT;
+        for (const auto &matcher : table) {
+            if ((((bits ^ matcher.GetExpected()) & matcher.GetMask()) >> USSE_BUCKET_SHIFT) == 0)
+                buckets[bucket].push_back(&matcher);
+        }
+    }
+
+    return buckets;
+}
+
 template <typename V>
-static std::optional<const USSEMatcher<V>> DecodeUSSE(uint64_t instruction) {
+static const std::array<USSEMatcher<V>, 35> &get_usse_matchers() {
     static const std::array<USSEMatcher<V>, 35> table = {
 #define INST(fn, name, bitstring) shader::decoder::detail::detail<USSEMatcher<V>>::GetMatcher(fn, name, bitstring)
         // clang-format off
@@ -860,10 +886,16 @@ static std::optional<const USSEMatcher<V>> DecodeUSSE(uint64_t instruction) {
     };
 #undef INST
 
-    const auto matches_instruction = [instruction](const auto &matcher) { return matcher.Matches(instruction); };
+    return table;
+}
+
+template <typename V>
+static const USSEMatcher<V> *DecodeUSSE(uint64_t instruction) {
+    static const USSEBuckets<V> buckets = make_buckets(get_usse_matchers<V>());
 
-    auto iter = std::find_if(table.begin(), table.end(), matches_instruction);
-    return iter != table.end() ? std::optional<const USSEMatcher<V>>(*iter) : std::nullopt;
+    const auto &bucket = buckets[instruction >> USSE_BUCKET_SHIFT];
+    const auto iter = std::find_if(bucket.begin(), bucket.end(), [instruction](const auto *matcher) { return matcher->Matches(instruction); });
+    return iter != bucket.end() ? *iter : nullptr;
 }
 
 //
@@ -939,8 +971,8 @@ void USSERecompiler::compile_code_node(const usse::USSECodeNode &code) {
         cur_instr = inst[pc];
 
         // Recompile the instruction, to the current block
-        auto decoder = usse::DecodeUSSE<usse::USSETranslatorVisitor>(cur_instr);
-        if (decoder.has_value())
+        const auto *decoder = usse::DecodeUSSE<usse::USSETranslatorVisitor>(cur_instr);
+        if (decoder)
             decoder->call(visitor, cur_instr);
         else
             LOG_DISASM("{:016x}: error: instruction unmatched", cur_instr);
@@ -1070,7 +1102,7 @@ spv::Function *USSERecompiler::compile_program_function() {
 }
 
 void convert_gxp_usse_to_spirv(spv::Builder &b, const SceGxmProgram &program, const FeatureState &features, const SpirvShaderParameters &parameters, utils::SpirvUtilFunctions &utils,
-    spv::Function *begin_hook_func, spv::Function *end_hook_func, const NonDependentTextureQueryCallInfos &queries, const spv::Id render_info_id, spv::Function *spv_func_main, std::vector<spv::Id> &interfaces) {
+    spv::Function *begin_hook_func, spv::Function *end_hook_func, const NonDependentTextureQueryCallInfos &queries, const spv::Id render_info_id, spv::Function *spv_func_main, std::vector<spv::Id> &interfaces, ConversionTimings *timings) {
     const uint64_t *primary_program = program.primary_program_start();
     const uint64_t primary_program_instr_count = program.primary_program_instr_count;
 
@@ -1102,7 +1134,10 @@ void convert_gxp_usse_to_spirv(spv::Builder &b, const SceGxmProgram &program, co
                 recomp.visitor.set_secondary_program(false);
             }
 
+            const auto analysis_start = std::chrono::steady_clock::now();
             recomp.reset(cur_phase_code.first, cur_phase_code.second);
+            if (timings)
+                timings->analysis += std::chrono::steady_clock::now() - analysis_start;
             b.createFunctionCall(recomp.compile_program_function(), {});
         }
     }
@@ -1120,4 +1155,20 @@ void convert_gxp_usse_to_spirv(spv::Builder &b, const SceGxmProgram &program, co
     }
 }
 
+const char *get_usse_instruction_name(uint64_t instruction) {
+    const auto *matcher = DecodeUSSE<USSETranslatorVisitor>(instruction);
+    return matcher ? matcher->GetName() : nullptr;
+}
+
+namespace detail {
+
+std::vector<USSEMatcherEntry> get_usse_matcher_table() {
+    std::vector<USSEMatcherEntry> entries;
+    for (const auto &matcher : get_usse_matchers<USSETranslatorVisitor>())
+        entries.push_back({ matcher.GetName(), matcher.GetMask(), matcher.GetExpected() });
+    return entries;
+}
+
+} // namespace detail
+
 } // namespace shader::usse
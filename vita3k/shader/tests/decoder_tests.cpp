@@ -0,0 +1,122 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#include <gxm/types.h>
+#include <shader/usse_matcher_table.h>
+#include <shader/usse_translator_entry.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+using shader::usse::get_usse_instruction_name;
+using shader::usse::detail::USSEMatcherEntry;
+
+// first matcher of the whole table, what the opcode buckets must find
+static const char *find_linear(const std::vector<USSEMatcherEntry> &table, uint64_t instruction) {
+    const auto iter = std::find_if(table.begin(), table.end(), [instruction](const USSEMatcherEntry &entry) { return (instruction & entry.mask) == entry.expected; });
+    return iter != table.end() ? iter->name : nullptr;
+}
+
+static bool same_name(const char *a, const char *b) {
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+// time both lookups on the instructions and check that they decode them the same way
+static void decode_all(const std::vector<uint64_t> &instructions) {
+    using clock = std::chrono::steady_clock;
+    const std::vector<USSEMatcherEntry> table = shader::usse::detail::get_usse_matcher_table();
+    size_t unmatched = 0;
+
+    auto start = clock::now();
+    for (const uint64_t instruction : instructions)
+        unmatched += find_linear(table, instruction) == nullptr;
+    const double linear_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    start = clock::now();
+    for (const uint64_t instruction : instructions)
+        unmatched += get_usse_instruction_name(instruction) == nullptr;
+    const double bucket_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+    for (const uint64_t instruction : instructions) {
+        const char *expected = find_linear(table, instruction);
+        const char *name = get_usse_instruction_name(instruction);
+        ASSERT_TRUE(same_name(expected, name)) << std::hex << instruction << ": " << (expected ? expected : "unmatched") << " instead of " << (name ? name : "unmatched");
+    }
+
+    std::cout << instructions.size() << " instructions (" << unmatched / 2 << " unmatched): linear search "
+              << instructions.size() / linear_ms << " per ms, opcode buckets " << instructions.size() / bucket_ms << " per ms" << std::endl;
+}
+
+TEST(usse_decoder, random_instructions) {
+    std::mt19937_64 rng(0x5553534500000000);
+    std::vector<uint64_t> instructions(1 << 20);
+    for (uint64_t &instruction : instructions)
+        instruction = rng();
+
+    decode_all(instructions);
+}
+
+// Decodes all the programs of a shaderlog folder, dumped with the GXP or FULL shader log mode.
+// The folder is given by the VITA3K_SHADERLOG_PATH environment variable.
+TEST(usse_decoder, shaderlog_corpus) {
+    const char *shaderlog_path = std::getenv("VITA3K_SHADERLOG_PATH");
+    if (!shaderlog_path)
+        GTEST_SKIP() << "VITA3K_SHADERLOG_PATH is not set";
+
+    std::vector<uint64_t> instructions;
+    size_t nb_programs = 0;
+    for (const auto &entry : fs::recursive_directory_iterator(shaderlog_path)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".gxp")
+            continue;
+
+        std::ifstream file(entry.path(), std::ios::binary);
+        std::vector<char> data(entry.file_size());
+        file.read(data.data(), data.size());
+        if (data.size() < sizeof(SceGxmProgram) || memcmp(data.data(), "GXP", 4) != 0)
+            continue;
+
+        const SceGxmProgram &program = *reinterpret_cast<const SceGxmProgram *>(data.data());
+        const uint64_t *primary_program = program.primary_program_start();
+        const uint64_t *secondary_program_start = program.secondary_program_start();
+        const uint64_t *secondary_program_end = program.secondary_program_end();
+        const uint64_t *data_end = reinterpret_cast<const uint64_t *>(data.data() + data.size());
+        if (primary_program + program.primary_program_instr_count > data_end || secondary_program_end > data_end)
+            continue;
+
+        instructions.insert(instructions.end(), primary_program, primary_program + program.primary_program_instr_count);
+        if (secondary_program_start < secondary_program_end)
+            instructions.insert(instructions.end(), secondary_program_start, secondary_program_end);
+        nb_programs++;
+    }
+
+    if (instructions.empty())
+        GTEST_SKIP() << "no program found in " << shaderlog_path;
+
+    std::cout << nb_programs << " programs" << std::endl;
+    decode_all(instructions);
+}
@@ -0,0 +1,331 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+/*
+Offline translation of the GXP programs dumped in a shaderlog folder
+- every program is translated for each of the selected targets, the programs being spread on all the cores
+- the time spent in each phase of the translation is reported for every program and summed for each target
+- the translated programs can be written to the shader archive of a title so the emulator does not have to generate them,
+  as long as they do not depend on the state of the draws using them
+*/
+
+#include <gxm/types.h>
+#include <renderer/file_writer.h>
+#include <renderer/shader_archive.h>
+#include <shader/spirv_recompiler.h>
+#include <threads/thread_pool.h>
+#include <util/fs.h>
+#include <util/hash.h>
+#include <util/log.h>
+
+#include <CLI11.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using shader::Target;
+
+struct Program {
+    fs::path path;
+    std::vector<uint8_t> data;
+    Sha256Hash hash;
+
+    const SceGxmProgram &get() const {
+        return *reinterpret_cast<const SceGxmProgram *>(data.data());
+    }
+};
+
+struct TranslationResult {
+    shader::ConversionTimings timings;
+    std::chrono::nanoseconds total{};
+    size_t output_size = 0;
+    // the output changes with the hints, it can't be cached
+    bool depends_on_hints = false;
+};
+
+struct TargetInfo {
+    Target target;
+    const char *name;
+    // prefix of the shader names in the archive, the same as the one used by the renderer for this target
+    std::string shader_version;
+    // suffix of the file the renderer checks the features of the shader cache with
+    const char *backend;
+};
+
+static const TargetInfo TARGETS[] = {
+    { Target::GLSLOpenGL, "glsl", fmt::format("v{}", shader::CURRENT_VERSION), "gl" },
+    { Target::SpirVOpenGL, "spirv-gl", fmt::format("v{}spv", shader::CURRENT_VERSION), "gl" },
+    { Target::SpirVVulkan, "spirv-vk", fmt::format("vk{}", shader::CURRENT_VERSION), "vk" },
+};
+
+// The features the renderer of the target uses on a GPU supporting gpu_features
+static FeatureState get_backend_features(Target target, const FeatureState &gpu_features) {
+    FeatureState features{};
+    if (target == Target::SpirVVulkan) {
+        // framebuffer fetch is emulated with subpass inputs when shader interlock is not used
+        features.support_shader_interlock = gpu_features.support_shader_interlock;
+        features.direct_fragcolor = !gpu_features.support_shader_interlock;
+        features.support_memory_mapping = gpu_features.support_memory_mapping;
+        features.use_texture_viewport = gpu_features.use_texture_viewport;
+        features.support_rgb_attributes = gpu_features.support_rgb_attributes;
+    } else {
+        features.support_shader_interlock = gpu_features.support_shader_interlock;
+        features.support_texture_barrier = gpu_features.support_texture_barrier;
+        features.direct_fragcolor = gpu_features.direct_fragcolor;
+        features.support_unknown_format = gpu_features.support_unknown_format;
+        // always enabled in the opengl renderer
+        features.use_mask_bit = true;
+    }
+
+    return features;
+}
+
+static uint32_t get_backend_features_mask(Target target, const FeatureState &features) {
+    return (target == Target::SpirVVulkan) ? renderer::get_vk_features_mask(features) : renderer::get_gl_features_mask(features);
+}
+
+// The renderer drops the shader cache when the version or the features saved in its hashs file do not match its own,
+// the archive can only be added to if the emulator already ran the title with the same features
+static bool check_cache_features(const fs::path &cache_path, const TargetInfo &info, const FeatureState &features) {
+    // same layout as the one written by renderer::save_shaders_cache_hashs
+    struct {
+        size_t size;
+        uint32_t version;
+        uint32_t features_mask;
+    } header;
+    const fs::path hashs_path = cache_path / fmt::format("hashs-{}.dat", info.backend);
+    fs::ifstream hashs_file(hashs_path, std::ios::in | std::ios::binary);
+    if (!hashs_file.is_open() || !hashs_file.read(reinterpret_cast<char *>(&header.size), sizeof(header.size))
+        || !hashs_file.read(reinterpret_cast<char *>(&header.version), sizeof(header.version))
+        || !hashs_file.read(reinterpret_cast<char *>(&header.features_mask), sizeof(header.features_mask))) {
+        fmt::print("{} not found, run the title once with the shader cache enabled first\n", hashs_path);
+        return false;
+    }
+
+    if (header.version != shader::CURRENT_VERSION) {
+        fmt::print("The shader cache of {} is outdated, run the title once to recreate it\n", hashs_path);
+        return false;
+    }
+
+    if (header.features_mask != get_backend_features_mask(info.target, features)) {
+        fmt::print("The features given for {} do not match the ones of the shader cache {}\n", info.name, hashs_path);
+        return false;
+    }
+
+    return true;
+}
+
+// Hints the opposite of the default ones, a program whose output is the same with both does not use the hints
+static shader::Hints make_contrasting_hints(const SceGxmProgram &program, std::vector<SceGxmVertexAttribute> &attributes) {
+    // rgb attributes, on every register
+    for (uint16_t reg = 0; reg < program.primary_reg_count; reg++)
+        attributes.push_back({ 0, 0, SCE_GXM_ATTRIBUTE_FORMAT_F32, 3, reg });
+
+    shader::Hints hints{
+        .attributes = &attributes,
+        .color_format = SCE_GXM_COLOR_FORMAT_F32F32_RG,
+    };
+    std::fill_n(hints.vertex_textures, SCE_GXM_MAX_TEXTURE_UNITS, SCE_GXM_TEXTURE_FORMAT_F32_R);
+    std::fill_n(hints.fragment_textures, SCE_GXM_MAX_TEXTURE_UNITS, SCE_GXM_TEXTURE_FORMAT_F32_R);
+    return hints;
+}
+
+static double to_ms(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+static double to_us(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::micro>(time).count();
+}
+
+// the same program can be dumped several times, once for each renderer, only keep one of them
+static std::vector<Program> load_programs(const fs::path &folder) {
+    std::vector<Program> programs;
+    std::set<Sha256Hash> hashes;
+    for (const auto &entry : fs::recursive_directory_iterator(folder)) {
+        if (!fs::is_regular_file(entry.path()) || entry.path().extension() != ".gxp")
+            continue;
+
+        Program program{ entry.path() };
+        if (!fs_utils::read_data(program.path, program.data))
+            continue;
+
+        if (program.data.size() < sizeof(SceGxmProgram) || memcmp(program.data.data(), "GXP", 4) != 0
+            || program.get().size > program.data.size()) {
+            LOG_WARN("{} is not a valid GXP program, skipping it", program.path);
+            continue;
+        }
+
+        program.hash = sha256(program.data.data(), program.get().size);
+        if (hashes.insert(program.hash).second)
+            programs.push_back(std::move(program));
+    }
+
+    return programs;
+}
+
+int main(int argc, char **argv) {
+    CLI::App app{ "Vita3K GXP batch translator" };
+
+    std::string input_path;
+    app.add_option("input", input_path, "Folder with the dumped .gxp programs, searched recursively")->required()->check(CLI::ExistingDirectory);
+
+    std::vector<std::string> target_names = { "glsl", "spirv-gl", "spirv-vk" };
+    app.add_option("-t,--target", target_names, "Targets to translate the programs to")->check(CLI::IsMember({ "glsl", "spirv-gl", "spirv-vk" }));
+
+    size_t nb_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    app.add_option("-j,--jobs", nb_threads, "Number of threads translating the programs")->check(CLI::PositiveNumber);
+
+    std::string report_path;
+    app.add_option("-r,--report", report_path, "Write the timing of every program to this CSV file");
+
+    std::string cache_path;
+    app.add_option("-c,--cache", cache_path, "Shader cache folder of the title (cache/shaders/<title id>/<self name>) to add the translated programs to.\n"
+                                             "The emulator must have run the title once with the same features, only the programs which do not depend on the draw state are added.")
+        ->check(CLI::ExistingDirectory);
+
+    FeatureState gpu_features{};
+    app.add_flag("--shader-interlock", gpu_features.support_shader_interlock, "Shader interlock is used (Vulkan: only with high accuracy)");
+    app.add_flag("--texture-barrier", gpu_features.support_texture_barrier, "The GPU supports texture barriers (OpenGL)");
+    app.add_flag("--direct-fragcolor", gpu_features.direct_fragcolor, "The GPU supports framebuffer fetch (OpenGL)");
+    app.add_flag("--unknown-format", gpu_features.support_unknown_format, "The GPU supports storage images without format (OpenGL)");
+    app.add_flag("--memory-mapping", gpu_features.support_memory_mapping, "Memory mapping is enabled (Vulkan)");
+    app.add_flag("--texture-viewport", gpu_features.use_texture_viewport, "Texture viewports are used in the shaders (Vulkan: only without high accuracy)");
+    app.add_flag("!--no-rgb-attributes", gpu_features.support_rgb_attributes, "The GPU does not support rgb vertex attributes (Vulkan)");
+
+    CLI11_PARSE(app, argc, argv);
+
+    // the translation logs are not useful here and would slow down the threads
+    logging::set_level(spdlog::level::warn);
+
+    const std::vector<Program> programs = load_programs(fs_utils::utf8_to_path(input_path));
+    if (programs.empty()) {
+        fmt::print("No GXP program found in {}\n", input_path);
+        return 1;
+    }
+
+    std::unique_ptr<fs::ofstream> report;
+    if (!report_path.empty()) {
+        report = std::make_unique<fs::ofstream>(fs_utils::utf8_to_path(report_path));
+        if (!report->is_open()) {
+            fmt::print("Could not open {}\n", report_path);
+            return 1;
+        }
+        *report << "program,type,target,instructions,analysis_us,translation_us,glsl_us,total_us,output_bytes\n";
+    }
+
+    const bool write_cache = !cache_path.empty();
+    renderer::FileWriter file_writer;
+    renderer::ShaderArchive shader_archive(file_writer);
+    if (write_cache) {
+        for (const TargetInfo &info : TARGETS) {
+            if (std::find(target_names.begin(), target_names.end(), info.name) != target_names.end()
+                && !check_cache_features(fs_utils::utf8_to_path(cache_path), info, get_backend_features(info.target, gpu_features)))
+                return 1;
+        }
+        shader_archive.open(fs_utils::utf8_to_path(cache_path) / "shaders.pack");
+    }
+
+    // no hint is available offline, use the same defaults as when recompiling a single shader
+    const std::vector<SceGxmVertexAttribute> no_attributes;
+    shader::Hints hints{
+        .attributes = &no_attributes,
+        .color_format = SCE_GXM_COLOR_FORMAT_U8U8U8U8_ABGR,
+    };
+    std::fill_n(hints.vertex_textures, SCE_GXM_MAX_TEXTURE_UNITS, SCE_GXM_TEXTURE_FORMAT_U8U8U8U8_ABGR);
+    std::fill_n(hints.fragment_textures, SCE_GXM_MAX_TEXTURE_UNITS, SCE_GXM_TEXTURE_FORMAT_U8U8U8U8_ABGR);
+
+    // the calling thread runs tasks too
+    ThreadPool pool(nb_threads - 1);
+    fmt::print("Translating {} programs on {} threads\n", programs.size(), pool.size() + 1);
+
+    for (const TargetInfo &info : TARGETS) {
+        if (std::find(target_names.begin(), target_names.end(), info.name) == target_names.end())
+            continue;
+
+        const FeatureState features = get_backend_features(info.target, gpu_features);
+        std::vector<TranslationResult> results(programs.size());
+        const auto start = std::chrono::steady_clock::now();
+        pool.parallel_for(programs.size(), [&](size_t i) {
+            const Program &program = programs[i];
+            const SceGxmProgram &gxp = program.get();
+            TranslationResult &result = results[i];
+
+            const auto program_start = std::chrono::steady_clock::now();
+            const shader::GeneratedShader shader = shader::convert_gxp(gxp, hex_string(program.hash), features, info.target, hints, false, false, nullptr, &result.timings);
+            result.total = std::chrono::steady_clock::now() - program_start;
+            result.output_size = (info.target == Target::GLSLOpenGL) ? shader.glsl.size() : shader.spirv.size() * sizeof(uint32_t);
+            if (!write_cache)
+                return;
+
+            // the renderer caches the program generated with the hints of its first draw, it must not depend on them
+            std::vector<SceGxmVertexAttribute> attributes;
+            const shader::GeneratedShader contrasting_shader = shader::convert_gxp(gxp, hex_string(program.hash), features, info.target, make_contrasting_hints(gxp, attributes), false, false);
+            result.depends_on_hints = (shader.glsl != contrasting_shader.glsl) || (shader.spirv != contrasting_shader.spirv);
+            if (result.depends_on_hints)
+                return;
+
+            if (info.target == Target::GLSLOpenGL)
+                shader_archive.write(renderer::get_shader_cache_name(info.shader_version, program.hash, gxp.is_fragment() ? "frag" : "vert"), shader.glsl.c_str(), shader.glsl.size());
+            else
+                shader_archive.write(renderer::get_shader_cache_name(info.shader_version, program.hash, "spv"), shader.spirv.data(), result.output_size);
+        });
+        const auto wall_time = std::chrono::steady_clock::now() - start;
+
+        shader::ConversionTimings total_timings{};
+        std::chrono::nanoseconds total_time{};
+        size_t nb_not_cached = 0;
+        for (size_t i = 0; i < programs.size(); i++) {
+            const TranslationResult &result = results[i];
+            nb_not_cached += result.depends_on_hints;
+            total_timings.analysis += result.timings.analysis;
+            total_timings.translation += result.timings.translation;
+            total_timings.glsl += result.timings.glsl;
+            total_time += result.total;
+
+            if (report) {
+                const SceGxmProgram &gxp = programs[i].get();
+                *report << fmt::format("{},{},{},{},{:.1f},{:.1f},{:.1f},{:.1f},{}\n", programs[i].path.filename().string(), gxp.is_fragment() ? "frag" : "vert", info.name,
+                    gxp.primary_program_instr_count, to_us(result.timings.analysis), to_us(result.timings.translation), to_us(result.timings.glsl), to_us(result.total), result.output_size);
+            }
+        }
+
+        fmt::print("{}: {:.1f} ms, {:.1f} programs per second\n", info.name, to_ms(wall_time), programs.size() * 1000.0 / to_ms(wall_time));
+        fmt::print("    summed over the threads: analysis {:.1f} ms, translation {:.1f} ms, SPIR-V to GLSL {:.1f} ms, total {:.1f} ms\n",
+            to_ms(total_timings.analysis), to_ms(total_timings.translation), to_ms(total_timings.glsl), to_ms(total_time));
+        if (write_cache)
+            fmt::print("    {} programs added to the cache, {} depend on the draw state and are left to the emulator\n", programs.size() - nb_not_cached, nb_not_cached);
+
+        std::vector<size_t> slowest(programs.size());
+        for (size_t i = 0; i < slowest.size(); i++)
+            slowest[i] = i;
+        const size_t nb_slowest = std::min<size_t>(5, slowest.size());
+        std::partial_sort(slowest.begin(), slowest.begin() + nb_slowest, slowest.end(), [&](size_t a, size_t b) { return results[a].total > results[b].total; });
+        for (size_t i = 0; i < nb_slowest; i++)
+            fmt::print("    {:.1f} ms {}\n", to_ms(results[slowest[i]].total), programs[slowest[i]].path.filename().string());
+    }
+
+    // wait for the archive to be written
+    shader_archive.close();
+
+    return 0;
+}
@@ -21,8 +21,8 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
-#include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 
 template <typename T>
@@ -31,30 +31,27 @@ public:
     // default value: unlimited
     unsigned int maxPendingCount_ = -1;
 
-    std::unique_ptr<T> top(const int ms = 0) {
-        T item{ T() };
-        {
-            std::unique_lock<std::mutex> mlock(mutex_);
-            if (ms == 0) {
-                while (!aborted && queue_.empty()) {
-                    condempty_.wait(mlock);
-                }
-            } else {
-                if (queue_.empty()) {
-                    condempty_.wait_for(mlock, std::chrono::microseconds(ms));
-                }
+    // Items are returned by value in an optional, so that popping does not need a heap allocation
+    std::optional<T> top(const int ms = 0) {
+        std::unique_lock<std::mutex> mlock(mutex_);
+        if (ms == 0) {
+            while (!aborted && queue_.empty()) {
+                condempty_.wait(mlock);
             }
-            if (aborted || queue_.empty()) {
-                return {};
+        } else {
+            if (queue_.empty()) {
+                condempty_.wait_for(mlock, std::chrono::microseconds(ms));
             }
-
-            item = queue_.front();
         }
-        return std::make_unique<T>(item);
+        if (aborted || queue_.empty()) {
+            return std::nullopt;
+        }
+
+        return queue_.front();
     }
 
-    std::unique_ptr<T> pop(const int ms = 0) {
-        T item{ T() };
+    std::optional<T> pop(const int ms = 0) {
+        std::optional<T> item;
         {
             std::unique_lock<std::mutex> mlock(mutex_);
             if (ms == 0) {
@@ -67,17 +64,26 @@ public:
                 }
             }
             if (aborted || queue_.empty()) {
-                return {};
+                return std::nullopt;
             }
 
-            item = queue_.front();
+            item.emplace(std::move(queue_.front()));
             queue_.pop();
         }
         cond_.notify_all();
-        return std::make_unique<T>(item);
+        return item;
     }
 
     void push(const T &item) {
+        emplace(item);
+    }
+
+    void push(T &&item) {
+        emplace(std::move(item));
+    }
+
+    template <typename... Args>
+    void emplace(Args &&...args) {
         {
             std::unique_lock<std::mutex> mlock(mutex_);
             while (!aborted && queue_.size() == maxPendingCount_) {
@@ -86,7 +92,7 @@ public:
             if (aborted) {
                 return;
             }
-            queue_.push(item);
+            queue_.emplace(std::forward<Args>(args)...);
         }
         condempty_.notify_one();
     }
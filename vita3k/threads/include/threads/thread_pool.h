@@ -0,0 +1,157 @@
+// Vita3K emulator project
+// Copyright (C) 2025 Vita3K team
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads used to split a job in parallel tasks, the thread waiting for the job also runs some of them.
+class ThreadPool {
+public:
+    // by default, use all the cores, the calling thread being one of them
+    explicit ThreadPool(size_t nb_workers = std::max(std::thread::hardware_concurrency(), 2U) - 1) {
+        for (size_t i = 0; i < nb_workers; i++)
+            workers.emplace_back(&ThreadPool::worker_loop, this);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            exit = true;
+        }
+        job_ready.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const {
+        return workers.size();
+    }
+
+    // Call task(i) for each i in [0, count) and return once all the calls are done.
+    // Jobs from different threads are run one after the other, this must not be called from a task.
+    void parallel_for(size_t count, const std::function<void(size_t)> &task) {
+        parallel_for(count, task, nullptr);
+    }
+
+    // Same as above, and while the calling thread waits for the workers, it calls on_wake each time a task calls wake_caller.
+    // This lets the tasks hand some work over to the calling thread, for things that can only be done from it.
+    void parallel_for(size_t count, const std::function<void(size_t)> &task, const std::function<void()> &on_wake) {
+        if (count <= 1 || workers.empty()) {
+            for (size_t i = 0; i < count; i++)
+                task(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> job_guard(job_mutex);
+        Job job{ &task, count };
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            current_job = &job;
+            job_id++;
+            caller_woken = false;
+        }
+        job_ready.notify_all();
+
+        run(job);
+
+        // every task has been picked, wait for the workers still running one
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            job_done.wait(lock, [&]() { return nb_active_workers == 0 || caller_woken; });
+            if (!caller_woken)
+                break;
+
+            caller_woken = false;
+            lock.unlock();
+            if (on_wake)
+                on_wake();
+            lock.lock();
+        }
+        current_job = nullptr;
+    }
+
+    // Called from a task to make the thread waiting in parallel_for run its on_wake function
+    void wake_caller() {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            caller_woken = true;
+        }
+        job_done.notify_all();
+    }
+
+private:
+    struct Job {
+        const std::function<void(size_t)> *task;
+        size_t count;
+        std::atomic<size_t> next_index = 0;
+    };
+
+    static void run(Job &job) {
+        for (size_t i = job.next_index++; i < job.count; i = job.next_index++)
+            (*job.task)(i);
+    }
+
+    void worker_loop() {
+        uint64_t last_job_id = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            job_ready.wait(lock, [&]() { return exit || (current_job && job_id != last_job_id); });
+            if (exit)
+                return;
+
+            last_job_id = job_id;
+            Job &job = *current_job;
+            nb_active_workers++;
+            lock.unlock();
+
+            run(job);
+
+            lock.lock();
+            if (--nb_active_workers == 0)
+                job_done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    // only one job can be run at a time
+    std::mutex job_mutex;
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::condition_variable job_done;
+    Job *current_job = nullptr;
+    uint64_t job_id = 0;
+    size_t nb_active_workers = 0;
+    bool caller_woken = false;
+    bool exit = false;
+};
+
+// Pool shared by the occasional jobs that do not need workers of their own, like loading modules
+inline ThreadPool &get_shared_thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}